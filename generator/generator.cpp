@@ -0,0 +1,140 @@
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the \"Software\"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Generates ianamap_generated.hpp, the IANA -> windows time zone table the library ships, from windowsZones.xml and,
+// optionally, Mapping.csv.gz (of which only the IANA names absent from windowsZones.xml are added).
+//
+//     generator <windowsZones.xml> <ianamap_generated.hpp> [Mapping.csv.gz]
+
+#include <cstdio>
+#include <cstdlib>
+
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <set>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include "gzip_reader.hpp"
+#include "ianamap.hpp"
+#include "windowszones.hpp"
+
+namespace {
+
+using triplet_t = std::tuple<std::string, std::string, std::string>; // IANA name, windows name, territory code.
+
+[[nodiscard]] std::string read_file ( char const * const path_ ) {
+    std::ifstream inf ( path_, std::ios::binary );
+    if ( not inf )
+        return { };
+    return { std::istreambuf_iterator<char> ( inf ), std::istreambuf_iterator<char> ( ) };
+}
+
+// The mapZone elements of windowsZones.xml, and the version of the tz data they map.
+[[nodiscard]] std::vector<triplet_t> read_windowszones ( std::string_view const xml_, std::string & version_ ) {
+    std::vector<triplet_t> triplets;
+    if ( std::size_t const i = xml_.find ( "<mapTimezones" ); std::string_view::npos != i )
+        version_ = xml_attribute ( xml_.substr ( i, xml_.find ( '>', i ) - i ), "typeVersion" );
+    scan_map_zones ( xml_, [ &triplets ] ( map_zone_t const & zone_ ) {
+        for_each_iana_name ( zone_.type, [ &triplets, &zone_ ] ( std::string_view const iana_ ) {
+            triplets.emplace_back ( iana_, zone_.other, zone_.territory );
+        } );
+    } );
+    return triplets;
+}
+
+// The lines of Mapping.csv.gz, "windows name,territory code,IANA names".
+[[nodiscard]] std::vector<triplet_t> read_mapping ( char const * const path_ ) {
+    std::vector<triplet_t> triplets;
+    for_each_gzip_line ( path_, [ &triplets ] ( std::string_view const line_ ) {
+        std::string_view fields[ 3 ];
+        if ( 3u == split_fields ( line_, ',', fields ) )
+            for_each_iana_name ( fields[ 2 ], [ &triplets, &fields ] ( std::string_view const iana_ ) {
+                triplets.emplace_back ( iana_, fields[ 0 ], fields[ 1 ] );
+            } );
+    } );
+    return triplets;
+}
+
+[[nodiscard]] std::string generate ( IanaMap const & map_, std::string_view const version_ ) {
+    std::ostringstream os;
+    os << "// Generated by generator/generator.cpp from windowsZones.xml";
+    if ( version_.size ( ) )
+        os << " (tz " << version_ << ")";
+    os << ", do not edit.\n\n#pragma once\n\n#include <cstdint>\n\n#include \"ianamap.hpp\"\n\n";
+    os << "// The storage of g_iana, " << map_.size ( ) << " entries ordered by IANA name.\n\n";
+    os << "inline constexpr char g_iana_arena[ ] =\n";
+    for ( IanaMapEntry const & e : map_.entries ( ) )
+        os << "    \"" << map_.arena ( ).substr ( e.key, e.key_size ) << "\" \"" << map_.arena ( ).substr ( e.name, e.name_size )
+           << "\" \"" << map_.arena ( ).substr ( e.code, e.code_size ) << "\"\n";
+    os << "    \"\";\n\n";
+    os << "inline constexpr IanaMapEntry g_iana_entries[ " << map_.size ( ) << " ] = {\n";
+    for ( IanaMapEntry const & e : map_.entries ( ) )
+        os << "    { " << e.key << "u, " << e.name << "u, " << e.code << "u, " << +e.key_size << "u, " << +e.name_size << "u, "
+           << +e.code_size << "u },\n";
+    os << "};\n\n";
+    auto const table = [ &os ] ( char const * const type_, char const * const name_, auto const & values_ ) {
+        os << "inline constexpr " << type_ << ' ' << name_ << "[ " << values_.size ( ) << " ] = {";
+        for ( std::size_t i = 0u; i < values_.size ( ); ++i )
+            os << ( i % 16u ? " " : "\n    " ) << values_[ i ] << "u,";
+        os << "\n};\n\n";
+    };
+    table ( "std::uint32_t", "g_iana_displacements", map_.displacements ( ) );
+    table ( "std::uint16_t", "g_iana_slots", map_.slots ( ) );
+    std::string s = os.str ( );
+    s.pop_back ( );
+    return s;
+}
+
+} // namespace
+
+int main ( int argc, char * argv[] ) {
+    if ( argc < 3 ) {
+        std::cerr << "usage: generator <windowsZones.xml> <ianamap_generated.hpp> [Mapping.csv.gz]\n";
+        return EXIT_FAILURE;
+    }
+    std::string const xml = read_file ( argv[ 1 ] );
+    std::string version;
+    std::vector<triplet_t> const windowszones = read_windowszones ( xml, version );
+    if ( windowszones.empty ( ) ) {
+        std::cerr << "generator: no mapZone elements in " << argv[ 1 ] << '\n';
+        return EXIT_FAILURE;
+    }
+    IanaMapBuilder builder;
+    std::set<std::string, std::less<>> keys;
+    for ( auto const & [ iana, name, code ] : windowszones ) {
+        builder.insert ( iana, name, code );
+        keys.insert ( iana );
+    }
+    if ( argc > 3 )
+        for ( auto const & [ iana, name, code ] : read_mapping ( argv[ 3 ] ) )
+            if ( std::end ( keys ) == keys.find ( iana ) )
+                builder.insert ( iana, name, code, duplicate_code_t::keep_territory );
+    IanaMap const map = builder.build ( );
+    std::ofstream ( argv[ 2 ], std::ios::binary ) << generate ( map, version );
+    std::cout << "generator: " << map.size ( ) << " IANA names, " << map.displacements ( ).size ( ) << " displacements\n";
+    return EXIT_SUCCESS;
+}
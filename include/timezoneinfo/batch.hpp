@@ -0,0 +1,85 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the \"Software\"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "zone.hpp"
+#include "zoned_time.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <limits>
+#include <span>
+
+// Bulk conversions of whole columns of UTC instants to local time in zone_. The kernels (AVX2, SSE4.2 or scalar, chosen
+// at runtime) track the period of constant offset of the previous element, such that (mostly) ordered input costs a
+// range check and an add per element, other input falls back to a lookup per element. The out_ spans must be at least
+// as large as the in_ spans, in_ and out_ may be the same memory.
+
+void to_local ( zone_t const & zone_, std::span<nixtime_t const> in_, std::span<nixtime_t> out_ ) noexcept;
+void to_local ( zone_t const & zone_, std::span<wintime_t const> in_, std::span<wintime_t> out_ ) noexcept;
+
+// Bulk conversions of columns of local times in zone_ to UTC, under policy_. The kinds_ span, if not empty, receives the
+// kind of each local time, such that the ambiguous and nonexistent ones can be found. The elements policy_ rejects are
+// written as the below, out of the range of either type. Returns the number of ambiguous and nonexistent local times,
+// nothing throws.
+inline constexpr nixtime_t rejected_nixtime     = std::numeric_limits<nixtime_t>::min ( );
+inline constexpr std::uint64_t rejected_wintime = std::uint64_t{ 1 } << 63; // As wintime_t::as_uint64 ( ).
+std::size_t local_to_utc ( zone_t const & zone_, std::span<nixtime_t const> in_, std::span<nixtime_t> out_,
+                           std::span<local_kind_t> kinds_ = { }, local_policy_t const policy_ = { } ) noexcept;
+std::size_t local_to_utc ( zone_t const & zone_, std::span<wintime_t const> in_, std::span<wintime_t> out_,
+                           std::span<local_kind_t> kinds_ = { }, local_policy_t const policy_ = { } ) noexcept;
+
+// Stamps a column of UTC instants [ 1900, 2356 ] with their offset in zone_ (rounded to the quarter hour, only the local
+// mean time of some zones, before 1980, is not a multiple of it), tracking the period as above.
+void to_zoned ( zone_t const & zone_, std::span<wintime_t const> in_, std::span<zoned_time_t> out_ ) noexcept;
+// The UTC, respectively local, instants of a column of zoned times, a shift and an add per element, vectorized.
+void to_utc ( std::span<zoned_time_t const> in_, std::span<wintime_t> out_ ) noexcept;
+void to_local ( std::span<zoned_time_t const> in_, std::span<wintime_t> out_ ) noexcept;
+
+// Decomposed local time.
+void to_local ( zone_t const & zone_, std::span<nixtime_t const> in_, std::span<systime_t> out_ ) noexcept;
+void to_local ( zone_t const & zone_, std::span<wintime_t const> in_, std::span<systime_t> out_ ) noexcept;
+
+// Column-wise (struct of arrays) date parts, only the non-empty spans are written, each must be at least as large as the
+// input. Queries that need, f.e., only the month and the day of the week request just those.
+struct date_parts_t {
+    std::span<std::int16_t> year;
+    std::span<std::int8_t> month, day, hour, minute, second;
+    std::span<std::int8_t> day_of_week; // 0 == Sunday.
+};
+
+// Decompose a column of nixtime_t [ UTC ] into its date parts, the civil date arithmetic of wintime_to_systime applied
+// in blocks by a vectorized kernel. The years [ -32768, 32767 ] (the range of date_parts_t::year) are decomposed exactly,
+// proleptic Gregorian, instants outside them give unspecified parts.
+void decompose ( std::span<nixtime_t const> in_, date_parts_t const & out_ ) noexcept;
+// Decompose a column of nixtime_t [ UTC ] into its date parts in local time in zone_.
+void decompose ( zone_t const & zone_, std::span<nixtime_t const> in_, date_parts_t const & out_ ) noexcept;
+
+enum class simd_level_t { scalar, sse42, avx2 };
+
+// The instruction set of the kernels selected on this machine.
+[[nodiscard]] simd_level_t simd_level ( ) noexcept;
+// Selects the kernels of level_, at most the detected level, which it returns, f.e. to check the kernels against each other.
+simd_level_t set_simd_level ( simd_level_t const level_ ) noexcept;
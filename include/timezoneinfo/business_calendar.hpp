@@ -0,0 +1,98 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the \"Software\"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstdint>
+
+#include <algorithm>
+#include <span>
+#include <vector>
+
+#include "calendar.hpp"
+
+// The business days of the years [ first_year_, last_year_ ], those that are not on the weekend, nor a holiday, one bit a
+// day, a 366 (384) bit mask per year, with the number of business days before each of its words and before the year. A
+// count is then a lookup and a popcount, a step of n business days a count and a select (a few popcounts), whatever the
+// span. Days are the days since 1970-01-01 (days_from_civil ( ), civil_from_days ( ) convert), immutable once built.
+class business_calendar_t {
+
+    public:
+    // The weekend days, a bit a day of the week, 1 << 0 == Sunday.
+    using weekend_t = std::uint8_t;
+
+    static constexpr weekend_t saturday_sunday = ( 1u << 0 ) | ( 1u << 6 );
+    static constexpr weekend_t friday_saturday = ( 1u << 5 ) | ( 1u << 6 );
+
+    // Holidays outside the years are ignored, as are those that are not dates (f.e. February 29 of a common year), on the
+    // weekend they change nothing.
+    business_calendar_t ( int const first_year_, int const last_year_, weekend_t const weekend_ = saturday_sunday,
+                          std::span<civil_t const> holidays_ = { } );
+
+    [[nodiscard]] bool is_business_day ( std::int64_t const day_ ) const noexcept;
+
+    // The number of business days in [ from_, to_ ), negative if to_ is before from_.
+    [[nodiscard]] std::int64_t business_days_between ( std::int64_t const from_, std::int64_t const to_ ) const noexcept {
+        return count ( to_ ) - count ( from_ );
+    }
+    // The n_-th business day after day_, before it if n_ is negative, day_ if 0. Clamped to the years.
+    [[nodiscard]] std::int64_t add_business_days ( std::int64_t const day_, std::int64_t const n_ ) const noexcept;
+    // The first business day after, respectively before, day_.
+    [[nodiscard]] std::int64_t next_business_day ( std::int64_t const day_ ) const noexcept {
+        return add_business_days ( day_, 1 );
+    }
+    [[nodiscard]] std::int64_t previous_business_day ( std::int64_t const day_ ) const noexcept {
+        return add_business_days ( day_, -1 );
+    }
+
+    // The days covered, [ first_day ( ), end_day ( ) ).
+    [[nodiscard]] std::int64_t first_day ( ) const noexcept { return m_first_day; }
+    [[nodiscard]] std::int64_t end_day ( ) const noexcept { return m_end_day; }
+
+    private:
+    struct year_t {
+        std::uint64_t bits[ 6 ];        // Bit i of word w: day 64 * w + i of the year is a business day.
+        std::uint16_t word_before[ 6 ]; // The business days of the year before word w.
+        std::int64_t before;            // The business days of the calendar before the year.
+        std::int64_t first_day;
+    };
+
+    // The number of business days in [ first_day ( ), day_ ), clamped.
+    [[nodiscard]] std::int64_t count ( std::int64_t const day_ ) const noexcept;
+    // The business day k_ [ 0, m_total ) of the calendar.
+    [[nodiscard]] std::int64_t select ( std::int64_t const k_ ) const noexcept;
+
+    // The year of day_ [ first_day ( ), end_day ( ) ), from a guess by the mean length of a year (146'097 days per 400
+    // years), at most a year off, whatever the span.
+    [[nodiscard]] year_t const & year ( std::int64_t const day_ ) const noexcept {
+        std::size_t y = std::min ( static_cast<std::size_t> ( ( day_ - m_first_day ) * 400 / 146'097 ), m_years.size ( ) - 1u );
+        while ( y and m_years[ y ].first_day > day_ )
+            --y;
+        while ( y + 1u < m_years.size ( ) and m_years[ y + 1u ].first_day <= day_ )
+            ++y;
+        return m_years[ y ];
+    }
+
+    std::vector<year_t> m_years;
+    std::int64_t m_first_day, m_end_day, m_total;
+};
@@ -43,18 +43,39 @@
 #    define _CRT_SECURE_NO_WARNINGS
 #endif
 
-#include <Windows.h>
-
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <ctime>
 
 #include <string>
 
+#if _WIN32
+#    include <Windows.h>
+#else
+// The Windows structures used, with identical layout, such that the (calendar) arithmetic builds everywhere.
+struct SYSTEMTIME {
+    std::uint16_t wYear, wMonth, wDayOfWeek, wDay, wHour, wMinute, wSecond, wMilliseconds;
+};
+struct FILETIME {
+    std::uint32_t dwLowDateTime, dwHighDateTime;
+};
+struct TIME_ZONE_INFORMATION {
+    std::int32_t Bias;
+    wchar_t StandardName[ 32 ];
+    SYSTEMTIME StandardDate;
+    std::int32_t StandardBias;
+    wchar_t DaylightName[ 32 ];
+    SYSTEMTIME DaylightDate;
+    std::int32_t DaylightBias;
+};
+#endif
+
 using nixtime_t = std::time_t; // Signed 64-bit value on Windows x64.
 
 using systime_t = SYSTEMTIME;
 using filtime_t = FILETIME;
+using tzi_t     = TIME_ZONE_INFORMATION;
 
 struct alignas ( 8 ) wintime_t {
 
@@ -64,13 +85,17 @@ struct alignas ( 8 ) wintime_t {
     inline std::uint64_t & as_uint64 ( ) noexcept { return *reinterpret_cast<std::uint64_t *> ( this ); }
     inline std::uint64_t const & as_uint64 ( ) const noexcept { return *reinterpret_cast<std::uint64_t const *> ( this ); }
 
-    void set_utc ( ) noexcept { *reinterpret_cast<char *> ( this ) = 0; }
+    // These keep the offset in the low byte of the ticks, which overwrites 25.6 us of them and breaks the order, a
+    // zoned_time_t (zoned_time.hpp) keeps both.
+    [[deprecated ( "use zoned_time_t" )]] void set_utc ( ) noexcept { *reinterpret_cast<char *> ( this ) = 0; }
 
-    void set_offset ( int const minutes_ ) noexcept {
+    [[deprecated ( "use zoned_time_t" )]] void set_offset ( int const minutes_ ) noexcept {
         assert ( not( minutes_ % 15 ) );
         *reinterpret_cast<char *> ( this ) = static_cast<char> ( minutes_ / 15 );
     }
-    int get_offset ( ) const noexcept { return static_cast<int> ( *reinterpret_cast<char const *> ( this ) ) * 15; }
+    [[deprecated ( "use zoned_time_t" )]] int get_offset ( ) const noexcept {
+        return static_cast<int> ( *reinterpret_cast<char const *> ( this ) ) * 15;
+    }
 
     private:
     filtime_t value{ };
@@ -93,6 +118,43 @@ struct alignas ( 8 ) wintime_t {
 [[nodiscard]] std::tm systime_to_tm ( systime_t const & systime_ ) noexcept;
 [[nodiscard]] systime_t tm_to_systime ( std::tm const & tm_ ) noexcept;
 
+// Pure integer epoch <-> civil (proleptic Gregorian) date arithmetic [ after H. Hinnant, chrono-Compatible Low-Level Date
+// Algorithms ], valid for all dates since 0000-03-01, which covers the full SYSTEMTIME range [ 1601, 30827 ].
+
+struct civil_t {
+    int year, month, day;
+};
+
+inline constexpr std::int64_t ticks_per_day            = 864'000'000'000LL; // 100 ns ticks.
+inline constexpr std::int64_t days_from_winepoch_to_nix = 134'774;            // 1601-01-01 -> 1970-01-01.
+
+// Returns the number of days since 1970-01-01 of the date y_-m_-d_.
+[[nodiscard]] constexpr std::int64_t days_from_civil ( int y_, int const m_, int const d_ ) noexcept {
+    y_ -= m_ <= 2;
+    std::int64_t const era = y_ / 400;
+    std::int64_t const yoe = y_ - era * 400;                                         // [ 0, 399 ]
+    std::int64_t const doy = ( 153 * ( m_ > 2 ? m_ - 3 : m_ + 9 ) + 2 ) / 5 + d_ - 1; // [ 0, 365 ]
+    std::int64_t const doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;                   // [ 0, 146096 ]
+    return era * 146'097 + doe - 719'468;
+}
+
+// Returns the date of the day days_ since 1970-01-01.
+[[nodiscard]] constexpr civil_t civil_from_days ( std::int64_t days_ ) noexcept {
+    days_ += 719'468;
+    std::int64_t const era = days_ / 146'097;
+    std::int64_t const doe = days_ - era * 146'097;                                         // [ 0, 146096 ]
+    std::int64_t const yoe = ( doe - doe / 1'460 + doe / 36'524 - doe / 146'096 ) / 365; // [ 0, 399 ]
+    std::int64_t const doy = doe - ( 365 * yoe + yoe / 4 - yoe / 100 );                  // [ 0, 365 ]
+    std::int64_t const mp  = ( 5 * doy + 2 ) / 153;                                       // [ 0, 11 ]
+    int const m            = static_cast<int> ( mp < 10 ? mp + 3 : mp - 9 );
+    return { static_cast<int> ( yoe + era * 400 ) + ( m <= 2 ), m, static_cast<int> ( doy - ( 153 * mp + 2 ) / 5 + 1 ) };
+}
+
+// Returns the day of the week of the day days_ since 1601-01-01 (a Monday), 0 == Sunday.
+[[nodiscard]] constexpr int weekday_from_windays ( std::int64_t const days_ ) noexcept {
+    return static_cast<int> ( ( days_ + 1 ) % 7 );
+}
+
 inline constexpr char const * dow[ 7 ]             = { "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat" };
 inline constexpr char const * day_of_the_week[ 7 ] = {
     "Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saterday"
@@ -142,3 +204,25 @@ inline constexpr char const * month_of_the_year[ 12 ] = { "January", "February",
 // 53 29 30 31
 
 [[nodiscard]] std::string calendar ( int const y_, int const m_ ) noexcept;
+
+// A month as the grid calendar ( ) prints, weeks [ 4, 6 ] rows of 7 days, Sunday first, 0 == no day, and the week number
+// of each row. A value type, computed arithmetically.
+struct month_t {
+    std::int16_t year  = 0;
+    std::int8_t month  = 0; // [ 1, 12 ].
+    std::int8_t weeks  = 0;
+    std::int8_t week_num[ 6 ]{ };
+    std::int8_t days[ 6 ][ 7 ]{ };
+};
+
+[[nodiscard]] month_t make_month ( int const y_, int const m_ ) noexcept;
+// As make_month, from a process wide memo of whole years, each computed on first use. The calendar repeats every 400
+// years, 400 years cover all.
+[[nodiscard]] month_t cached_month ( int const y_, int const m_ ) noexcept;
+
+// The most chars render_month writes: the title, up to 5 + 9 + 1 + 6 (-32768) chars, the header of 26, 6 rows of 25.
+inline constexpr std::size_t max_month_text = 200u;
+
+// Writes m_ as calendar ( ) formats it to out_, which must hold max_month_text chars, returns the end of the output (which
+// is not null-terminated).
+char * render_month ( char * out_, month_t const & m_ ) noexcept;
@@ -0,0 +1,83 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the \"Software\"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "calendar.hpp"
+#include "zone.hpp"
+#include "zone_cache.hpp"
+
+#include <cstdint>
+
+#include <atomic>
+#include <optional>
+
+// The local calendar day in a zone at some instant, together with the UTC interval over which that day and the offset
+// hold: from the later of local midnight and the last transition to the earlier of the next local midnight and the next
+// transition. Inside the interval the local time of day is a subtraction away.
+struct local_day_t {
+    std::int64_t begin      = 0, end = 0; // UTC ticks, [ begin, end ).
+    std::int64_t offset     = 0;          // Ticks, local time = UTC + offset.
+    std::int64_t midnight   = 0;          // Local ticks at the start of the day.
+    std::int16_t year       = 0;
+    std::int8_t month       = 0;
+    std::int8_t day         = 0;
+    std::int8_t day_of_week = 0; // 0 == Sunday.
+
+    [[nodiscard]] bool contains ( std::int64_t const utc_ ) const noexcept { return utc_ >= begin and utc_ < end; }
+    [[nodiscard]] bool is_weekend ( ) const noexcept { return 0 == day_of_week or 6 == day_of_week; }
+
+    // Returns the local time of UTC instant utc_, which must be contained in the interval.
+    [[nodiscard]] systime_t local_systime ( std::int64_t const utc_ ) const noexcept;
+};
+
+// Returns the local day in zone_ at UTC instant utc_.
+[[nodiscard]] local_day_t make_local_day ( zone_t const & zone_, std::int64_t const utc_ ) noexcept;
+
+// A local_day_t shared between threads through a seqlock: readers never block nor write, a single writer publishes a new
+// day, concurrent writers leave it to the one that got there first. The day is tagged with the zone it was computed in,
+// a zone recompiled under the same id (as the zone data is published) is a different zone, its day is computed anew.
+class alignas ( 64 ) local_day_slot_t { // A cache line each, no false sharing between zones.
+
+    public:
+    // Returns the day if it is published, computed in zone_ and holds at UTC instant utc_, nothing while it is being
+    // written or stale.
+    [[nodiscard]] std::optional<local_day_t> load ( zone_t const & zone_, std::int64_t const utc_ ) const noexcept;
+    // Publishes day_ of zone_, unless another thread is publishing.
+    void store ( zone_t const & zone_, local_day_t const & day_ ) noexcept;
+
+    private:
+    std::atomic<std::uint32_t> m_sequence{ }; // Odd while being written.
+    std::atomic<zone_t const *> m_zone{ };    // The cached zones are never freed, an address is not reused.
+    std::atomic<std::int64_t> m_begin{ }, m_end{ }, m_offset{ }, m_midnight{ };
+    std::atomic<std::uint64_t> m_date{ }; // Year, month, day and day of the week, packed.
+};
+
+// Returns the current UTC instant [ in 100 ns ticks since 1601 ].
+[[nodiscard]] inline std::int64_t now_ticks ( ) noexcept { return static_cast<std::int64_t> ( wintime ( ).as_uint64 ( ) ); }
+
+// Returns the local day of zone_, respectively of UTC, at (current) UTC instant now_. A day is computed once per zone and
+// published in a slot per zone_id_t, readers only compare now_ against the interval of the cached day, which is refreshed
+// on the first read after the next local midnight or transition.
+[[nodiscard]] local_day_t today_in_zone ( zone_id_t const id_, zone_t const & zone_, std::int64_t const now_ = now_ticks ( ) ) noexcept;
+[[nodiscard]] local_day_t today_utc ( std::int64_t const now_ = now_ticks ( ) ) noexcept;
@@ -0,0 +1,75 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the \"Software\"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstdint>
+
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <span>
+#include <stop_token>
+#include <string>
+#include <string_view>
+
+namespace fs = std::filesystem;
+
+// What the server said about a file last time [ RFC 9110, 8.8 ], sent along with the next request of it, which is then
+// answered with 304 Not Modified if the file did not change.
+struct download_validators_t {
+    std::string etag;                 // Empty if none.
+    std::uint64_t last_modified = 0u; // A nixtime, 0 if unknown.
+};
+
+enum class download_status_t : std::uint8_t { changed, not_modified, failed };
+
+// A file to fetch: url to path, unless it did not change since validators. The body is passed to sink as it arrives and
+// is written to a file next to path, that is renamed over path once complete and verified, path is never left half
+// written, nor replaced by a body that is not what it should be.
+struct fetch_request_t {
+    std::string url;
+    fs::path path;
+    download_validators_t validators; // On changed, those of the new file.
+    std::function<void ( std::string_view )> sink;
+    // Called before a retry, the sink starts over.
+    std::function<void ( )> restart;
+    // Called as the body is complete, before it replaces the file there was, false rejects it: the request has failed (it
+    // is not retried), the file there was stays. None accepts any body.
+    std::function<bool ( )> verify;
+    // Called as the request is done, the others may not be.
+    std::function<void ( fetch_request_t const & )> done;
+    std::chrono::milliseconds timeout{ 60'000 }; // Of an attempt, 0 is none.
+    std::chrono::milliseconds backoff{ 1'000 };  // Before the first retry, doubling with each next one.
+    int retries = 3;                             // Of failed attempts, not of those the server refused (4xx).
+
+    // The outcome.
+    download_status_t status = download_status_t::failed;
+    long response_code       = 0; // Of the last attempt, 0 if none, or not http.
+    int attempts             = 0;
+    std::string error; // Of the last attempt, empty if none.
+};
+
+// Fetches requests_ at once, on connections shared between them (and their retries), retrying those that fail. Returns
+// when all are done, or stop_ is requested (the ongoing requests have then failed).
+void fetch ( std::span<fetch_request_t> requests_, std::stop_token const & stop_ = { } );
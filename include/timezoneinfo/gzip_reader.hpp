@@ -0,0 +1,163 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the \"Software\"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "mapped_file.hpp"
+
+namespace fs = std::filesystem;
+
+struct z_stream_s;
+
+// Inflates a (memory mapped) gzip file, of one or more members, in large blocks.
+class gzip_reader_t {
+
+    public:
+    static constexpr std::size_t block_size = 64u * 1'024u;
+
+    explicit gzip_reader_t ( fs::path const & path_ );
+    ~gzip_reader_t ( ) noexcept;
+
+    gzip_reader_t ( gzip_reader_t const & ) = delete;
+    gzip_reader_t & operator= ( gzip_reader_t const & ) = delete;
+
+    // Returns the next inflated block, valid up to the next call, empty at the end of the file or on error.
+    [[nodiscard]] std::string_view read ( );
+
+    // False if the file could not be mapped, or is not valid gzip.
+    [[nodiscard]] bool ok ( ) const noexcept { return m_ok; }
+
+    private:
+    mapped_file_t m_file;
+    std::unique_ptr<z_stream_s> m_stream;
+    std::unique_ptr<char[]> m_block;
+    bool m_ok = false, m_end = true;
+};
+
+// Inflates gzip data, of one or more members, as it arrives (f.e. from the network), in pieces of any size.
+class gzip_inflater_t {
+
+    public:
+    static constexpr std::size_t block_size = gzip_reader_t::block_size;
+
+    gzip_inflater_t ( );
+    ~gzip_inflater_t ( ) noexcept;
+
+    gzip_inflater_t ( gzip_inflater_t const & ) = delete;
+    gzip_inflater_t & operator= ( gzip_inflater_t const & ) = delete;
+
+    // Calls f_ ( block ) for each block inflated from piece_, the blocks are valid for the duration of the call. Returns
+    // false once the data is not valid gzip.
+    template<typename Function>
+    bool feed ( std::string_view const piece_, Function && f_ ) {
+        input ( piece_ );
+        for ( std::string_view block = inflate_block ( ); block.size ( ); block = inflate_block ( ) )
+            f_ ( block );
+        return m_ok;
+    }
+
+    // True if the data fed so far is valid and ends with a complete member.
+    [[nodiscard]] bool ok ( ) const noexcept { return m_ok and m_complete; }
+
+    private:
+    void input ( std::string_view const piece_ ) noexcept;
+    // Returns the next inflated block, empty once the input is used up.
+    [[nodiscard]] std::string_view inflate_block ( ) noexcept;
+
+    std::unique_ptr<z_stream_s> m_stream;
+    std::unique_ptr<char[]> m_block;
+    bool m_ok = false, m_complete = false, m_more = false;
+};
+
+// Splits a stream of blocks into lines, terminated by \n or \r\n. A line spanning blocks is carried over, whatever its
+// length. The lines passed to f_ are views, valid for the duration of the call.
+class line_splitter_t {
+
+    public:
+    template<typename Function>
+    void feed ( std::string_view block_, Function && f_ ) {
+        if ( m_carry.size ( ) ) {
+            std::size_t const e = block_.find ( '\n' );
+            if ( std::string_view::npos == e ) {
+                m_carry.append ( block_ );
+                return;
+            }
+            m_carry.append ( block_.substr ( 0u, e ) );
+            f_ ( trim ( m_carry ) );
+            m_carry.clear ( );
+            block_.remove_prefix ( e + 1u );
+        }
+        for ( std::size_t e = block_.find ( '\n' ); std::string_view::npos != e; e = block_.find ( '\n' ) ) {
+            f_ ( trim ( block_.substr ( 0u, e ) ) );
+            block_.remove_prefix ( e + 1u );
+        }
+        m_carry.append ( block_ );
+    }
+
+    // The last line, if not terminated.
+    template<typename Function>
+    void finish ( Function && f_ ) {
+        if ( m_carry.size ( ) )
+            f_ ( trim ( m_carry ) );
+        m_carry.clear ( );
+    }
+
+    private:
+    [[nodiscard]] static std::string_view trim ( std::string_view const line_ ) noexcept {
+        return line_.size ( ) and '\r' == line_.back ( ) ? line_.substr ( 0u, line_.size ( ) - 1u ) : line_;
+    }
+
+    std::string m_carry;
+};
+
+// Calls f_ ( line ) for each line of the gzip file path_, returns false if it could not be read (completely).
+template<typename Function>
+bool for_each_gzip_line ( fs::path const & path_, Function && f_ ) {
+    gzip_reader_t reader ( path_ );
+    line_splitter_t lines;
+    for ( std::string_view block = reader.read ( ); block.size ( ); block = reader.read ( ) )
+        lines.feed ( block, f_ );
+    lines.finish ( f_ );
+    return reader.ok ( );
+}
+
+// Splits line_ on sep_ into fields_, the last field takes the remainder of the line. Returns the number of fields.
+inline std::size_t split_fields ( std::string_view line_, char const sep_, std::span<std::string_view> const fields_ ) noexcept {
+    std::size_t n = 0u;
+    for ( ; n < fields_.size ( ); ++n ) {
+        std::size_t const e = n + 1u == fields_.size ( ) ? std::string_view::npos : line_.find ( sep_ );
+        fields_[ n ] = line_.substr ( 0u, e );
+        if ( std::string_view::npos == e )
+            return n + 1u;
+        line_.remove_prefix ( e + 1u );
+    }
+    return n;
+}
@@ -40,25 +40,256 @@
 #    pragma comment( lib, "libcurlpp.lib" )
 #endif
 
+#include <cstdint>
+
 #include <filesystem>
-#include <map>
+#include <functional>
+#include <iterator>
 #include <sax/stl.hpp>
 #include <set>
+#include <span>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "gzip_reader.hpp"
+#include "perfect_hash.hpp"
 
 namespace fs = std::filesystem;
 
-using IanaMapKey = std::string;
+using IanaMapKey = std::string_view;
 
 struct IanaMapValue {
-    std::string name, code;
+    std::string_view name, code;
+};
+
+// An entry of the IanaMap, the strings are stored in the arena.
+struct IanaMapEntry {
+    std::uint32_t key, name, code; // Offsets into the arena.
+    std::uint8_t key_size, name_size, code_size;
 };
 
-using IanaMap  = std::map<IanaMapKey, IanaMapValue>;
-using WinTzSet = std::set<std::string>;
+// A flat, immutable, map of IANA time zone names to windows time zone names and territory codes. The entries live in one
+// array ordered by key, like the std::map it replaces, the strings in one arena. Lookup, with any string_view, is a
+// perfect hash to a slot, which holds the index of the entry. An IanaMap either owns its storage, or is a view of static
+// storage.
+class IanaMap {
+
+    public:
+    using key_type    = IanaMapKey;
+    using mapped_type = IanaMapValue;
+    using value_type  = std::pair<IanaMapKey, IanaMapValue>;
+    using size_type   = std::size_t;
+
+    class const_iterator {
+
+        friend class IanaMap;
+
+        IanaMap const * m_map = nullptr;
+        std::size_t m_index   = 0u;
+
+        const_iterator ( IanaMap const * map_, std::size_t const index_ ) noexcept : m_map{ map_ }, m_index{ index_ } {}
+
+        public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = IanaMap::value_type;
+        using difference_type   = std::ptrdiff_t;
+        using reference         = value_type;
+
+        struct pointer {
+            value_type value;
+            value_type const * operator-> ( ) const noexcept { return &value; }
+        };
+
+        const_iterator ( ) noexcept = default;
+
+        [[nodiscard]] reference operator* ( ) const noexcept { return m_map->value ( m_index ); }
+        [[nodiscard]] pointer operator-> ( ) const noexcept { return { **this }; }
+        [[nodiscard]] reference operator[] ( difference_type const i_ ) const noexcept { return *( *this + i_ ); }
+
+        const_iterator & operator++ ( ) noexcept {
+            ++m_index;
+            return *this;
+        }
+        const_iterator operator++ ( int ) noexcept {
+            const_iterator tmp = *this;
+            ++m_index;
+            return tmp;
+        }
+        const_iterator & operator-- ( ) noexcept {
+            --m_index;
+            return *this;
+        }
+        const_iterator operator-- ( int ) noexcept {
+            const_iterator tmp = *this;
+            --m_index;
+            return tmp;
+        }
+        const_iterator & operator+= ( difference_type const i_ ) noexcept {
+            m_index += i_;
+            return *this;
+        }
+        const_iterator & operator-= ( difference_type const i_ ) noexcept {
+            m_index -= i_;
+            return *this;
+        }
+        [[nodiscard]] friend const_iterator operator+ ( const_iterator it_, difference_type const i_ ) noexcept { return it_ += i_; }
+        [[nodiscard]] friend const_iterator operator+ ( difference_type const i_, const_iterator it_ ) noexcept { return it_ += i_; }
+        [[nodiscard]] friend const_iterator operator- ( const_iterator it_, difference_type const i_ ) noexcept { return it_ -= i_; }
+        [[nodiscard]] friend difference_type operator- ( const_iterator const & a_, const_iterator const & b_ ) noexcept {
+            return static_cast<difference_type> ( a_.m_index ) - static_cast<difference_type> ( b_.m_index );
+        }
+        [[nodiscard]] friend bool operator== ( const_iterator const & a_, const_iterator const & b_ ) noexcept {
+            return a_.m_index == b_.m_index;
+        }
+        [[nodiscard]] friend auto operator<=> ( const_iterator const & a_, const_iterator const & b_ ) noexcept {
+            return a_.m_index <=> b_.m_index;
+        }
+    };
+
+    using iterator = const_iterator;
+
+    IanaMap ( ) noexcept = default;
+    // A view of static storage, the arena, the entries, the perfect hash displacements and the slots (entry indices).
+    constexpr IanaMap ( std::string_view const arena_, std::span<IanaMapEntry const> const entries_,
+                        std::span<std::uint32_t const> const displacements_, std::span<std::uint16_t const> const slots_ ) noexcept :
+        m_arena{ arena_ },
+        m_entries{ entries_ }, m_displacements{ displacements_ }, m_slots{ slots_ } {}
+
+    IanaMap ( IanaMap const & other_ );
+    IanaMap ( IanaMap && other_ ) noexcept;
+
+    IanaMap & operator= ( IanaMap const & other_ );
+    IanaMap & operator= ( IanaMap && other_ ) noexcept;
+
+    [[nodiscard]] const_iterator begin ( ) const noexcept { return { this, 0u }; }
+    [[nodiscard]] const_iterator end ( ) const noexcept { return { this, m_entries.size ( ) }; }
+    [[nodiscard]] const_iterator cbegin ( ) const noexcept { return begin ( ); }
+    [[nodiscard]] const_iterator cend ( ) const noexcept { return end ( ); }
+
+    [[nodiscard]] size_type size ( ) const noexcept { return m_entries.size ( ); }
+    [[nodiscard]] bool empty ( ) const noexcept { return m_entries.empty ( ); }
+
+    // Returns the index of the entry of key_, or size ( ) if absent.
+    [[nodiscard]] std::size_t index ( std::string_view const key_ ) const noexcept {
+        if ( m_entries.empty ( ) )
+            return 0u;
+        std::size_t const i = m_slots[ perfect_hash_slot ( key_, m_displacements, m_slots.size ( ) ) ];
+        IanaMapEntry const & e = m_entries[ i ];
+        return string ( e.key, e.key_size ) == key_ ? i : m_entries.size ( );
+    }
+
+    [[nodiscard]] const_iterator find ( std::string_view const key_ ) const noexcept { return { this, index ( key_ ) }; }
+    [[nodiscard]] bool contains ( std::string_view const key_ ) const noexcept { return index ( key_ ) != m_entries.size ( ); }
+    // Throws std::out_of_range, like std::map::at ( ).
+    [[nodiscard]] IanaMapValue at ( std::string_view const key_ ) const;
+
+    [[nodiscard]] std::string_view arena ( ) const noexcept { return m_arena; }
+    [[nodiscard]] std::span<IanaMapEntry const> entries ( ) const noexcept { return m_entries; }
+    [[nodiscard]] std::span<std::uint32_t const> displacements ( ) const noexcept { return m_displacements; }
+    [[nodiscard]] std::span<std::uint16_t const> slots ( ) const noexcept { return m_slots; }
+
+    private:
+    friend class IanaMapBuilder;
+
+    [[nodiscard]] std::string_view string ( std::uint32_t const offset_, std::uint8_t const size_ ) const noexcept {
+        return { m_arena.data ( ) + offset_, size_ };
+    }
+    [[nodiscard]] value_type value ( std::size_t const index_ ) const noexcept {
+        IanaMapEntry const & e = m_entries[ index_ ];
+        return { string ( e.key, e.key_size ), { string ( e.name, e.name_size ), string ( e.code, e.code_size ) } };
+    }
+
+    void assign ( IanaMap const & other_ );
+    void assign ( IanaMap && other_ ) noexcept;
+    void bind ( IanaMap const & other_ ) noexcept;
+
+    // Owned storage, empty if this is a view.
+    std::string m_arena_storage;
+    std::vector<IanaMapEntry> m_entries_storage;
+    std::vector<std::uint32_t> m_displacements_storage;
+    std::vector<std::uint16_t> m_slots_storage;
+
+    std::string_view m_arena;
+    std::span<IanaMapEntry const> m_entries;
+    std::span<std::uint32_t const> m_displacements;
+    std::span<std::uint16_t const> m_slots;
+};
+
+// How a repeated insert of a key changes its code, as the sources define it. windowsZones.xml codes a key mapped in more
+// than one territory "001" (world); Mapping.csv does so too, except that its "001" rows leave the territory code as is.
+enum class duplicate_code_t : std::uint8_t { world, keep_territory };
+
+// Collects the (IANA name, windows name, territory code) triplets, without allocating per insert, and builds the IanaMap.
+class IanaMapBuilder {
+
+    public:
+    static constexpr std::size_t max_field_size = 255u;
+
+    // A key inserted more than once keeps the first name, its code changes on each later insert as duplicate_ says. An
+    // entry with a field longer than max_field_size is skipped (the input is downloaded, no real name comes close).
+    void insert ( std::string_view const key_, std::string_view const name_, std::string_view const code_,
+                  duplicate_code_t const duplicate_ = duplicate_code_t::world );
+
+    [[nodiscard]] IanaMap build ( );
+
+    private:
+    struct entry_t {
+        IanaMapEntry entry;
+        duplicate_code_t duplicate;
+    };
+
+    [[nodiscard]] std::uint32_t append ( std::string_view const s_ );
+
+    std::string m_arena;
+    std::vector<entry_t> m_entries;
+};
+
+using WinTzSet = std::set<std::string, std::less<>>;
 
 void download_windowszones ( );
 void download_windowszones_alt ( );
 
+// Parses windowsZones.xml, memory mapped and in a single pass, keeping the windows time zones in db_.
+[[nodiscard]] IanaMap parse_windowszones ( fs::path const & path_, WinTzSet const & db_ );
+// Parses windowsZones.xml into a tinyxml2 DOM, keeping the windows time zones in db_ (the former parser, for comparison).
+[[nodiscard]] IanaMap parse_windowszones_tinyxml2 ( fs::path const & path_, WinTzSet const & db_ );
+
+// Parses Mapping.csv.gz, inflated in blocks, keeping the windows time zones in db_.
+[[nodiscard]] IanaMap parse_windowszones_alt ( fs::path const & path_, WinTzSet const & db_ );
+
+// Incremental parsers of the above, fed the file as it arrives (f.e. from the network) in pieces of any size, such that
+// the map is built as the download progresses, without reading the file back.
+class windowszones_parser_t {
+
+    public:
+    explicit windowszones_parser_t ( WinTzSet db_ ) noexcept : m_db{ std::move ( db_ ) } {}
+
+    void feed ( std::string_view const piece_ );
+    [[nodiscard]] IanaMap finish ( );
+
+    private:
+    WinTzSet m_db;
+    std::string m_buffer; // The unscanned tail of the document.
+    IanaMapBuilder m_map;
+};
+
+class windowszones_alt_parser_t {
+
+    public:
+    explicit windowszones_alt_parser_t ( WinTzSet db_ ) noexcept : m_db{ std::move ( db_ ) } {}
+
+    void feed ( std::string_view const piece_ );
+    // Returns the map, empty if the data is not valid (complete) gzip.
+    [[nodiscard]] IanaMap finish ( );
+
+    private:
+    WinTzSet m_db;
+    gzip_inflater_t m_inflater;
+    line_splitter_t m_lines;
+    IanaMapBuilder m_map;
+};
+
 [[nodiscard]] IanaMap build_iana_to_windowszones_map ( );
 [[nodiscard]] IanaMap build_iana_to_windowszones_alt_map ( );
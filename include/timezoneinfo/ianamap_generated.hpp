@@ -0,0 +1,976 @@
+// Generated by generator/generator.cpp from windowsZones.xml (tz 2018i), do not edit.
+
+#pragma once
+
+#include <cstdint>
+
+#include "ianamap.hpp"
+
+// The storage of g_iana, 459 entries ordered by IANA name.
+
+inline constexpr char g_iana_arena[ ] =
+    "Africa/Abidjan" "Greenwich Standard Time" "CI"
+    "Africa/Accra" "Greenwich Standard Time" "GH"
+    "Africa/Addis_Ababa" "E. Africa Standard Time" "ET"
+    "Africa/Algiers" "W. Central Africa Standard Time" "DZ"
+    "Africa/Asmera" "E. Africa Standard Time" "ER"
+    "Africa/Bamako" "Greenwich Standard Time" "ML"
+    "Africa/Bangui" "W. Central Africa Standard Time" "CF"
+    "Africa/Banjul" "Greenwich Standard Time" "GM"
+    "Africa/Bissau" "Greenwich Standard Time" "GW"
+    "Africa/Blantyre" "South Africa Standard Time" "MW"
+    "Africa/Brazzaville" "W. Central Africa Standard Time" "CG"
+    "Africa/Bujumbura" "South Africa Standard Time" "BI"
+    "Africa/Cairo" "Egypt Standard Time" "001"
+    "Africa/Casablanca" "Morocco Standard Time" "001"
+    "Africa/Ceuta" "Romance Standard Time" "ES"
+    "Africa/Conakry" "Greenwich Standard Time" "GN"
+    "Africa/Dakar" "Greenwich Standard Time" "SN"
+    "Africa/Dar_es_Salaam" "E. Africa Standard Time" "TZ"
+    "Africa/Djibouti" "E. Africa Standard Time" "DJ"
+    "Africa/Douala" "W. Central Africa Standard Time" "CM"
+    "Africa/El_Aaiun" "Morocco Standard Time" "EH"
+    "Africa/Freetown" "Greenwich Standard Time" "SL"
+    "Africa/Gaborone" "South Africa Standard Time" "BW"
+    "Africa/Harare" "South Africa Standard Time" "ZW"
+    "Africa/Johannesburg" "South Africa Standard Time" "001"
+    "Africa/Juba" "E. Africa Standard Time" "SS"
+    "Africa/Kampala" "E. Africa Standard Time" "UG"
+    "Africa/Khartoum" "Sudan Standard Time" "001"
+    "Africa/Kigali" "South Africa Standard Time" "RW"
+    "Africa/Kinshasa" "W. Central Africa Standard Time" "CD"
+    "Africa/Lagos" "W. Central Africa Standard Time" "001"
+    "Africa/Libreville" "W. Central Africa Standard Time" "GA"
+    "Africa/Lome" "Greenwich Standard Time" "TG"
+    "Africa/Luanda" "W. Central Africa Standard Time" "AO"
+    "Africa/Lubumbashi" "South Africa Standard Time" "CD"
+    "Africa/Lusaka" "South Africa Standard Time" "ZM"
+    "Africa/Malabo" "W. Central Africa Standard Time" "GQ"
+    "Africa/Maputo" "South Africa Standard Time" "MZ"
+    "Africa/Maseru" "South Africa Standard Time" "LS"
+    "Africa/Mbabane" "South Africa Standard Time" "SZ"
+    "Africa/Mogadishu" "E. Africa Standard Time" "SO"
+    "Africa/Monrovia" "Greenwich Standard Time" "LR"
+    "Africa/Nairobi" "E. Africa Standard Time" "001"
+    "Africa/Ndjamena" "W. Central Africa Standard Time" "TD"
+    "Africa/Niamey" "W. Central Africa Standard Time" "NE"
+    "Africa/Nouakchott" "Greenwich Standard Time" "MR"
+    "Africa/Ouagadougou" "Greenwich Standard Time" "BF"
+    "Africa/Porto-Novo" "W. Central Africa Standard Time" "BJ"
+    "Africa/Sao_Tome" "Sao Tome Standard Time" "001"
+    "Africa/Tripoli" "Libya Standard Time" "001"
+    "Africa/Tunis" "W. Central Africa Standard Time" "TN"
+    "Africa/Windhoek" "Namibia Standard Time" "001"
+    "America/Adak" "Aleutian Standard Time" "001"
+    "America/Anchorage" "Alaskan Standard Time" "001"
+    "America/Anguilla" "SA Western Standard Time" "AI"
+    "America/Antigua" "SA Western Standard Time" "AG"
+    "America/Araguaina" "Tocantins Standard Time" "001"
+    "America/Argentina/La_Rioja" "Argentina Standard Time" "AR"
+    "America/Argentina/Rio_Gallegos" "Argentina Standard Time" "AR"
+    "America/Argentina/Salta" "Argentina Standard Time" "AR"
+    "America/Argentina/San_Juan" "Argentina Standard Time" "AR"
+    "America/Argentina/San_Luis" "Argentina Standard Time" "AR"
+    "America/Argentina/Tucuman" "Argentina Standard Time" "AR"
+    "America/Argentina/Ushuaia" "Argentina Standard Time" "AR"
+    "America/Aruba" "SA Western Standard Time" "AW"
+    "America/Asuncion" "Paraguay Standard Time" "001"
+    "America/Bahia" "Bahia Standard Time" "001"
+    "America/Bahia_Banderas" "Central Standard Time (Mexico)" "MX"
+    "America/Barbados" "SA Western Standard Time" "BB"
+    "America/Belem" "SA Eastern Standard Time" "BR"
+    "America/Belize" "Central America Standard Time" "BZ"
+    "America/Blanc-Sablon" "SA Western Standard Time" "CA"
+    "America/Boa_Vista" "SA Western Standard Time" "BR"
+    "America/Bogota" "SA Pacific Standard Time" "001"
+    "America/Boise" "Mountain Standard Time" "US"
+    "America/Buenos_Aires" "Argentina Standard Time" "001"
+    "America/Cambridge_Bay" "Mountain Standard Time" "CA"
+    "America/Campo_Grande" "Central Brazilian Standard Time" "BR"
+    "America/Cancun" "Eastern Standard Time (Mexico)" "001"
+    "America/Caracas" "Venezuela Standard Time" "001"
+    "America/Catamarca" "Argentina Standard Time" "AR"
+    "America/Cayenne" "SA Eastern Standard Time" "001"
+    "America/Cayman" "SA Pacific Standard Time" "KY"
+    "America/Chicago" "Central Standard Time" "001"
+    "America/Chihuahua" "Mountain Standard Time (Mexico)" "001"
+    "America/Coral_Harbour" "SA Pacific Standard Time" "CA"
+    "America/Cordoba" "Argentina Standard Time" "AR"
+    "America/Costa_Rica" "Central America Standard Time" "CR"
+    "America/Creston" "US Mountain Standard Time" "CA"
+    "America/Cuiaba" "Central Brazilian Standard Time" "001"
+    "America/Curacao" "SA Western Standard Time" "CW"
+    "America/Danmarkshavn" "UTC" "GL"
+    "America/Dawson" "Pacific Standard Time" "CA"
+    "America/Dawson_Creek" "US Mountain Standard Time" "CA"
+    "America/Denver" "Mountain Standard Time" "001"
+    "America/Detroit" "Eastern Standard Time" "US"
+    "America/Dominica" "SA Western Standard Time" "DM"
+    "America/Edmonton" "Mountain Standard Time" "CA"
+    "America/Eirunepe" "SA Pacific Standard Time" "BR"
+    "America/El_Salvador" "Central America Standard Time" "SV"
+    "America/Fort_Nelson" "US Mountain Standard Time" "CA"
+    "America/Fortaleza" "SA Eastern Standard Time" "BR"
+    "America/Glace_Bay" "Atlantic Standard Time" "CA"
+    "America/Godthab" "Greenland Standard Time" "001"
+    "America/Goose_Bay" "Atlantic Standard Time" "CA"
+    "America/Grand_Turk" "Turks And Caicos Standard Time" "001"
+    "America/Grenada" "SA Western Standard Time" "GD"
+    "America/Guadeloupe" "SA Western Standard Time" "GP"
+    "America/Guatemala" "Central America Standard Time" "001"
+    "America/Guayaquil" "SA Pacific Standard Time" "EC"
+    "America/Guyana" "SA Western Standard Time" "GY"
+    "America/Halifax" "Atlantic Standard Time" "001"
+    "America/Havana" "Cuba Standard Time" "001"
+    "America/Hermosillo" "US Mountain Standard Time" "MX"
+    "America/Indiana/Knox" "Central Standard Time" "US"
+    "America/Indiana/Marengo" "US Eastern Standard Time" "US"
+    "America/Indiana/Petersburg" "Eastern Standard Time" "US"
+    "America/Indiana/Tell_City" "Central Standard Time" "US"
+    "America/Indiana/Vevay" "US Eastern Standard Time" "US"
+    "America/Indiana/Vincennes" "Eastern Standard Time" "US"
+    "America/Indiana/Winamac" "Eastern Standard Time" "US"
+    "America/Indianapolis" "US Eastern Standard Time" "001"
+    "America/Inuvik" "Mountain Standard Time" "CA"
+    "America/Iqaluit" "Eastern Standard Time" "CA"
+    "America/Jamaica" "SA Pacific Standard Time" "JM"
+    "America/Jujuy" "Argentina Standard Time" "AR"
+    "America/Juneau" "Alaskan Standard Time" "US"
+    "America/Kentucky/Monticello" "Eastern Standard Time" "US"
+    "America/Kralendijk" "SA Western Standard Time" "BQ"
+    "America/La_Paz" "SA Western Standard Time" "001"
+    "America/Lima" "SA Pacific Standard Time" "PE"
+    "America/Los_Angeles" "Pacific Standard Time" "001"
+    "America/Louisville" "Eastern Standard Time" "US"
+    "America/Lower_Princes" "SA Western Standard Time" "SX"
+    "America/Maceio" "SA Eastern Standard Time" "BR"
+    "America/Managua" "Central America Standard Time" "NI"
+    "America/Manaus" "SA Western Standard Time" "BR"
+    "America/Marigot" "SA Western Standard Time" "MF"
+    "America/Martinique" "SA Western Standard Time" "MQ"
+    "America/Matamoros" "Central Standard Time" "MX"
+    "America/Mazatlan" "Mountain Standard Time (Mexico)" "MX"
+    "America/Mendoza" "Argentina Standard Time" "AR"
+    "America/Menominee" "Central Standard Time" "US"
+    "America/Merida" "Central Standard Time (Mexico)" "MX"
+    "America/Metlakatla" "Pacific Standard Time" "US"
+    "America/Mexico_City" "Central Standard Time (Mexico)" "001"
+    "America/Miquelon" "Saint Pierre Standard Time" "001"
+    "America/Moncton" "Atlantic Standard Time" "CA"
+    "America/Monterrey" "Central Standard Time (Mexico)" "MX"
+    "America/Montevideo" "Montevideo Standard Time" "001"
+    "America/Montreal" "Eastern Standard Time" "CA"
+    "America/Montserrat" "SA Western Standard Time" "MS"
+    "America/Nassau" "Eastern Standard Time" "BS"
+    "America/New_York" "Eastern Standard Time" "001"
+    "America/Nipigon" "Eastern Standard Time" "CA"
+    "America/Nome" "Alaskan Standard Time" "US"
+    "America/Noronha" "UTC-02" "BR"
+    "America/North_Dakota/Beulah" "Central Standard Time" "US"
+    "America/North_Dakota/Center" "Central Standard Time" "US"
+    "America/North_Dakota/New_Salem" "Central Standard Time" "US"
+    "America/Ojinaga" "Mountain Standard Time" "MX"
+    "America/Panama" "SA Pacific Standard Time" "PA"
+    "America/Pangnirtung" "Eastern Standard Time" "CA"
+    "America/Paramaribo" "SA Eastern Standard Time" "SR"
+    "America/Phoenix" "US Mountain Standard Time" "001"
+    "America/Port-au-Prince" "Haiti Standard Time" "001"
+    "America/Port_of_Spain" "SA Western Standard Time" "TT"
+    "America/Porto_Velho" "SA Western Standard Time" "BR"
+    "America/Puerto_Rico" "SA Western Standard Time" "PR"
+    "America/Punta_Arenas" "Magallanes Standard Time" "001"
+    "America/Rainy_River" "Central Standard Time" "CA"
+    "America/Rankin_Inlet" "Central Standard Time" "CA"
+    "America/Recife" "SA Eastern Standard Time" "BR"
+    "America/Regina" "Canada Central Standard Time" "001"
+    "America/Resolute" "Central Standard Time" "CA"
+    "America/Rio_Branco" "SA Pacific Standard Time" "BR"
+    "America/Santa_Isabel" "Pacific Standard Time (Mexico)" "MX"
+    "America/Santarem" "SA Eastern Standard Time" "BR"
+    "America/Santiago" "Pacific SA Standard Time" "001"
+    "America/Santo_Domingo" "SA Western Standard Time" "DO"
+    "America/Sao_Paulo" "E. South America Standard Time" "001"
+    "America/Scoresbysund" "Azores Standard Time" "GL"
+    "America/Sitka" "Alaskan Standard Time" "US"
+    "America/St_Barthelemy" "SA Western Standard Time" "BL"
+    "America/St_Johns" "Newfoundland Standard Time" "001"
+    "America/St_Kitts" "SA Western Standard Time" "KN"
+    "America/St_Lucia" "SA Western Standard Time" "LC"
+    "America/St_Thomas" "SA Western Standard Time" "VI"
+    "America/St_Vincent" "SA Western Standard Time" "VC"
+    "America/Swift_Current" "Canada Central Standard Time" "CA"
+    "America/Tegucigalpa" "Central America Standard Time" "HN"
+    "America/Thule" "Atlantic Standard Time" "GL"
+    "America/Thunder_Bay" "Eastern Standard Time" "CA"
+    "America/Tijuana" "Pacific Standard Time (Mexico)" "001"
+    "America/Toronto" "Eastern Standard Time" "CA"
+    "America/Tortola" "SA Western Standard Time" "VG"
+    "America/Vancouver" "Pacific Standard Time" "CA"
+    "America/Whitehorse" "Pacific Standard Time" "CA"
+    "America/Winnipeg" "Central Standard Time" "CA"
+    "America/Yakutat" "Alaskan Standard Time" "US"
+    "America/Yellowknife" "Mountain Standard Time" "CA"
+    "Antarctica/Casey" "W. Australia Standard Time" "AQ"
+    "Antarctica/Davis" "SE Asia Standard Time" "AQ"
+    "Antarctica/DumontDUrville" "West Pacific Standard Time" "AQ"
+    "Antarctica/Macquarie" "Central Pacific Standard Time" "AU"
+    "Antarctica/Mawson" "West Asia Standard Time" "AQ"
+    "Antarctica/McMurdo" "New Zealand Standard Time" "AQ"
+    "Antarctica/Palmer" "Magallanes Standard Time" "AQ"
+    "Antarctica/Rothera" "SA Eastern Standard Time" "AQ"
+    "Antarctica/Syowa" "E. Africa Standard Time" "AQ"
+    "Antarctica/Vostok" "Central Asia Standard Time" "AQ"
+    "Arctic/Longyearbyen" "W. Europe Standard Time" "SJ"
+    "Asia/Aden" "Arab Standard Time" "YE"
+    "Asia/Almaty" "Central Asia Standard Time" "001"
+    "Asia/Amman" "Jordan Standard Time" "001"
+    "Asia/Anadyr" "Russia Time Zone 11" "RU"
+    "Asia/Aqtau" "West Asia Standard Time" "KZ"
+    "Asia/Aqtobe" "West Asia Standard Time" "KZ"
+    "Asia/Ashgabat" "West Asia Standard Time" "TM"
+    "Asia/Atyrau" "West Asia Standard Time" "KZ"
+    "Asia/Baghdad" "Arabic Standard Time" "001"
+    "Asia/Bahrain" "Arab Standard Time" "BH"
+    "Asia/Baku" "Azerbaijan Standard Time" "001"
+    "Asia/Bangkok" "SE Asia Standard Time" "001"
+    "Asia/Barnaul" "Altai Standard Time" "001"
+    "Asia/Beirut" "Middle East Standard Time" "001"
+    "Asia/Bishkek" "Central Asia Standard Time" "KG"
+    "Asia/Brunei" "Singapore Standard Time" "BN"
+    "Asia/Calcutta" "India Standard Time" "001"
+    "Asia/Chita" "Transbaikal Standard Time" "001"
+    "Asia/Choibalsan" "Ulaanbaatar Standard Time" "MN"
+    "Asia/Colombo" "Sri Lanka Standard Time" "001"
+    "Asia/Damascus" "Syria Standard Time" "001"
+    "Asia/Dhaka" "Bangladesh Standard Time" "001"
+    "Asia/Dili" "Tokyo Standard Time" "TL"
+    "Asia/Dubai" "Arabian Standard Time" "001"
+    "Asia/Dushanbe" "West Asia Standard Time" "TJ"
+    "Asia/Famagusta" "GTB Standard Time" "CY"
+    "Asia/Gaza" "West Bank Standard Time" "PS"
+    "Asia/Hebron" "West Bank Standard Time" "001"
+    "Asia/Hong_Kong" "China Standard Time" "HK"
+    "Asia/Hovd" "W. Mongolia Standard Time" "001"
+    "Asia/Irkutsk" "North Asia East Standard Time" "001"
+    "Asia/Jakarta" "SE Asia Standard Time" "ID"
+    "Asia/Jayapura" "Tokyo Standard Time" "ID"
+    "Asia/Jerusalem" "Israel Standard Time" "001"
+    "Asia/Kabul" "Afghanistan Standard Time" "001"
+    "Asia/Kamchatka" "Russia Time Zone 11" "001"
+    "Asia/Karachi" "Pakistan Standard Time" "001"
+    "Asia/Katmandu" "Nepal Standard Time" "001"
+    "Asia/Khandyga" "Yakutsk Standard Time" "RU"
+    "Asia/Krasnoyarsk" "North Asia Standard Time" "001"
+    "Asia/Kuala_Lumpur" "Singapore Standard Time" "MY"
+    "Asia/Kuching" "Singapore Standard Time" "MY"
+    "Asia/Kuwait" "Arab Standard Time" "KW"
+    "Asia/Macau" "China Standard Time" "MO"
+    "Asia/Magadan" "Magadan Standard Time" "001"
+    "Asia/Makassar" "Singapore Standard Time" "ID"
+    "Asia/Manila" "Singapore Standard Time" "PH"
+    "Asia/Muscat" "Arabian Standard Time" "OM"
+    "Asia/Nicosia" "GTB Standard Time" "CY"
+    "Asia/Novokuznetsk" "North Asia Standard Time" "RU"
+    "Asia/Novosibirsk" "N. Central Asia Standard Time" "001"
+    "Asia/Omsk" "Omsk Standard Time" "001"
+    "Asia/Oral" "West Asia Standard Time" "KZ"
+    "Asia/Phnom_Penh" "SE Asia Standard Time" "KH"
+    "Asia/Pontianak" "SE Asia Standard Time" "ID"
+    "Asia/Pyongyang" "North Korea Standard Time" "001"
+    "Asia/Qatar" "Arab Standard Time" "QA"
+    "Asia/Qostanay" "Central Asia Standard Time" "KZ"
+    "Asia/Qyzylorda" "West Asia Standard Time" "KZ"
+    "Asia/Rangoon" "Myanmar Standard Time" "001"
+    "Asia/Riyadh" "Arab Standard Time" "001"
+    "Asia/Saigon" "SE Asia Standard Time" "VN"
+    "Asia/Sakhalin" "Sakhalin Standard Time" "001"
+    "Asia/Samarkand" "West Asia Standard Time" "UZ"
+    "Asia/Seoul" "Korea Standard Time" "001"
+    "Asia/Shanghai" "China Standard Time" "001"
+    "Asia/Singapore" "Singapore Standard Time" "001"
+    "Asia/Srednekolymsk" "Russia Time Zone 10" "001"
+    "Asia/Taipei" "Taipei Standard Time" "001"
+    "Asia/Tashkent" "West Asia Standard Time" "001"
+    "Asia/Tbilisi" "Georgian Standard Time" "001"
+    "Asia/Tehran" "Iran Standard Time" "001"
+    "Asia/Thimphu" "Bangladesh Standard Time" "BT"
+    "Asia/Tokyo" "Tokyo Standard Time" "001"
+    "Asia/Tomsk" "Tomsk Standard Time" "001"
+    "Asia/Ulaanbaatar" "Ulaanbaatar Standard Time" "001"
+    "Asia/Urumqi" "Central Asia Standard Time" "CN"
+    "Asia/Ust-Nera" "Vladivostok Standard Time" "RU"
+    "Asia/Vientiane" "SE Asia Standard Time" "LA"
+    "Asia/Vladivostok" "Vladivostok Standard Time" "001"
+    "Asia/Yakutsk" "Yakutsk Standard Time" "001"
+    "Asia/Yekaterinburg" "Ekaterinburg Standard Time" "001"
+    "Asia/Yerevan" "Caucasus Standard Time" "001"
+    "Atlantic/Azores" "Azores Standard Time" "001"
+    "Atlantic/Bermuda" "Atlantic Standard Time" "BM"
+    "Atlantic/Canary" "GMT Standard Time" "ES"
+    "Atlantic/Cape_Verde" "Cape Verde Standard Time" "001"
+    "Atlantic/Faeroe" "GMT Standard Time" "FO"
+    "Atlantic/Madeira" "GMT Standard Time" "PT"
+    "Atlantic/Reykjavik" "Greenwich Standard Time" "001"
+    "Atlantic/South_Georgia" "UTC-02" "GS"
+    "Atlantic/St_Helena" "Greenwich Standard Time" "SH"
+    "Atlantic/Stanley" "SA Eastern Standard Time" "FK"
+    "Australia/Adelaide" "Cen. Australia Standard Time" "001"
+    "Australia/Brisbane" "E. Australia Standard Time" "001"
+    "Australia/Broken_Hill" "Cen. Australia Standard Time" "AU"
+    "Australia/Currie" "Tasmania Standard Time" "AU"
+    "Australia/Darwin" "AUS Central Standard Time" "001"
+    "Australia/Eucla" "Aus Central W. Standard Time" "001"
+    "Australia/Hobart" "Tasmania Standard Time" "001"
+    "Australia/Lindeman" "E. Australia Standard Time" "AU"
+    "Australia/Lord_Howe" "Lord Howe Standard Time" "001"
+    "Australia/Melbourne" "AUS Eastern Standard Time" "AU"
+    "Australia/Perth" "W. Australia Standard Time" "001"
+    "Australia/Sydney" "AUS Eastern Standard Time" "001"
+    "CST6CDT" "Central Standard Time" "ZZ"
+    "EST5EDT" "Eastern Standard Time" "ZZ"
+    "Etc/GMT" "UTC" "001"
+    "Etc/GMT+1" "Cape Verde Standard Time" "ZZ"
+    "Etc/GMT+10" "Hawaiian Standard Time" "ZZ"
+    "Etc/GMT+11" "UTC-11" "001"
+    "Etc/GMT+12" "Dateline Standard Time" "001"
+    "Etc/GMT+2" "UTC-02" "001"
+    "Etc/GMT+3" "SA Eastern Standard Time" "ZZ"
+    "Etc/GMT+4" "SA Western Standard Time" "ZZ"
+    "Etc/GMT+5" "SA Pacific Standard Time" "ZZ"
+    "Etc/GMT+6" "Central America Standard Time" "ZZ"
+    "Etc/GMT+7" "US Mountain Standard Time" "ZZ"
+    "Etc/GMT+8" "UTC-08" "001"
+    "Etc/GMT+9" "UTC-09" "001"
+    "Etc/GMT-1" "W. Central Africa Standard Time" "ZZ"
+    "Etc/GMT-10" "West Pacific Standard Time" "ZZ"
+    "Etc/GMT-11" "Central Pacific Standard Time" "ZZ"
+    "Etc/GMT-12" "UTC+12" "001"
+    "Etc/GMT-13" "UTC+13" "001"
+    "Etc/GMT-14" "Line Islands Standard Time" "ZZ"
+    "Etc/GMT-2" "South Africa Standard Time" "ZZ"
+    "Etc/GMT-3" "E. Africa Standard Time" "ZZ"
+    "Etc/GMT-4" "Arabian Standard Time" "ZZ"
+    "Etc/GMT-5" "West Asia Standard Time" "ZZ"
+    "Etc/GMT-6" "Central Asia Standard Time" "ZZ"
+    "Etc/GMT-7" "SE Asia Standard Time" "ZZ"
+    "Etc/GMT-8" "Singapore Standard Time" "ZZ"
+    "Etc/GMT-9" "Tokyo Standard Time" "ZZ"
+    "Etc/UTC" "UTC" "ZZ"
+    "Europe/Amsterdam" "W. Europe Standard Time" "NL"
+    "Europe/Andorra" "W. Europe Standard Time" "AD"
+    "Europe/Astrakhan" "Astrakhan Standard Time" "001"
+    "Europe/Athens" "GTB Standard Time" "GR"
+    "Europe/Belgrade" "Central Europe Standard Time" "RS"
+    "Europe/Berlin" "W. Europe Standard Time" "001"
+    "Europe/Bratislava" "Central Europe Standard Time" "SK"
+    "Europe/Brussels" "Romance Standard Time" "BE"
+    "Europe/Bucharest" "GTB Standard Time" "001"
+    "Europe/Budapest" "Central Europe Standard Time" "001"
+    "Europe/Busingen" "W. Europe Standard Time" "DE"
+    "Europe/Chisinau" "E. Europe Standard Time" "001"
+    "Europe/Copenhagen" "Romance Standard Time" "DK"
+    "Europe/Dublin" "GMT Standard Time" "IE"
+    "Europe/Gibraltar" "W. Europe Standard Time" "GI"
+    "Europe/Guernsey" "GMT Standard Time" "GG"
+    "Europe/Helsinki" "FLE Standard Time" "FI"
+    "Europe/Isle_of_Man" "GMT Standard Time" "IM"
+    "Europe/Istanbul" "Turkey Standard Time" "001"
+    "Europe/Jersey" "GMT Standard Time" "JE"
+    "Europe/Kaliningrad" "Kaliningrad Standard Time" "001"
+    "Europe/Kiev" "FLE Standard Time" "001"
+    "Europe/Kirov" "Russian Standard Time" "RU"
+    "Europe/Lisbon" "GMT Standard Time" "PT"
+    "Europe/Ljubljana" "Central Europe Standard Time" "SI"
+    "Europe/London" "GMT Standard Time" "001"
+    "Europe/Luxembourg" "W. Europe Standard Time" "LU"
+    "Europe/Madrid" "Romance Standard Time" "ES"
+    "Europe/Malta" "W. Europe Standard Time" "MT"
+    "Europe/Mariehamn" "FLE Standard Time" "AX"
+    "Europe/Minsk" "Belarus Standard Time" "001"
+    "Europe/Monaco" "W. Europe Standard Time" "MC"
+    "Europe/Moscow" "Russian Standard Time" "001"
+    "Europe/Oslo" "W. Europe Standard Time" "NO"
+    "Europe/Paris" "Romance Standard Time" "001"
+    "Europe/Podgorica" "Central Europe Standard Time" "ME"
+    "Europe/Prague" "Central Europe Standard Time" "CZ"
+    "Europe/Riga" "FLE Standard Time" "LV"
+    "Europe/Rome" "W. Europe Standard Time" "IT"
+    "Europe/Samara" "Russia Time Zone 3" "001"
+    "Europe/San_Marino" "W. Europe Standard Time" "SM"
+    "Europe/Sarajevo" "Central European Standard Time" "BA"
+    "Europe/Saratov" "Saratov Standard Time" "001"
+    "Europe/Simferopol" "Russian Standard Time" "UA"
+    "Europe/Skopje" "Central European Standard Time" "MK"
+    "Europe/Sofia" "FLE Standard Time" "BG"
+    "Europe/Stockholm" "W. Europe Standard Time" "SE"
+    "Europe/Tallinn" "FLE Standard Time" "EE"
+    "Europe/Tirane" "Central Europe Standard Time" "AL"
+    "Europe/Ulyanovsk" "Astrakhan Standard Time" "RU"
+    "Europe/Uzhgorod" "FLE Standard Time" "UA"
+    "Europe/Vaduz" "W. Europe Standard Time" "LI"
+    "Europe/Vatican" "W. Europe Standard Time" "VA"
+    "Europe/Vienna" "W. Europe Standard Time" "AT"
+    "Europe/Vilnius" "FLE Standard Time" "LT"
+    "Europe/Volgograd" "Russian Standard Time" "RU"
+    "Europe/Warsaw" "Central European Standard Time" "001"
+    "Europe/Zagreb" "Central European Standard Time" "HR"
+    "Europe/Zaporozhye" "FLE Standard Time" "UA"
+    "Europe/Zurich" "W. Europe Standard Time" "CH"
+    "Indian/Antananarivo" "E. Africa Standard Time" "MG"
+    "Indian/Chagos" "Central Asia Standard Time" "IO"
+    "Indian/Christmas" "SE Asia Standard Time" "CX"
+    "Indian/Cocos" "Myanmar Standard Time" "CC"
+    "Indian/Comoro" "E. Africa Standard Time" "KM"
+    "Indian/Kerguelen" "West Asia Standard Time" "TF"
+    "Indian/Mahe" "Mauritius Standard Time" "SC"
+    "Indian/Maldives" "West Asia Standard Time" "MV"
+    "Indian/Mauritius" "Mauritius Standard Time" "001"
+    "Indian/Mayotte" "E. Africa Standard Time" "YT"
+    "Indian/Reunion" "Mauritius Standard Time" "RE"
+    "MST7MDT" "Mountain Standard Time" "ZZ"
+    "PST8PDT" "Pacific Standard Time" "ZZ"
+    "Pacific/Apia" "Samoa Standard Time" "001"
+    "Pacific/Auckland" "New Zealand Standard Time" "001"
+    "Pacific/Bougainville" "Bougainville Standard Time" "001"
+    "Pacific/Chatham" "Chatham Islands Standard Time" "001"
+    "Pacific/Easter" "Easter Island Standard Time" "001"
+    "Pacific/Efate" "Central Pacific Standard Time" "VU"
+    "Pacific/Enderbury" "UTC+13" "KI"
+    "Pacific/Fakaofo" "UTC+13" "TK"
+    "Pacific/Fiji" "Fiji Standard Time" "001"
+    "Pacific/Funafuti" "UTC+12" "TV"
+    "Pacific/Galapagos" "Central America Standard Time" "EC"
+    "Pacific/Gambier" "UTC-09" "PF"
+    "Pacific/Guadalcanal" "Central Pacific Standard Time" "001"
+    "Pacific/Guam" "West Pacific Standard Time" "GU"
+    "Pacific/Honolulu" "Hawaiian Standard Time" "001"
+    "Pacific/Johnston" "Hawaiian Standard Time" "UM"
+    "Pacific/Kiritimati" "Line Islands Standard Time" "001"
+    "Pacific/Kosrae" "Central Pacific Standard Time" "FM"
+    "Pacific/Kwajalein" "UTC+12" "MH"
+    "Pacific/Majuro" "UTC+12" "MH"
+    "Pacific/Marquesas" "Marquesas Standard Time" "001"
+    "Pacific/Midway" "UTC-11" "UM"
+    "Pacific/Nauru" "UTC+12" "NR"
+    "Pacific/Niue" "UTC-11" "NU"
+    "Pacific/Norfolk" "Norfolk Standard Time" "001"
+    "Pacific/Noumea" "Central Pacific Standard Time" "NC"
+    "Pacific/Pago_Pago" "UTC-11" "AS"
+    "Pacific/Palau" "Tokyo Standard Time" "PW"
+    "Pacific/Pitcairn" "UTC-08" "PN"
+    "Pacific/Ponape" "Central Pacific Standard Time" "FM"
+    "Pacific/Port_Moresby" "West Pacific Standard Time" "001"
+    "Pacific/Rarotonga" "Hawaiian Standard Time" "CK"
+    "Pacific/Saipan" "West Pacific Standard Time" "MP"
+    "Pacific/Tahiti" "Hawaiian Standard Time" "PF"
+    "Pacific/Tarawa" "UTC+12" "KI"
+    "Pacific/Tongatapu" "Tonga Standard Time" "001"
+    "Pacific/Truk" "West Pacific Standard Time" "FM"
+    "Pacific/Wake" "UTC+12" "UM"
+    "Pacific/Wallis" "UTC+12" "WF"
+    "";
+
+inline constexpr IanaMapEntry g_iana_entries[ 459 ] = {
+    { 0u, 14u, 37u, 14u, 23u, 2u },
+    { 39u, 51u, 74u, 12u, 23u, 2u },
+    { 76u, 94u, 117u, 18u, 23u, 2u },
+    { 119u, 133u, 164u, 14u, 31u, 2u },
+    { 166u, 179u, 202u, 13u, 23u, 2u },
+    { 204u, 217u, 240u, 13u, 23u, 2u },
+    { 242u, 255u, 286u, 13u, 31u, 2u },
+    { 288u, 301u, 324u, 13u, 23u, 2u },
+    { 326u, 339u, 362u, 13u, 23u, 2u },
+    { 364u, 379u, 405u, 15u, 26u, 2u },
+    { 407u, 425u, 456u, 18u, 31u, 2u },
+    { 458u, 474u, 500u, 16u, 26u, 2u },
+    { 502u, 514u, 533u, 12u, 19u, 3u },
+    { 536u, 553u, 574u, 17u, 21u, 3u },
+    { 577u, 589u, 610u, 12u, 21u, 2u },
+    { 612u, 626u, 649u, 14u, 23u, 2u },
+    { 651u, 663u, 686u, 12u, 23u, 2u },
+    { 688u, 708u, 731u, 20u, 23u, 2u },
+    { 733u, 748u, 771u, 15u, 23u, 2u },
+    { 773u, 786u, 817u, 13u, 31u, 2u },
+    { 819u, 834u, 855u, 15u, 21u, 2u },
+    { 857u, 872u, 895u, 15u, 23u, 2u },
+    { 897u, 912u, 938u, 15u, 26u, 2u },
+    { 940u, 953u, 979u, 13u, 26u, 2u },
+    { 981u, 1000u, 1026u, 19u, 26u, 3u },
+    { 1029u, 1040u, 1063u, 11u, 23u, 2u },
+    { 1065u, 1079u, 1102u, 14u, 23u, 2u },
+    { 1104u, 1119u, 1138u, 15u, 19u, 3u },
+    { 1141u, 1154u, 1180u, 13u, 26u, 2u },
+    { 1182u, 1197u, 1228u, 15u, 31u, 2u },
+    { 1230u, 1242u, 1273u, 12u, 31u, 3u },
+    { 1276u, 1293u, 1324u, 17u, 31u, 2u },
+    { 1326u, 1337u, 1360u, 11u, 23u, 2u },
+    { 1362u, 1375u, 1406u, 13u, 31u, 2u },
+    { 1408u, 1425u, 1451u, 17u, 26u, 2u },
+    { 1453u, 1466u, 1492u, 13u, 26u, 2u },
+    { 1494u, 1507u, 1538u, 13u, 31u, 2u },
+    { 1540u, 1553u, 1579u, 13u, 26u, 2u },
+    { 1581u, 1594u, 1620u, 13u, 26u, 2u },
+    { 1622u, 1636u, 1662u, 14u, 26u, 2u },
+    { 1664u, 1680u, 1703u, 16u, 23u, 2u },
+    { 1705u, 1720u, 1743u, 15u, 23u, 2u },
+    { 1745u, 1759u, 1782u, 14u, 23u, 3u },
+    { 1785u, 1800u, 1831u, 15u, 31u, 2u },
+    { 1833u, 1846u, 1877u, 13u, 31u, 2u },
+    { 1879u, 1896u, 1919u, 17u, 23u, 2u },
+    { 1921u, 1939u, 1962u, 18u, 23u, 2u },
+    { 1964u, 1981u, 2012u, 17u, 31u, 2u },
+    { 2014u, 2029u, 2051u, 15u, 22u, 3u },
+    { 2054u, 2068u, 2087u, 14u, 19u, 3u },
+    { 2090u, 2102u, 2133u, 12u, 31u, 2u },
+    { 2135u, 2150u, 2171u, 15u, 21u, 3u },
+    { 2174u, 2186u, 2208u, 12u, 22u, 3u },
+    { 2211u, 2228u, 2249u, 17u, 21u, 3u },
+    { 2252u, 2268u, 2292u, 16u, 24u, 2u },
+    { 2294u, 2309u, 2333u, 15u, 24u, 2u },
+    { 2335u, 2352u, 2375u, 17u, 23u, 3u },
+    { 2378u, 2404u, 2427u, 26u, 23u, 2u },
+    { 2429u, 2459u, 2482u, 30u, 23u, 2u },
+    { 2484u, 2507u, 2530u, 23u, 23u, 2u },
+    { 2532u, 2558u, 2581u, 26u, 23u, 2u },
+    { 2583u, 2609u, 2632u, 26u, 23u, 2u },
+    { 2634u, 2659u, 2682u, 25u, 23u, 2u },
+    { 2684u, 2709u, 2732u, 25u, 23u, 2u },
+    { 2734u, 2747u, 2771u, 13u, 24u, 2u },
+    { 2773u, 2789u, 2811u, 16u, 22u, 3u },
+    { 2814u, 2827u, 2846u, 13u, 19u, 3u },
+    { 2849u, 2871u, 2901u, 22u, 30u, 2u },
+    { 2903u, 2919u, 2943u, 16u, 24u, 2u },
+    { 2945u, 2958u, 2982u, 13u, 24u, 2u },
+    { 2984u, 2998u, 3027u, 14u, 29u, 2u },
+    { 3029u, 3049u, 3073u, 20u, 24u, 2u },
+    { 3075u, 3092u, 3116u, 17u, 24u, 2u },
+    { 3118u, 3132u, 3156u, 14u, 24u, 3u },
+    { 3159u, 3172u, 3194u, 13u, 22u, 2u },
+    { 3196u, 3216u, 3239u, 20u, 23u, 3u },
+    { 3242u, 3263u, 3285u, 21u, 22u, 2u },
+    { 3287u, 3307u, 3338u, 20u, 31u, 2u },
+    { 3340u, 3354u, 3384u, 14u, 30u, 3u },
+    { 3387u, 3402u, 3425u, 15u, 23u, 3u },
+    { 3428u, 3445u, 3468u, 17u, 23u, 2u },
+    { 3470u, 3485u, 3509u, 15u, 24u, 3u },
+    { 3512u, 3526u, 3550u, 14u, 24u, 2u },
+    { 3552u, 3567u, 3588u, 15u, 21u, 3u },
+    { 3591u, 3608u, 3639u, 17u, 31u, 3u },
+    { 3642u, 3663u, 3687u, 21u, 24u, 2u },
+    { 3689u, 3704u, 3727u, 15u, 23u, 2u },
+    { 3729u, 3747u, 3776u, 18u, 29u, 2u },
+    { 3778u, 3793u, 3818u, 15u, 25u, 2u },
+    { 3820u, 3834u, 3865u, 14u, 31u, 3u },
+    { 3868u, 3883u, 3907u, 15u, 24u, 2u },
+    { 3909u, 3929u, 3932u, 20u, 3u, 2u },
+    { 3934u, 3948u, 3969u, 14u, 21u, 2u },
+    { 3971u, 3991u, 4016u, 20u, 25u, 2u },
+    { 4018u, 4032u, 4054u, 14u, 22u, 3u },
+    { 4057u, 4072u, 4093u, 15u, 21u, 2u },
+    { 4095u, 4111u, 4135u, 16u, 24u, 2u },
+    { 4137u, 4153u, 4175u, 16u, 22u, 2u },
+    { 4177u, 4193u, 4217u, 16u, 24u, 2u },
+    { 4219u, 4238u, 4267u, 19u, 29u, 2u },
+    { 4269u, 4288u, 4313u, 19u, 25u, 2u },
+    { 4315u, 4332u, 4356u, 17u, 24u, 2u },
+    { 4358u, 4375u, 4397u, 17u, 22u, 2u },
+    { 4399u, 4414u, 4437u, 15u, 23u, 3u },
+    { 4440u, 4457u, 4479u, 17u, 22u, 2u },
+    { 4481u, 4499u, 4529u, 18u, 30u, 3u },
+    { 4532u, 4547u, 4571u, 15u, 24u, 2u },
+    { 4573u, 4591u, 4615u, 18u, 24u, 2u },
+    { 4617u, 4634u, 4663u, 17u, 29u, 3u },
+    { 4666u, 4683u, 4707u, 17u, 24u, 2u },
+    { 4709u, 4723u, 4747u, 14u, 24u, 2u },
+    { 4749u, 4764u, 4786u, 15u, 22u, 3u },
+    { 4789u, 4803u, 4821u, 14u, 18u, 3u },
+    { 4824u, 4842u, 4867u, 18u, 25u, 2u },
+    { 4869u, 4889u, 4910u, 20u, 21u, 2u },
+    { 4912u, 4935u, 4959u, 23u, 24u, 2u },
+    { 4961u, 4987u, 5008u, 26u, 21u, 2u },
+    { 5010u, 5035u, 5056u, 25u, 21u, 2u },
+    { 5058u, 5079u, 5103u, 21u, 24u, 2u },
+    { 5105u, 5130u, 5151u, 25u, 21u, 2u },
+    { 5153u, 5176u, 5197u, 23u, 21u, 2u },
+    { 5199u, 5219u, 5243u, 20u, 24u, 3u },
+    { 5246u, 5260u, 5282u, 14u, 22u, 2u },
+    { 5284u, 5299u, 5320u, 15u, 21u, 2u },
+    { 5322u, 5337u, 5361u, 15u, 24u, 2u },
+    { 5363u, 5376u, 5399u, 13u, 23u, 2u },
+    { 5401u, 5415u, 5436u, 14u, 21u, 2u },
+    { 5438u, 5465u, 5486u, 27u, 21u, 2u },
+    { 5488u, 5506u, 5530u, 18u, 24u, 2u },
+    { 5532u, 5546u, 5570u, 14u, 24u, 3u },
+    { 5573u, 5585u, 5609u, 12u, 24u, 2u },
+    { 5611u, 5630u, 5651u, 19u, 21u, 3u },
+    { 5654u, 5672u, 5693u, 18u, 21u, 2u },
+    { 5695u, 5716u, 5740u, 21u, 24u, 2u },
+    { 5742u, 5756u, 5780u, 14u, 24u, 2u },
+    { 5782u, 5797u, 5826u, 15u, 29u, 2u },
+    { 5828u, 5842u, 5866u, 14u, 24u, 2u },
+    { 5868u, 5883u, 5907u, 15u, 24u, 2u },
+    { 5909u, 5927u, 5951u, 18u, 24u, 2u },
+    { 5953u, 5970u, 5991u, 17u, 21u, 2u },
+    { 5993u, 6009u, 6040u, 16u, 31u, 2u },
+    { 6042u, 6057u, 6080u, 15u, 23u, 2u },
+    { 6082u, 6099u, 6120u, 17u, 21u, 2u },
+    { 6122u, 6136u, 6166u, 14u, 30u, 2u },
+    { 6168u, 6186u, 6207u, 18u, 21u, 2u },
+    { 6209u, 6228u, 6258u, 19u, 30u, 3u },
+    { 6261u, 6277u, 6303u, 16u, 26u, 3u },
+    { 6306u, 6321u, 6343u, 15u, 22u, 2u },
+    { 6345u, 6362u, 6392u, 17u, 30u, 2u },
+    { 6394u, 6412u, 6436u, 18u, 24u, 3u },
+    { 6439u, 6455u, 6476u, 16u, 21u, 2u },
+    { 6478u, 6496u, 6520u, 18u, 24u, 2u },
+    { 6522u, 6536u, 6557u, 14u, 21u, 2u },
+    { 6559u, 6575u, 6596u, 16u, 21u, 3u },
+    { 6599u, 6614u, 6635u, 15u, 21u, 2u },
+    { 6637u, 6649u, 6670u, 12u, 21u, 2u },
+    { 6672u, 6687u, 6693u, 15u, 6u, 2u },
+    { 6695u, 6722u, 6743u, 27u, 21u, 2u },
+    { 6745u, 6772u, 6793u, 27u, 21u, 2u },
+    { 6795u, 6825u, 6846u, 30u, 21u, 2u },
+    { 6848u, 6863u, 6885u, 15u, 22u, 2u },
+    { 6887u, 6901u, 6925u, 14u, 24u, 2u },
+    { 6927u, 6946u, 6967u, 19u, 21u, 2u },
+    { 6969u, 6987u, 7011u, 18u, 24u, 2u },
+    { 7013u, 7028u, 7053u, 15u, 25u, 3u },
+    { 7056u, 7078u, 7097u, 22u, 19u, 3u },
+    { 7100u, 7121u, 7145u, 21u, 24u, 2u },
+    { 7147u, 7166u, 7190u, 19u, 24u, 2u },
+    { 7192u, 7211u, 7235u, 19u, 24u, 2u },
+    { 7237u, 7257u, 7281u, 20u, 24u, 3u },
+    { 7284u, 7303u, 7324u, 19u, 21u, 2u },
+    { 7326u, 7346u, 7367u, 20u, 21u, 2u },
+    { 7369u, 7383u, 7407u, 14u, 24u, 2u },
+    { 7409u, 7423u, 7451u, 14u, 28u, 3u },
+    { 7454u, 7470u, 7491u, 16u, 21u, 2u },
+    { 7493u, 7511u, 7535u, 18u, 24u, 2u },
+    { 7537u, 7557u, 7587u, 20u, 30u, 2u },
+    { 7589u, 7605u, 7629u, 16u, 24u, 2u },
+    { 7631u, 7647u, 7671u, 16u, 24u, 3u },
+    { 7674u, 7695u, 7719u, 21u, 24u, 2u },
+    { 7721u, 7738u, 7768u, 17u, 30u, 3u },
+    { 7771u, 7791u, 7811u, 20u, 20u, 2u },
+    { 7813u, 7826u, 7847u, 13u, 21u, 2u },
+    { 7849u, 7870u, 7894u, 21u, 24u, 2u },
+    { 7896u, 7912u, 7938u, 16u, 26u, 3u },
+    { 7941u, 7957u, 7981u, 16u, 24u, 2u },
+    { 7983u, 7999u, 8023u, 16u, 24u, 2u },
+    { 8025u, 8042u, 8066u, 17u, 24u, 2u },
+    { 8068u, 8086u, 8110u, 18u, 24u, 2u },
+    { 8112u, 8133u, 8161u, 21u, 28u, 2u },
+    { 8163u, 8182u, 8211u, 19u, 29u, 2u },
+    { 8213u, 8226u, 8248u, 13u, 22u, 2u },
+    { 8250u, 8269u, 8290u, 19u, 21u, 2u },
+    { 8292u, 8307u, 8337u, 15u, 30u, 3u },
+    { 8340u, 8355u, 8376u, 15u, 21u, 2u },
+    { 8378u, 8393u, 8417u, 15u, 24u, 2u },
+    { 8419u, 8436u, 8457u, 17u, 21u, 2u },
+    { 8459u, 8477u, 8498u, 18u, 21u, 2u },
+    { 8500u, 8516u, 8537u, 16u, 21u, 2u },
+    { 8539u, 8554u, 8575u, 15u, 21u, 2u },
+    { 8577u, 8596u, 8618u, 19u, 22u, 2u },
+    { 8620u, 8636u, 8662u, 16u, 26u, 2u },
+    { 8664u, 8680u, 8701u, 16u, 21u, 2u },
+    { 8703u, 8728u, 8754u, 25u, 26u, 2u },
+    { 8756u, 8776u, 8805u, 20u, 29u, 2u },
+    { 8807u, 8824u, 8847u, 17u, 23u, 2u },
+    { 8849u, 8867u, 8892u, 18u, 25u, 2u },
+    { 8894u, 8911u, 8935u, 17u, 24u, 2u },
+    { 8937u, 8955u, 8979u, 18u, 24u, 2u },
+    { 8981u, 8997u, 9020u, 16u, 23u, 2u },
+    { 9022u, 9039u, 9065u, 17u, 26u, 2u },
+    { 9067u, 9086u, 9109u, 19u, 23u, 2u },
+    { 9111u, 9120u, 9138u, 9u, 18u, 2u },
+    { 9140u, 9151u, 9177u, 11u, 26u, 3u },
+    { 9180u, 9190u, 9210u, 10u, 20u, 3u },
+    { 9213u, 9224u, 9243u, 11u, 19u, 2u },
+    { 9245u, 9255u, 9278u, 10u, 23u, 2u },
+    { 9280u, 9291u, 9314u, 11u, 23u, 2u },
+    { 9316u, 9329u, 9352u, 13u, 23u, 2u },
+    { 9354u, 9365u, 9388u, 11u, 23u, 2u },
+    { 9390u, 9402u, 9422u, 12u, 20u, 3u },
+    { 9425u, 9437u, 9455u, 12u, 18u, 2u },
+    { 9457u, 9466u, 9490u, 9u, 24u, 3u },
+    { 9493u, 9505u, 9526u, 12u, 21u, 3u },
+    { 9529u, 9541u, 9560u, 12u, 19u, 3u },
+    { 9563u, 9574u, 9599u, 11u, 25u, 3u },
+    { 9602u, 9614u, 9640u, 12u, 26u, 2u },
+    { 9642u, 9653u, 9676u, 11u, 23u, 2u },
+    { 9678u, 9691u, 9710u, 13u, 19u, 3u },
+    { 9713u, 9723u, 9748u, 10u, 25u, 3u },
+    { 9751u, 9766u, 9791u, 15u, 25u, 2u },
+    { 9793u, 9805u, 9828u, 12u, 23u, 3u },
+    { 9831u, 9844u, 9863u, 13u, 19u, 3u },
+    { 9866u, 9876u, 9900u, 10u, 24u, 3u },
+    { 9903u, 9912u, 9931u, 9u, 19u, 2u },
+    { 9933u, 9943u, 9964u, 10u, 21u, 3u },
+    { 9967u, 9980u, 10003u, 13u, 23u, 2u },
+    { 10005u, 10019u, 10036u, 14u, 17u, 2u },
+    { 10038u, 10047u, 10070u, 9u, 23u, 2u },
+    { 10072u, 10083u, 10106u, 11u, 23u, 3u },
+    { 10109u, 10123u, 10142u, 14u, 19u, 2u },
+    { 10144u, 10153u, 10178u, 9u, 25u, 3u },
+    { 10181u, 10193u, 10222u, 12u, 29u, 3u },
+    { 10225u, 10237u, 10258u, 12u, 21u, 2u },
+    { 10260u, 10273u, 10292u, 13u, 19u, 2u },
+    { 10294u, 10308u, 10328u, 14u, 20u, 3u },
+    { 10331u, 10341u, 10366u, 10u, 25u, 3u },
+    { 10369u, 10383u, 10402u, 14u, 19u, 3u },
+    { 10405u, 10417u, 10439u, 12u, 22u, 3u },
+    { 10442u, 10455u, 10474u, 13u, 19u, 3u },
+    { 10477u, 10490u, 10511u, 13u, 21u, 2u },
+    { 10513u, 10529u, 10553u, 16u, 24u, 3u },
+    { 10556u, 10573u, 10596u, 17u, 23u, 2u },
+    { 10598u, 10610u, 10633u, 12u, 23u, 2u },
+    { 10635u, 10646u, 10664u, 11u, 18u, 2u },
+    { 10666u, 10676u, 10695u, 10u, 19u, 2u },
+    { 10697u, 10709u, 10730u, 12u, 21u, 3u },
+    { 10733u, 10746u, 10769u, 13u, 23u, 2u },
+    { 10771u, 10782u, 10805u, 11u, 23u, 2u },
+    { 10807u, 10818u, 10839u, 11u, 21u, 2u },
+    { 10841u, 10853u, 10870u, 12u, 17u, 2u },
+    { 10872u, 10889u, 10913u, 17u, 24u, 2u },
+    { 10915u, 10931u, 10960u, 16u, 29u, 3u },
+    { 10963u, 10972u, 10990u, 9u, 18u, 3u },
+    { 10993u, 11002u, 11025u, 9u, 23u, 2u },
+    { 11027u, 11042u, 11063u, 15u, 21u, 2u },
+    { 11065u, 11079u, 11100u, 14u, 21u, 2u },
+    { 11102u, 11116u, 11141u, 14u, 25u, 3u },
+    { 11144u, 11154u, 11172u, 10u, 18u, 2u },
+    { 11174u, 11187u, 11213u, 13u, 26u, 2u },
+    { 11215u, 11229u, 11252u, 14u, 23u, 2u },
+    { 11254u, 11266u, 11287u, 12u, 21u, 3u },
+    { 11290u, 11301u, 11319u, 11u, 18u, 3u },
+    { 11322u, 11333u, 11354u, 11u, 21u, 2u },
+    { 11356u, 11369u, 11391u, 13u, 22u, 3u },
+    { 11394u, 11408u, 11431u, 14u, 23u, 2u },
+    { 11433u, 11443u, 11462u, 10u, 19u, 3u },
+    { 11465u, 11478u, 11497u, 13u, 19u, 3u },
+    { 11500u, 11514u, 11537u, 14u, 23u, 3u },
+    { 11540u, 11558u, 11577u, 18u, 19u, 3u },
+    { 11580u, 11591u, 11611u, 11u, 20u, 3u },
+    { 11614u, 11627u, 11650u, 13u, 23u, 3u },
+    { 11653u, 11665u, 11687u, 12u, 22u, 3u },
+    { 11690u, 11701u, 11719u, 11u, 18u, 3u },
+    { 11722u, 11734u, 11758u, 12u, 24u, 2u },
+    { 11760u, 11770u, 11789u, 10u, 19u, 3u },
+    { 11792u, 11802u, 11821u, 10u, 19u, 3u },
+    { 11824u, 11840u, 11865u, 16u, 25u, 3u },
+    { 11868u, 11879u, 11905u, 11u, 26u, 2u },
+    { 11907u, 11920u, 11945u, 13u, 25u, 2u },
+    { 11947u, 11961u, 11982u, 14u, 21u, 2u },
+    { 11984u, 12000u, 12025u, 16u, 25u, 3u },
+    { 12028u, 12040u, 12061u, 12u, 21u, 3u },
+    { 12064u, 12082u, 12108u, 18u, 26u, 3u },
+    { 12111u, 12123u, 12145u, 12u, 22u, 3u },
+    { 12148u, 12163u, 12183u, 15u, 20u, 3u },
+    { 12186u, 12202u, 12224u, 16u, 22u, 2u },
+    { 12226u, 12241u, 12258u, 15u, 17u, 2u },
+    { 12260u, 12279u, 12303u, 19u, 24u, 3u },
+    { 12306u, 12321u, 12338u, 15u, 17u, 2u },
+    { 12340u, 12356u, 12373u, 16u, 17u, 2u },
+    { 12375u, 12393u, 12416u, 18u, 23u, 3u },
+    { 12419u, 12441u, 12447u, 22u, 6u, 2u },
+    { 12449u, 12467u, 12490u, 18u, 23u, 2u },
+    { 12492u, 12508u, 12532u, 16u, 24u, 2u },
+    { 12534u, 12552u, 12580u, 18u, 28u, 3u },
+    { 12583u, 12601u, 12627u, 18u, 26u, 3u },
+    { 12630u, 12651u, 12679u, 21u, 28u, 2u },
+    { 12681u, 12697u, 12719u, 16u, 22u, 2u },
+    { 12721u, 12737u, 12762u, 16u, 25u, 3u },
+    { 12765u, 12780u, 12808u, 15u, 28u, 3u },
+    { 12811u, 12827u, 12849u, 16u, 22u, 3u },
+    { 12852u, 12870u, 12896u, 18u, 26u, 2u },
+    { 12898u, 12917u, 12940u, 19u, 23u, 3u },
+    { 12943u, 12962u, 12987u, 19u, 25u, 2u },
+    { 12989u, 13004u, 13030u, 15u, 26u, 3u },
+    { 13033u, 13049u, 13074u, 16u, 25u, 3u },
+    { 13077u, 13084u, 13105u, 7u, 21u, 2u },
+    { 13107u, 13114u, 13135u, 7u, 21u, 2u },
+    { 13137u, 13144u, 13147u, 7u, 3u, 3u },
+    { 13150u, 13159u, 13183u, 9u, 24u, 2u },
+    { 13185u, 13195u, 13217u, 10u, 22u, 2u },
+    { 13219u, 13229u, 13235u, 10u, 6u, 3u },
+    { 13238u, 13248u, 13270u, 10u, 22u, 3u },
+    { 13273u, 13282u, 13288u, 9u, 6u, 3u },
+    { 13291u, 13300u, 13324u, 9u, 24u, 2u },
+    { 13326u, 13335u, 13359u, 9u, 24u, 2u },
+    { 13361u, 13370u, 13394u, 9u, 24u, 2u },
+    { 13396u, 13405u, 13434u, 9u, 29u, 2u },
+    { 13436u, 13445u, 13470u, 9u, 25u, 2u },
+    { 13472u, 13481u, 13487u, 9u, 6u, 3u },
+    { 13490u, 13499u, 13505u, 9u, 6u, 3u },
+    { 13508u, 13517u, 13548u, 9u, 31u, 2u },
+    { 13550u, 13560u, 13586u, 10u, 26u, 2u },
+    { 13588u, 13598u, 13627u, 10u, 29u, 2u },
+    { 13629u, 13639u, 13645u, 10u, 6u, 3u },
+    { 13648u, 13658u, 13664u, 10u, 6u, 3u },
+    { 13667u, 13677u, 13703u, 10u, 26u, 2u },
+    { 13705u, 13714u, 13740u, 9u, 26u, 2u },
+    { 13742u, 13751u, 13774u, 9u, 23u, 2u },
+    { 13776u, 13785u, 13806u, 9u, 21u, 2u },
+    { 13808u, 13817u, 13840u, 9u, 23u, 2u },
+    { 13842u, 13851u, 13877u, 9u, 26u, 2u },
+    { 13879u, 13888u, 13909u, 9u, 21u, 2u },
+    { 13911u, 13920u, 13943u, 9u, 23u, 2u },
+    { 13945u, 13954u, 13973u, 9u, 19u, 2u },
+    { 13975u, 13982u, 13985u, 7u, 3u, 2u },
+    { 13987u, 14003u, 14026u, 16u, 23u, 2u },
+    { 14028u, 14042u, 14065u, 14u, 23u, 2u },
+    { 14067u, 14083u, 14106u, 16u, 23u, 3u },
+    { 14109u, 14122u, 14139u, 13u, 17u, 2u },
+    { 14141u, 14156u, 14184u, 15u, 28u, 2u },
+    { 14186u, 14199u, 14222u, 13u, 23u, 3u },
+    { 14225u, 14242u, 14270u, 17u, 28u, 2u },
+    { 14272u, 14287u, 14308u, 15u, 21u, 2u },
+    { 14310u, 14326u, 14343u, 16u, 17u, 3u },
+    { 14346u, 14361u, 14389u, 15u, 28u, 3u },
+    { 14392u, 14407u, 14430u, 15u, 23u, 2u },
+    { 14432u, 14447u, 14470u, 15u, 23u, 3u },
+    { 14473u, 14490u, 14511u, 17u, 21u, 2u },
+    { 14513u, 14526u, 14543u, 13u, 17u, 2u },
+    { 14545u, 14561u, 14584u, 16u, 23u, 2u },
+    { 14586u, 14601u, 14618u, 15u, 17u, 2u },
+    { 14620u, 14635u, 14652u, 15u, 17u, 2u },
+    { 14654u, 14672u, 14689u, 18u, 17u, 2u },
+    { 14691u, 14706u, 14726u, 15u, 20u, 3u },
+    { 14729u, 14742u, 14759u, 13u, 17u, 2u },
+    { 14761u, 14779u, 14804u, 18u, 25u, 3u },
+    { 14807u, 14818u, 14835u, 11u, 17u, 3u },
+    { 14838u, 14850u, 14871u, 12u, 21u, 2u },
+    { 14873u, 14886u, 14903u, 13u, 17u, 2u },
+    { 14905u, 14921u, 14949u, 16u, 28u, 2u },
+    { 14951u, 14964u, 14981u, 13u, 17u, 3u },
+    { 14984u, 15001u, 15024u, 17u, 23u, 2u },
+    { 15026u, 15039u, 15060u, 13u, 21u, 2u },
+    { 15062u, 15074u, 15097u, 12u, 23u, 2u },
+    { 15099u, 15115u, 15132u, 16u, 17u, 2u },
+    { 15134u, 15146u, 15167u, 12u, 21u, 3u },
+    { 15170u, 15183u, 15206u, 13u, 23u, 2u },
+    { 15208u, 15221u, 15242u, 13u, 21u, 3u },
+    { 15245u, 15256u, 15279u, 11u, 23u, 2u },
+    { 15281u, 15293u, 15314u, 12u, 21u, 3u },
+    { 15317u, 15333u, 15361u, 16u, 28u, 2u },
+    { 15363u, 15376u, 15404u, 13u, 28u, 2u },
+    { 15406u, 15417u, 15434u, 11u, 17u, 2u },
+    { 15436u, 15447u, 15470u, 11u, 23u, 2u },
+    { 15472u, 15485u, 15503u, 13u, 18u, 3u },
+    { 15506u, 15523u, 15546u, 17u, 23u, 2u },
+    { 15548u, 15563u, 15593u, 15u, 30u, 2u },
+    { 15595u, 15609u, 15630u, 14u, 21u, 3u },
+    { 15633u, 15650u, 15671u, 17u, 21u, 2u },
+    { 15673u, 15686u, 15716u, 13u, 30u, 2u },
+    { 15718u, 15730u, 15747u, 12u, 17u, 2u },
+    { 15749u, 15765u, 15788u, 16u, 23u, 2u },
+    { 15790u, 15804u, 15821u, 14u, 17u, 2u },
+    { 15823u, 15836u, 15864u, 13u, 28u, 2u },
+    { 15866u, 15882u, 15905u, 16u, 23u, 2u },
+    { 15907u, 15922u, 15939u, 15u, 17u, 2u },
+    { 15941u, 15953u, 15976u, 12u, 23u, 2u },
+    { 15978u, 15992u, 16015u, 14u, 23u, 2u },
+    { 16017u, 16030u, 16053u, 13u, 23u, 2u },
+    { 16055u, 16069u, 16086u, 14u, 17u, 2u },
+    { 16088u, 16104u, 16125u, 16u, 21u, 2u },
+    { 16127u, 16140u, 16170u, 13u, 30u, 3u },
+    { 16173u, 16186u, 16216u, 13u, 30u, 2u },
+    { 16218u, 16235u, 16252u, 17u, 17u, 2u },
+    { 16254u, 16267u, 16290u, 13u, 23u, 2u },
+    { 16292u, 16311u, 16334u, 19u, 23u, 2u },
+    { 16336u, 16349u, 16375u, 13u, 26u, 2u },
+    { 16377u, 16393u, 16414u, 16u, 21u, 2u },
+    { 16416u, 16428u, 16449u, 12u, 21u, 2u },
+    { 16451u, 16464u, 16487u, 13u, 23u, 2u },
+    { 16489u, 16505u, 16528u, 16u, 23u, 2u },
+    { 16530u, 16541u, 16564u, 11u, 23u, 2u },
+    { 16566u, 16581u, 16604u, 15u, 23u, 2u },
+    { 16606u, 16622u, 16645u, 16u, 23u, 3u },
+    { 16648u, 16662u, 16685u, 14u, 23u, 2u },
+    { 16687u, 16701u, 16724u, 14u, 23u, 2u },
+    { 16726u, 16733u, 16755u, 7u, 22u, 2u },
+    { 16757u, 16764u, 16785u, 7u, 21u, 2u },
+    { 16787u, 16799u, 16818u, 12u, 19u, 3u },
+    { 16821u, 16837u, 16862u, 16u, 25u, 3u },
+    { 16865u, 16885u, 16911u, 20u, 26u, 3u },
+    { 16914u, 16929u, 16958u, 15u, 29u, 3u },
+    { 16961u, 16975u, 17002u, 14u, 27u, 3u },
+    { 17005u, 17018u, 17047u, 13u, 29u, 2u },
+    { 17049u, 17066u, 17072u, 17u, 6u, 2u },
+    { 17074u, 17089u, 17095u, 15u, 6u, 2u },
+    { 17097u, 17109u, 17127u, 12u, 18u, 3u },
+    { 17130u, 17146u, 17152u, 16u, 6u, 2u },
+    { 17154u, 17171u, 17200u, 17u, 29u, 2u },
+    { 17202u, 17217u, 17223u, 15u, 6u, 2u },
+    { 17225u, 17244u, 17273u, 19u, 29u, 3u },
+    { 17276u, 17288u, 17314u, 12u, 26u, 2u },
+    { 17316u, 17332u, 17354u, 16u, 22u, 3u },
+    { 17357u, 17373u, 17395u, 16u, 22u, 2u },
+    { 17397u, 17415u, 17441u, 18u, 26u, 3u },
+    { 17444u, 17458u, 17487u, 14u, 29u, 2u },
+    { 17489u, 17506u, 17512u, 17u, 6u, 2u },
+    { 17514u, 17528u, 17534u, 14u, 6u, 2u },
+    { 17536u, 17553u, 17576u, 17u, 23u, 3u },
+    { 17579u, 17593u, 17599u, 14u, 6u, 2u },
+    { 17601u, 17614u, 17620u, 13u, 6u, 2u },
+    { 17622u, 17634u, 17640u, 12u, 6u, 2u },
+    { 17642u, 17657u, 17678u, 15u, 21u, 3u },
+    { 17681u, 17695u, 17724u, 14u, 29u, 2u },
+    { 17726u, 17743u, 17749u, 17u, 6u, 2u },
+    { 17751u, 17764u, 17783u, 13u, 19u, 2u },
+    { 17785u, 17801u, 17807u, 16u, 6u, 2u },
+    { 17809u, 17823u, 17852u, 14u, 29u, 2u },
+    { 17854u, 17874u, 17900u, 20u, 26u, 3u },
+    { 17903u, 17920u, 17942u, 17u, 22u, 2u },
+    { 17944u, 17958u, 17984u, 14u, 26u, 2u },
+    { 17986u, 18000u, 18022u, 14u, 22u, 2u },
+    { 18024u, 18038u, 18044u, 14u, 6u, 2u },
+    { 18046u, 18063u, 18082u, 17u, 19u, 3u },
+    { 18085u, 18097u, 18123u, 12u, 26u, 2u },
+    { 18125u, 18137u, 18143u, 12u, 6u, 2u },
+    { 18145u, 18159u, 18165u, 14u, 6u, 2u },
+};
+
+inline constexpr std::uint32_t g_iana_displacements[ 115 ] = {
+    9u, 1u, 1u, 53u, 95u, 2u, 1u, 151u, 10u, 40u, 25u, 47u, 148u, 2u, 106u, 19u,
+    8u, 67u, 3u, 150u, 469u, 2u, 4u, 10u, 23u, 377u, 2u, 2u, 51u, 473u, 0u, 86u,
+    22u, 1u, 29u, 22u, 5u, 5u, 34u, 15u, 83u, 34u, 31u, 58u, 234u, 17u, 9u, 95u,
+    27u, 720u, 72u, 285u, 8u, 222u, 1u, 351u, 197u, 15u, 84u, 1u, 10u, 22u, 14u, 21u,
+    65u, 12u, 13u, 43u, 2u, 151u, 221u, 4888u, 34u, 33u, 33u, 87u, 1u, 82u, 169u, 3u,
+    210u, 657u, 1128u, 25u, 520u, 43u, 5117u, 16u, 5u, 2u, 4u, 51u, 69u, 2u, 22u, 149u,
+    0u, 23u, 226u, 440u, 417u, 683u, 112u, 2272u, 0u, 186u, 15u, 15u, 507u, 63u, 188u, 251u,
+    974u, 0u, 76u,
+};
+
+inline constexpr std::uint16_t g_iana_slots[ 459 ] = {
+    232u, 133u, 252u, 118u, 54u, 29u, 426u, 194u, 12u, 32u, 327u, 322u, 23u, 412u, 83u, 1u,
+    421u, 301u, 26u, 43u, 36u, 215u, 399u, 441u, 24u, 440u, 292u, 42u, 190u, 134u, 289u, 182u,
+    348u, 228u, 304u, 390u, 388u, 271u, 255u, 273u, 311u, 423u, 160u, 176u, 295u, 99u, 175u, 245u,
+    334u, 339u, 242u, 251u, 91u, 444u, 100u, 6u, 107u, 424u, 111u, 172u, 265u, 181u, 16u, 159u,
+    188u, 320u, 336u, 450u, 455u, 47u, 96u, 290u, 186u, 130u, 363u, 55u, 56u, 297u, 344u, 291u,
+    427u, 394u, 446u, 173u, 128u, 4u, 310u, 256u, 18u, 454u, 77u, 431u, 299u, 214u, 392u, 123u,
+    21u, 318u, 117u, 22u, 387u, 112u, 93u, 396u, 432u, 167u, 354u, 345u, 51u, 211u, 137u, 262u,
+    126u, 34u, 449u, 152u, 422u, 415u, 428u, 340u, 364u, 243u, 367u, 405u, 31u, 65u, 439u, 329u,
+    76u, 59u, 328u, 110u, 231u, 39u, 285u, 230u, 409u, 226u, 395u, 303u, 81u, 154u, 61u, 183u,
+    58u, 438u, 272u, 443u, 331u, 233u, 397u, 88u, 277u, 104u, 257u, 165u, 346u, 106u, 197u, 380u,
+    307u, 224u, 308u, 234u, 425u, 375u, 195u, 383u, 223u, 98u, 138u, 187u, 269u, 67u, 5u, 274u,
+    127u, 360u, 456u, 338u, 27u, 445u, 213u, 11u, 333u, 264u, 275u, 410u, 270u, 119u, 212u, 313u,
+    253u, 89u, 157u, 53u, 108u, 418u, 447u, 249u, 358u, 279u, 436u, 28u, 90u, 378u, 376u, 17u,
+    66u, 300u, 71u, 177u, 62u, 453u, 283u, 350u, 236u, 205u, 335u, 353u, 356u, 221u, 323u, 131u,
+    359u, 113u, 139u, 178u, 352u, 94u, 8u, 125u, 403u, 49u, 332u, 115u, 391u, 413u, 368u, 287u,
+    357u, 120u, 400u, 433u, 314u, 457u, 238u, 68u, 153u, 15u, 63u, 64u, 361u, 204u, 101u, 147u,
+    142u, 7u, 351u, 317u, 281u, 268u, 309u, 13u, 315u, 203u, 225u, 276u, 419u, 294u, 278u, 145u,
+    258u, 373u, 227u, 219u, 430u, 70u, 286u, 170u, 10u, 168u, 44u, 40u, 374u, 216u, 45u, 150u,
+    261u, 202u, 9u, 75u, 209u, 382u, 401u, 105u, 379u, 184u, 169u, 280u, 162u, 266u, 136u, 342u,
+    218u, 179u, 79u, 149u, 404u, 321u, 408u, 3u, 229u, 369u, 143u, 330u, 407u, 122u, 247u, 207u,
+    121u, 406u, 48u, 199u, 14u, 298u, 377u, 326u, 171u, 437u, 458u, 414u, 248u, 148u, 124u, 411u,
+    201u, 192u, 92u, 384u, 166u, 435u, 222u, 337u, 250u, 293u, 2u, 60u, 200u, 87u, 267u, 263u,
+    393u, 132u, 385u, 20u, 144u, 288u, 398u, 347u, 84u, 389u, 349u, 241u, 80u, 420u, 305u, 362u,
+    210u, 235u, 155u, 19u, 151u, 429u, 343u, 259u, 129u, 156u, 365u, 381u, 73u, 57u, 52u, 198u,
+    69u, 442u, 371u, 25u, 97u, 102u, 386u, 78u, 206u, 116u, 146u, 82u, 448u, 161u, 240u, 451u,
+    103u, 74u, 0u, 312u, 372u, 163u, 33u, 217u, 325u, 319u, 135u, 193u, 282u, 284u, 35u, 296u,
+    164u, 50u, 452u, 434u, 324u, 417u, 86u, 72u, 141u, 46u, 260u, 246u, 191u, 355u, 196u, 237u,
+    85u, 208u, 316u, 220u, 38u, 95u, 30u, 402u, 180u, 140u, 302u, 366u, 239u, 37u, 306u, 41u,
+    416u, 189u, 254u, 341u, 174u, 158u, 114u, 109u, 185u, 370u, 244u,
+};
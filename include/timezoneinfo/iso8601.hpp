@@ -0,0 +1,56 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the \"Software\"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "calendar.hpp"
+
+#include <cstddef>
+
+#include <optional>
+#include <span>
+#include <string_view>
+
+// Parsing of ISO 8601 / RFC 3339 timestamps into UTC instants,
+//
+//     YYYY-MM-DD ( T | t | ' ' ) HH:MM:SS [ .fraction ] [ Z | z | ( + | - ) HH [ : ] MM ]
+//     YYYY-MM-DD
+//
+// The fixed layouts, 2019-08-22T13:41:12Z, 2019-08-22T13:41:12.256Z, 2019-08-22T13:41:12+02:00 and
+// 2019-08-22T13:41:12.256+02:00, are validated and converted 8 chars at a time (SWAR), the other variants by a char
+// by char parser. A fraction is read up to 100 ns [ a tick ], further digits are ignored, a missing offset is UTC and a
+// leap second (60) rolls over into the next minute. Returns nothing if s_ is not a valid timestamp (or, for wintime_t,
+// before 1601).
+
+[[nodiscard]] std::optional<wintime_t> parse_wintime ( std::string_view const s_ ) noexcept;
+[[nodiscard]] std::optional<nixtime_t> parse_nixtime ( std::string_view const s_ ) noexcept; // Rounded down to the second.
+
+// Bulk parsing, out_ must be at least as large as in_, as ok_ if not empty, which receives whether each element parsed.
+// The invalid elements are not written to out_. Returns the number of invalid elements.
+std::size_t parse_wintime ( std::span<std::string_view const> in_, std::span<wintime_t> out_, std::span<bool> ok_ = { } ) noexcept;
+std::size_t parse_nixtime ( std::span<std::string_view const> in_, std::span<nixtime_t> out_, std::span<bool> ok_ = { } ) noexcept;
+
+// The two parsers on their own, such that they can be checked against each other: the SWAR one returns nothing for
+// anything but the fixed layouts, the char by char one parses all variants.
+[[nodiscard]] std::optional<wintime_t> parse_wintime_fast ( std::string_view const s_ ) noexcept;
+[[nodiscard]] std::optional<wintime_t> parse_wintime_slow ( std::string_view const s_ ) noexcept;
@@ -0,0 +1,76 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the \"Software\"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+
+#include <filesystem>
+#include <span>
+#include <string_view>
+
+namespace fs = std::filesystem;
+
+// A read-only memory mapping of a whole file (MapViewOfFile on windows, mmap elsewhere). A file that does not exist, is
+// empty or cannot be mapped gives an empty mapping.
+class mapped_file_t {
+
+    public:
+    mapped_file_t ( ) noexcept = default;
+    explicit mapped_file_t ( fs::path const & path_ ) noexcept;
+
+    mapped_file_t ( mapped_file_t const & ) = delete;
+    mapped_file_t ( mapped_file_t && other_ ) noexcept : m_data{ other_.m_data }, m_size{ other_.m_size } {
+        other_.m_data = nullptr;
+        other_.m_size = 0u;
+    }
+
+    ~mapped_file_t ( ) noexcept { close ( ); }
+
+    mapped_file_t & operator= ( mapped_file_t const & ) = delete;
+    mapped_file_t & operator= ( mapped_file_t && other_ ) noexcept {
+        if ( this != &other_ ) {
+            close ( );
+            m_data        = other_.m_data;
+            m_size        = other_.m_size;
+            other_.m_data = nullptr;
+            other_.m_size = 0u;
+        }
+        return *this;
+    }
+
+    [[nodiscard]] bool is_open ( ) const noexcept { return m_data; }
+    [[nodiscard]] char const * data ( ) const noexcept { return m_data; }
+    [[nodiscard]] std::size_t size ( ) const noexcept { return m_size; }
+
+    [[nodiscard]] std::string_view view ( ) const noexcept { return { m_data, m_size }; }
+    [[nodiscard]] std::span<std::byte const> bytes ( ) const noexcept {
+        return { reinterpret_cast<std::byte const *> ( m_data ), m_size };
+    }
+
+    void close ( ) noexcept;
+
+    private:
+    char const * m_data = nullptr;
+    std::size_t m_size  = 0u;
+};
@@ -0,0 +1,107 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the \"Software\"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <numeric>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// Minimal perfect hashing of a fixed set of strings [ hash and displace, after Belazzougui, Botelho and Dietzfelbinger ].
+// A key is first hashed (seed 0) to a bucket, the displacement [ seed ] stored for that bucket then hashes it to its slot
+// in [ 0, n ). Lookup is two hashes, one read of the (small) displacement table and one key compare.
+
+// Seeded FNV-1a, with the murmur3 finalizer, such that all bits are mixed.
+[[nodiscard]] constexpr std::uint32_t perfect_hash ( std::string_view const key_, std::uint32_t const seed_ ) noexcept {
+    std::uint32_t h = 2'166'136'261u ^ ( seed_ * 0x9E37'79B9u );
+    for ( char const c : key_ ) {
+        h ^= static_cast<std::uint8_t> ( c );
+        h *= 16'777'619u;
+    }
+    h ^= h >> 16;
+    h *= 0x85EB'CA6Bu;
+    h ^= h >> 13;
+    h *= 0xC2B2'AE35u;
+    h ^= h >> 16;
+    return h;
+}
+
+// Maps h_ to [ 0, n_ ) [ Lemire ].
+[[nodiscard]] constexpr std::uint32_t perfect_hash_reduce ( std::uint32_t const h_, std::size_t const n_ ) noexcept {
+    return static_cast<std::uint32_t> ( ( static_cast<std::uint64_t> ( h_ ) * n_ ) >> 32 );
+}
+
+[[nodiscard]] constexpr std::size_t perfect_hash_buckets ( std::size_t const n_ ) noexcept { return ( n_ + 3u ) / 4u; }
+
+// Returns the slot [ 0, n ) of key_, valid iff key_ is one of the keys the displacements were built from.
+[[nodiscard]] constexpr std::uint32_t perfect_hash_slot ( std::string_view const key_, std::span<std::uint32_t const> displacements_,
+                                                          std::size_t const n_ ) noexcept {
+    std::uint32_t const bucket = perfect_hash_reduce ( perfect_hash ( key_, 0u ), displacements_.size ( ) );
+    return perfect_hash_reduce ( perfect_hash ( key_, displacements_[ bucket ] ), n_ );
+}
+
+// Returns the displacements for the (unique) keys_, ( perfect_hash_buckets ( keys_.size ( ) ) of them ).
+[[nodiscard]] inline std::vector<std::uint32_t> build_perfect_hash ( std::span<std::string_view const> keys_ ) {
+    std::size_t const n = keys_.size ( ), r = perfect_hash_buckets ( n );
+    std::vector<std::uint32_t> displacements ( r, 0u );
+    if ( not n )
+        return displacements;
+    std::vector<std::vector<std::uint32_t>> buckets ( r );
+    for ( std::uint32_t i = 0u; i < n; ++i )
+        buckets[ perfect_hash_reduce ( perfect_hash ( keys_[ i ], 0u ), r ) ].push_back ( i );
+    std::vector<std::uint32_t> order ( r );
+    std::iota ( std::begin ( order ), std::end ( order ), 0u );
+    std::stable_sort ( std::begin ( order ), std::end ( order ),
+                       [ &buckets ] ( auto const a_, auto const b_ ) { return buckets[ a_ ].size ( ) > buckets[ b_ ].size ( ); } );
+    std::vector<bool> taken ( n, false );
+    std::vector<std::uint32_t> slots;
+    for ( std::uint32_t const b : order ) {
+        auto const & bucket = buckets[ b ];
+        if ( bucket.empty ( ) )
+            break;
+        for ( std::uint32_t d = 1u;; ++d ) { // Find a displacement that places all keys of the bucket in free slots.
+            slots.clear ( );
+            bool fits = true;
+            for ( std::uint32_t const i : bucket ) {
+                std::uint32_t const s = perfect_hash_reduce ( perfect_hash ( keys_[ i ], d ), n );
+                if ( taken[ s ] or std::end ( slots ) != std::find ( std::begin ( slots ), std::end ( slots ), s ) ) {
+                    fits = false;
+                    break;
+                }
+                slots.push_back ( s );
+            }
+            if ( fits ) {
+                for ( std::uint32_t const s : slots )
+                    taken[ s ] = true;
+                displacements[ b ] = d;
+                break;
+            }
+        }
+    }
+    return displacements;
+}
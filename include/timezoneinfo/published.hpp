@@ -0,0 +1,176 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the \"Software\"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+// An immutable object published through an atomic pointer, replaced as a whole by a writer and reclaimed with hazard
+// pointers [ M. Michael, Hazard Pointers: Safe Memory Reclamation for Lock-Free Objects ]. A reader pins the current
+// object by announcing it in a hazard slot, which takes a compare and swap and a re-check of the pointer: readers never
+// block, nor wait for a writer. A reader that finds all slots taken (pins nest) appends a block of Slots more, lock free,
+// the slots only ever grow. A writer swaps in the new object and deletes the retired ones no slot announces, later writes
+// and collect ( ) retry the ones still pinned. The initial object is not owned, it is never deleted.
+template<typename T, std::size_t Slots = 128u>
+class published_t {
+
+    // A hazard pointer, a cache line each, pinning threads do not share lines.
+    struct alignas ( 64 ) slot_t {
+        std::atomic<T const *> object{ };
+    };
+
+    // The slots, the first block in place, the blocks appended to it live as long as this object.
+    struct block_t {
+        slot_t slots[ Slots ];
+        std::atomic<block_t *> next{ };
+    };
+
+    public:
+    // A pinned object, valid as long as the pin lives, however many objects are published meanwhile. For short scopes,
+    // a live pin occupies a slot, more than Slots live pins grow the slots.
+    class pin_t {
+
+        friend class published_t;
+
+        slot_t * m_slot     = nullptr;
+        T const * m_object = nullptr;
+
+        pin_t ( slot_t * slot_, T const * object_ ) noexcept : m_slot{ slot_ }, m_object{ object_ } {}
+
+        public:
+        pin_t ( pin_t && other_ ) noexcept :
+            m_slot{ std::exchange ( other_.m_slot, nullptr ) }, m_object{ std::exchange ( other_.m_object, nullptr ) } {}
+        pin_t & operator= ( pin_t && ) = delete;
+
+        ~pin_t ( ) noexcept {
+            if ( m_slot )
+                m_slot->object.store ( nullptr, std::memory_order_release );
+        }
+
+        [[nodiscard]] T const & operator* ( ) const noexcept { return *m_object; }
+        [[nodiscard]] T const * operator-> ( ) const noexcept { return m_object; }
+        [[nodiscard]] T const * get ( ) const noexcept { return m_object; }
+    };
+
+    explicit constexpr published_t ( T const * initial_ ) noexcept : m_initial{ initial_ }, m_current{ initial_ } {}
+
+    published_t ( published_t const & ) = delete;
+    published_t & operator= ( published_t const & ) = delete;
+
+    ~published_t ( ) noexcept {
+        for ( T const * const object : m_retired )
+            delete object;
+        if ( T const * const object = m_current.load ( std::memory_order_relaxed ); object != m_initial )
+            delete object;
+        for ( block_t * block = m_head.next.load ( std::memory_order_relaxed ); block; )
+            delete std::exchange ( block, block->next.load ( std::memory_order_relaxed ) );
+    }
+
+    // Returns the current object, pinned.
+    [[nodiscard]] pin_t pin ( ) const noexcept {
+        T const * object    = m_current.load ( std::memory_order_acquire );
+        slot_t * const slot = claim ( object );
+        // Announced, the object can only have been retired before the announcement, in which case it is not current.
+        for ( T const * current; object != ( current = m_current.load ( std::memory_order_seq_cst ) ); object = current )
+            slot->object.store ( current, std::memory_order_seq_cst );
+        return { slot, object };
+    }
+
+    // Publishes object_, the object it replaces is deleted once no longer pinned.
+    void publish ( std::unique_ptr<T const> object_ ) {
+        std::scoped_lock const lock ( m_mutex );
+        T const * const retired = m_current.exchange ( object_.release ( ), std::memory_order_seq_cst );
+        if ( retired != m_initial )
+            m_retired.push_back ( retired );
+        reclaim ( );
+    }
+
+    // Deletes the retired objects that are no longer pinned, returns true if none are left.
+    bool collect ( ) {
+        std::scoped_lock const lock ( m_mutex );
+        reclaim ( );
+        return m_retired.empty ( );
+    }
+
+    private:
+    // Returns a free slot, announcing object_ in it. A thread starts its search where it found a slot the last time. If
+    // all are taken, the search goes on in the next block, appended if there is none (if out of memory, it starts over).
+    [[nodiscard]] slot_t * claim ( T const * const object_ ) const noexcept {
+        thread_local std::size_t home = 0u;
+        for ( block_t * block = &m_head;; ) {
+            for ( std::size_t n = 0u, i = home; n < Slots; ++n, i = ( i + 1u ) % Slots ) {
+                T const * free = nullptr;
+                if ( not block->slots[ i ].object.load ( std::memory_order_relaxed ) and
+                     block->slots[ i ].object.compare_exchange_strong ( free, object_, std::memory_order_seq_cst ) ) {
+                    home = i;
+                    return block->slots + i;
+                }
+            }
+            block_t * next = block->next.load ( std::memory_order_seq_cst );
+            if ( not next ) {
+                block_t * const grown = new ( std::nothrow ) block_t;
+                if ( not grown ) {
+                    block = &m_head;
+                    continue;
+                }
+                // Appended before the slot is announced, a writer that misses the announcement finds the block.
+                if ( block->next.compare_exchange_strong ( next, grown, std::memory_order_seq_cst ) )
+                    next = grown;
+                else
+                    delete grown;
+            }
+            block = next;
+        }
+    }
+
+    // Deletes the retired objects not announced in any slot.
+    void reclaim ( ) noexcept {
+        auto const pinned = [ this ] ( T const * const object_ ) noexcept {
+            for ( block_t const * block = &m_head; block; block = block->next.load ( std::memory_order_seq_cst ) )
+                if ( std::any_of ( std::begin ( block->slots ), std::end ( block->slots ), [ object_ ] ( slot_t const & slot_ ) {
+                         return object_ == slot_.object.load ( std::memory_order_seq_cst );
+                     } ) )
+                    return true;
+            return false;
+        };
+        auto const end = std::partition ( std::begin ( m_retired ), std::end ( m_retired ), pinned );
+        for ( auto it = end; it != std::end ( m_retired ); ++it )
+            delete *it;
+        m_retired.erase ( end, std::end ( m_retired ) );
+    }
+
+    T const * const m_initial;
+    std::atomic<T const *> m_current;
+    mutable block_t m_head;
+    std::mutex m_mutex; // Serializes the writers.
+    std::vector<T const *> m_retired;
+};
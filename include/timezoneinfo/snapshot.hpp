@@ -0,0 +1,104 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the \"Software\"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "calendar.hpp"
+#include "ianamap.hpp"
+#include "mapped_file.hpp"
+#include "zone.hpp"
+
+#include <cstdint>
+
+#include <filesystem>
+#include <functional>
+#include <span>
+#include <string_view>
+#include <utility>
+
+namespace fs = std::filesystem;
+
+// A binary snapshot of the resolved zone database (zones.bin): the IanaMap and, for each of the windows time zones it
+// maps to, the tzi_t (as read from the registry) and the zone_rule_t compiled from it. The file is memory mapped and
+// used in place, without parsing. It is versioned, checksummed (crc32) and records the source it was built from and the
+// time that source was downloaded, such that a newer download invalidates it.
+//
+// Layout, each section 8 byte aligned: header, entries, displacements, slots, zones (per entry, the index of its
+// windows time zone), tzis, rules, arena.
+
+struct snapshot_header_t {
+    char magic[ 8 ];
+    std::uint32_t version, checksum; // The checksum is the crc32 of all that follows the header.
+    std::uint64_t source_time;       // The wintime the source was downloaded at.
+    std::uint32_t source;            // The source, see snapshot_source_t.
+    std::uint32_t entry_count, displacement_count, zone_count, arena_size;
+    std::uint16_t entry_size, tzi_size, rule_size, padding; // The layout of the structures, as built.
+    std::uint32_t tzi_version;                               // The version of the rules the tzis were read from.
+};
+
+enum class snapshot_source_t : std::uint32_t { windowszones = 1u, windowszones_alt = 2u };
+
+class snapshot_t {
+
+    public:
+    static constexpr std::uint32_t version = 2u;
+
+    snapshot_t ( ) noexcept = default;
+    // Maps and validates the snapshot at path_, is_open ( ) is false if it does not exist or is not valid: every count,
+    // offset and index is checked against the mapped size before it is used.
+    explicit snapshot_t ( fs::path const & path_ ) noexcept;
+
+    snapshot_t ( snapshot_t && other_ ) noexcept { *this = std::move ( other_ ); }
+    snapshot_t & operator= ( snapshot_t && other_ ) noexcept;
+
+    [[nodiscard]] bool is_open ( ) const noexcept { return m_header; }
+    [[nodiscard]] snapshot_source_t source ( ) const noexcept { return static_cast<snapshot_source_t> ( m_header->source ); }
+    [[nodiscard]] std::uint64_t source_time ( ) const noexcept { return m_header->source_time; }
+    [[nodiscard]] std::uint32_t tzi_version ( ) const noexcept { return m_header->tzi_version; }
+
+    // A view of the mapped file, valid as long as the snapshot.
+    [[nodiscard]] IanaMap const & map ( ) const noexcept { return m_map; }
+    [[nodiscard]] std::span<std::uint16_t const> zones ( ) const noexcept { return m_zones; }
+    [[nodiscard]] std::span<tzi_t const> tzis ( ) const noexcept { return m_tzis; }
+    [[nodiscard]] std::span<zone_rule_t const> rules ( ) const noexcept { return m_rules; }
+
+    // Returns the tzi_t of IANA name iana_, nullptr if absent.
+    [[nodiscard]] tzi_t const * find_tzi ( std::string_view const iana_ ) const noexcept {
+        std::size_t const i = m_map.index ( iana_ );
+        return i == m_map.size ( ) ? nullptr : m_tzis.data ( ) + m_zones[ i ];
+    }
+
+    private:
+    mapped_file_t m_file;
+    snapshot_header_t const * m_header = nullptr;
+    IanaMap m_map;
+    std::span<std::uint16_t const> m_zones;
+    std::span<tzi_t const> m_tzis;
+    std::span<zone_rule_t const> m_rules;
+};
+
+// Writes the snapshot of map_ to path_, the tzi_t of each of its windows time zones is obtained from tzi_ ( name ), once
+// per name, tzi_version_ is the version of the rules tzi_ reads from. The file is written under a temporary name and then
+// renamed, readers never see a partial snapshot. Returns false on failure.
+bool write_snapshot ( fs::path const & path_, IanaMap const & map_, std::function<tzi_t ( std::string_view )> const & tzi_,
+                      snapshot_source_t const source_, std::uint64_t const source_time_, std::uint32_t const tzi_version_ );
@@ -0,0 +1,133 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the \"Software\"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "calendar.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <string_view>
+
+#include <fmt/format.h>
+
+// The format of print_systime, Thu Aug 22 13:41:12.256 2019.
+inline constexpr std::string_view systime_pattern = "%a %b %e %T.%f %Y";
+
+// A strftime-like pattern, compiled once into a program of field and literal ops, that formats a systime_t into a caller
+// buffer without allocating. The program lives in the object. The numeric fields are written 2 digits at a time from a
+// lookup table.
+//
+//     %Y year            %y year % 100    %m month       %d day         %e day, space padded    %j day of the year
+//     %H hour            %I hour [ 1, 12 ] %p AM or PM   %M minute      %S second               %f milliseconds
+//     %a Sun, Mon, ..    %A Sunday, ..    %b Jan, ..     %B January, .. %w day of the week, 0 == Sunday
+//     %u day of the week, 7 == Sunday     %F %Y-%m-%d    %T %H:%M:%S    %R %H:%M                %n %t %%
+//
+// Anything else is copied as is.
+class time_format_t {
+
+    public:
+    static constexpr std::size_t max_ops = 32u, max_text = 64u;
+    static constexpr std::size_t max_output = max_text + 9u * max_ops; // The largest max_size ( ).
+
+    // The offsets in the output of the second, respectively millisecond, fields, in order, as many as the pattern has.
+    struct positions_t {
+        std::uint16_t second[ max_ops ], millis[ max_ops ];
+        std::uint8_t second_count = 0u, millis_count = 0u;
+    };
+
+    // Throws std::invalid_argument if pattern_ compiles to more than max_ops ops or max_text literal chars.
+    explicit time_format_t ( std::string_view const pattern_ );
+
+    // The most chars format_to writes.
+    [[nodiscard]] std::size_t max_size ( ) const noexcept { return m_max_size; }
+
+    // Writes the formatted systime_ to out_, which must hold max_size ( ) chars, returns the end of the output (which is
+    // not null-terminated).
+    char * format_to ( char * out_, systime_t const & systime_ ) const noexcept;
+    // As the above, and stores where the second and millisecond fields went.
+    char * format_to ( char * out_, systime_t const & systime_, positions_t & positions_ ) const noexcept;
+    // Appends the formatted systime_ to buffer_, which allocates only if its (inline) capacity is exceeded.
+    void format_to ( fmt::memory_buffer & buffer_, systime_t const & systime_ ) const;
+
+    private:
+    enum class op_t : std::uint8_t {
+        literal,
+        year,
+        year2,
+        month,
+        day,
+        day_space,
+        day_of_year,
+        hour,
+        hour12,
+        am_pm,
+        minute,
+        second,
+        millis,
+        weekday_abbr,
+        weekday_name,
+        month_abbr,
+        month_name,
+        weekday,
+        weekday_iso
+    };
+
+    struct instr_t {
+        op_t op;
+        std::uint8_t offset, size; // Of the literal text.
+    };
+
+    template<bool Track>
+    char * run ( char * out_, systime_t const & systime_, positions_t & positions_ ) const noexcept;
+
+    void append ( op_t const op_ );
+    void append ( std::string_view const text_ );
+
+    instr_t m_program[ max_ops ];
+    char m_text[ max_text ];
+    std::uint8_t m_ops = 0u, m_text_size = 0u;
+    std::uint16_t m_max_size = 0u;
+};
+
+// A time_format_t that keeps the text of the instant it formatted last, and for an instant in the same minute rewrites
+// just the second and millisecond digits, a full format is done only when the minute changes. Most consecutive log stamps
+// are in the same minute. An object is not shared, keep one per thread (thread_local) to stamp from many threads.
+class cached_time_format_t {
+
+    public:
+    explicit cached_time_format_t ( std::string_view const pattern_ = systime_pattern ) : m_format{ pattern_ } {}
+
+    // Returns the text of wintime_, which stays valid up to the next call.
+    [[nodiscard]] std::string_view format ( wintime_t const wintime_ ) noexcept;
+    [[nodiscard]] std::string_view format ( nixtime_t const nixtime_ ) noexcept { return format ( nixtime_to_wintime ( nixtime_ ) ); }
+
+    private:
+    time_format_t m_format;
+    std::int64_t m_minute = -1; // Of the instant of m_text, since 1601, -1 == none.
+    time_format_t::positions_t m_positions;
+    std::size_t m_size = 0u;
+    char m_text[ time_format_t::max_output ];
+};
+
@@ -24,7 +24,16 @@
 #pragma once
 
 #include "calendar.hpp"
+#include "clock.hpp"
+#include "fetcher.hpp"
 #include "ianamap.hpp"
+#include "published.hpp"
+#include "snapshot.hpp"
+#include "time_format.hpp"
+#include "tzif.hpp"
+#include "zone.hpp"
+#include "zone_cache.hpp"
+#include "zoned_time.hpp"
 
 #ifndef FMT_USE_GRISU
 #    define FMT_USE_GRISU 1
@@ -37,38 +46,100 @@
 
 #include <nlohmann/json.hpp>
 
+#include <functional>
+#include <map>
+#include <stop_token>
+#include <string>
+#include <string_view>
+
 // for convenience.
 using json = nlohmann::json;
 
+// Refresh the zone data from windowsZones.xml, respectively Mapping.csv.gz, in the background and return at once, startup
+// never waits on the network. The snapshot (zones.bin) is published right away if it is of the last download, a worker
+// thread downloads the file if it is missing or was last checked over 30 days ago (a conditional request, a cheap 304 if
+// it did not change), builds the map as it arrives, writes the snapshot and publishes them. On a cold start, neither file
+// there, it fetches both at once, the other serves if the one asked for fails. Until then readers see the data there
+// was, the table generated at compile time at first. The worker stays around and checks daily whether the download of
+// the source last asked for is due.
 int init ( );
 int init_alt ( );
 
+// Blocks until the background refresh has nothing left to do, for tests and tools, readers need not wait.
+void await_refresh ( );
+
+// The URL source_ is downloaded from, replaceable, f.e. by a file:// URL of a local copy, before init ( ).
+[[nodiscard]] std::string source_url ( snapshot_source_t const source_ );
+void set_source_url ( snapshot_source_t const source_, std::string url_ );
+
 [[nodiscard]] fs::path get_app_data_path ( std::wstring && place_ ) noexcept;
 WinTzSet fill_timezones_db ( ) noexcept;
 
-inline fs::path const & g_app_data_path         = get_app_data_path ( L"timezoneinfo" );
-inline fs::path const & g_windowszones_path     = g_app_data_path / L"windowszones.xml";
-inline fs::path const & g_windowszones_alt_path = g_app_data_path / L"windowszones_alt.csv.gz";
-
-using tzi_t = TIME_ZONE_INFORMATION;
+// The application data directory (created on first use) and the files in it, constructed on first use.
+[[nodiscard]] fs::path const & app_data_path ( );
+[[nodiscard]] fs::path const & windowszones_path ( );
+[[nodiscard]] fs::path const & windowszones_alt_path ( );
+[[nodiscard]] fs::path const & timestamps_path ( );
+[[nodiscard]] fs::path const & snapshot_path ( );
 
 using Timestamps = std::map<std::string, std::uint64_t>;
-
-inline Timestamps g_timestamps;
-inline fs::path const & g_timestamps_path = g_app_data_path / L"timestamps.json";
-
-inline IanaMap g_iana = build_iana_to_windowszones_alt_map ( );
-
-[[nodiscard]] tzi_t get_tzi ( std::string const & desc_ ) noexcept;
+using ETags      = std::map<std::string, std::string>;
+
+// The download timestamps, loaded from timestamps.json on first use. Copies, the background refresh changes them, under a
+// lock that these and save_timestamps ( ) and load_timestamps ( ) take as well.
+[[nodiscard]] Timestamps timestamps ( );
+// The entity tags of the downloads, kept in timestamps.json as well (as strings, where the timestamps are numbers).
+[[nodiscard]] ETags etags ( );
+// Sets timestamp key_ to value_, saved with the next save_timestamps ( ).
+void set_timestamp ( std::string const & key_, std::uint64_t const value_ );
+
+// The zone data: the IANA -> windows time zone map and the snapshot (if any) it views. Immutable once published, a
+// refresh publishes new data as a whole.
+struct zone_data_t {
+    snapshot_t snapshot;
+    IanaMap map;
+};
+
+using zone_data_pin_t = published_t<zone_data_t>::pin_t;
+
+// Returns the current zone data, pinned for as long as the pin lives: a refresh does not reclaim pinned data. No locks,
+// at first a view of the table generated from windowsZones.xml, initialized at compile time. Hold on to the pin while
+// using the map (f.e. for a range-for over it), the views it hands out are of the pinned data.
+[[nodiscard]] zone_data_pin_t zone_data ( ) noexcept;
+
+// Constructs the above now, for callers that want to pay up front instead of at first use.
+void preload ( );
+
+// The rules come from the registry on windows, from the TZif files under zoneinfo_root ( ) elsewhere, of which the tzi
+// holds the rule that applies beyond the table.
+[[nodiscard]] tzi_t get_tzi ( std::string_view const iana_ ) noexcept;
+// Returns the tzi of windows time zone name_, as read from the registry, elsewhere that of its (001 territory) IANA zone.
+[[nodiscard]] tzi_t get_windows_tzi ( std::string_view const name_ ) noexcept;
+// Returns the per-year ("Dynamic DST") rules of windows time zone name_, [ FirstEntry, LastEntry ], none if it has none
+// (or outside windows, where the TZif files hold the history).
+[[nodiscard]] dynamic_rules_t get_windows_dynamic_rules ( std::string_view const name_ ) noexcept;
 [[nodiscard]] tzi_t const & get_tzi_utc ( ) noexcept;
+// Returns the version of the rules the above read, the TzVersion of the registry on windows, elsewhere a hash of the version
+// line of tzdata.zi under zoneinfo_root ( ), 0 if unknown. A snapshot of the tzis of another version is stale.
+[[nodiscard]] std::uint32_t get_tzi_version ( ) noexcept;
 
 [[nodiscard]] bool has_dst ( tzi_t const & tzi ) noexcept;
 
-/*
+// Returns the zone of IANA name iana_, nullptr if unknown. Zones are compiled on first use into a process wide cache and
+// live as long as the process, a cached zone is found without locking (and without touching the file system). Outside
+// windows a zone is the full history of its TZif file.
+[[nodiscard]] zone_t const * get_zone ( std::string_view const iana_ );
+
+// Returns the interned id of IANA name iana_, the zone compiled and cached as by get_zone, an invalid id if unknown.
+[[nodiscard]] zone_id_t lookup ( std::string_view const iana_ );
+// The zone and IANA name of a valid id, an array index.
+[[nodiscard]] zone_t const & get_zone ( zone_id_t const id_ ) noexcept;
+[[nodiscard]] std::string_view get_name ( zone_id_t const id_ ) noexcept;
+
+// Return time-zone specific local time, thin wrappers over a zone_t compiled (once per thread) from tzi_.
 [[nodiscard]] systime_t get_systime_in_tz ( tzi_t const & tzi_, systime_t const & system_time_ ) noexcept;
 [[nodiscard]] wintime_t get_wintime_in_tz ( tzi_t const & tzi_, wintime_t const & wintime_ ) noexcept;
 [[nodiscard]] nixtime_t get_nixtime_in_tz ( tzi_t const & tzi_, nixtime_t const & nixtime_ ) noexcept;
-*/
 
 // Return time-zone specific current local systime.
 [[nodiscard]] systime_t get_systime_in_tz ( tzi_t const & tzi_ ) noexcept;
@@ -77,10 +148,23 @@ inline IanaMap g_iana = build_iana_to_windowszones_alt_map ( );
 // Return time-zone specific current local nixtime.
 [[nodiscard]] nixtime_t get_nixtime_in_tz ( tzi_t const & tzi_ ) noexcept;
 
+// As the above, of the zone of a valid id.
+[[nodiscard]] systime_t get_systime_in_tz ( zone_id_t const id_, systime_t const & system_time_ ) noexcept;
+[[nodiscard]] wintime_t get_wintime_in_tz ( zone_id_t const id_, wintime_t const & wintime_ ) noexcept;
+[[nodiscard]] nixtime_t get_nixtime_in_tz ( zone_id_t const id_, nixtime_t const & nixtime_ ) noexcept;
+[[nodiscard]] systime_t get_systime_in_tz ( zone_id_t const id_ ) noexcept;
+[[nodiscard]] wintime_t get_wintime_in_tz ( zone_id_t const id_ ) noexcept;
+[[nodiscard]] nixtime_t get_nixtime_in_tz ( zone_id_t const id_ ) noexcept;
+
 [[nodiscard]] systime_t get_systime_in_tz ( systime_t const & system_time_ ) noexcept;
 [[nodiscard]] wintime_t get_wintime_in_tz ( wintime_t const & wintime_ ) noexcept;
 [[nodiscard]] nixtime_t get_nixtime_in_tz ( nixtime_t const & nixtime_ ) noexcept;
 
+// Return the current local day in the zone of a valid id, respectively of tzi_, cached until the next local midnight or
+// transition (per zone, respectively per thread), the current local systime above is derived from it.
+[[nodiscard]] local_day_t today_in_tz ( zone_id_t const id_ ) noexcept;
+[[nodiscard]] local_day_t today_in_tz ( tzi_t const & tzi_ ) noexcept;
+
 // Return system time from date in UTC.
 [[nodiscard]] systime_t date_to_systime ( int const y_, int const m_, int const d_ ) noexcept;
 // Return windows time from date in UTC.
@@ -105,9 +189,10 @@ void print_wintime ( wintime_t const & rawtime_ ) noexcept;
 template<typename Stream>
 void print_systime ( Stream & os_, systime_t const & system_time_ ) noexcept {
     // Thu Aug 22 13:41:12.256 2019
-    os_ << fmt::format ( "{} {} {:2} {:02}:{:02}:{:02}.{:03} {}", dow[ system_time_.wDayOfWeek ], moy[ system_time_.wMonth - 1 ],
-                         system_time_.wDay, system_time_.wHour, system_time_.wMinute, system_time_.wSecond,
-                         system_time_.wMilliseconds, system_time_.wYear );
+    static time_format_t const format{ systime_pattern };
+    char buffer[ 32 ];
+    assert ( format.max_size ( ) <= sizeof ( buffer ) );
+    os_ << std::string_view{ buffer, static_cast<std::size_t> ( format.format_to ( buffer, system_time_ ) - buffer ) };
 }
 
 template<typename Stream>
@@ -128,3 +213,10 @@ template<typename Stream>
 }
 
 void download ( char const url_[], fs::path const & path_ );
+
+// Downloads url_ to path_, unless it did not change since validators_, a fetch ( ) of one, once, without a time limit. The
+// body is passed to sink_ as it arrives, it replaces the file at path_ only if verify_ (if any) accepts it, if not, the
+// download has failed and the file there was stays. On changed, validators_ are those of the new file.
+[[nodiscard]] download_status_t download ( char const url_[], fs::path const & path_, download_validators_t & validators_,
+                                           std::function<void ( std::string_view )> const & sink_,
+                                           std::function<bool ( )> const & verify_ = { }, std::stop_token const & stop_ = { } );
@@ -0,0 +1,67 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the \"Software\"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "zone.hpp"
+
+#include <cstddef>
+
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace fs = std::filesystem;
+
+// The zone rule provider of the IANA tz database as installed, TZif files [ RFC 8536 ] under a zoneinfo root, like
+// /usr/share/zoneinfo. A file is parsed into the transition table of a zone_t, the POSIX TZ string of the (v2+) footer
+// into the zone_rule_t that applies beyond the table.
+
+// A POSIX TZ string, "std offset [ dst [ offset ] [ , start [ / time ] , end [ / time ] ] ]", as a zone_rule_t. The
+// dates are Mm.w.d, Jn or n, the latter two are days of the year (see zone_rule_t::date_t::day).
+struct posix_tz_t {
+    std::string_view std_name, dst_name; // The abbreviations, views of the parsed string.
+    zone_rule_t rule;
+};
+
+[[nodiscard]] std::optional<posix_tz_t> parse_posix_tz ( std::string_view tz_ ) noexcept;
+
+struct tzif_t {
+    zone_t zone;
+    std::string std_name, dst_name; // The abbreviations of the footer, if any.
+};
+
+// Parses a TZif file, version 1, 2 or 3, of the latter two the 64-bit data and the footer. Transitions before 1601 are
+// folded into the initial offset, leap seconds are ignored. Returns nothing if the data is not valid TZif.
+[[nodiscard]] std::optional<tzif_t> parse_tzif ( std::span<std::byte const> data_ );
+
+// The zoneinfo root, $TZDIR if set, /usr/share/zoneinfo otherwise, unless set. It is fixed by whichever comes first, the
+// first call of either: set it before the first zone is loaded. Returns false (and changes nothing) if it was fixed already.
+[[nodiscard]] fs::path const & zoneinfo_root ( );
+bool set_zoneinfo_root ( fs::path root_ );
+
+// Maps and parses the TZif file of IANA name iana_ under the zoneinfo root. Returns nothing if there is no such (valid)
+// file, or iana_ is not a relative name within the root.
+[[nodiscard]] std::optional<tzif_t> load_tzif ( std::string_view const iana_ );
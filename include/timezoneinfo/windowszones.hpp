@@ -0,0 +1,110 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the \"Software\"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+
+#include <string_view>
+
+// A single pass scanner of windowsZones.xml, specialized for the shape of the document, the <mapZone other="" territory=""
+// type=""/> elements. No DOM, the results are views of the scanned buffer (mapped file).
+
+struct map_zone_t {
+    std::string_view other, territory, type; // Windows name, territory code, space separated IANA names.
+};
+
+// Calls f_ ( name, value ) for each of the attributes of element_, the text of a start tag, up to the first malformed one.
+// The attributes are separated by any XML whitespace, which may also surround the =.
+template<typename Function>
+constexpr void for_each_xml_attribute ( std::string_view element_, Function && f_ ) {
+    constexpr std::string_view space = " \t\r\n";
+    for ( std::size_t n = element_.find_first_of ( space ); std::string_view::npos != n; ) {
+        n = element_.find_first_not_of ( space, n );
+        if ( std::string_view::npos == n or '/' == element_[ n ] or '>' == element_[ n ] )
+            return;
+        element_.remove_prefix ( n );
+        std::size_t const e = element_.find ( '=' );
+        if ( std::string_view::npos == e )
+            return;
+        std::size_t const v = element_.find_first_not_of ( space, e + 1u );
+        if ( std::string_view::npos == v or '"' != element_[ v ] )
+            return;
+        std::size_t const q = element_.find ( '"', v + 1u );
+        if ( std::string_view::npos == q )
+            return;
+        std::string_view const name = element_.substr ( 0u, e );
+        f_ ( name.substr ( 0u, name.find_last_not_of ( space ) + 1u ), element_.substr ( v + 1u, q - v - 1u ) );
+        element_.remove_prefix ( q + 1u );
+        n = 0u;
+    }
+}
+
+// Returns the value of attribute name_ of element_, empty if absent.
+[[nodiscard]] constexpr std::string_view xml_attribute ( std::string_view const element_, std::string_view const name_ ) {
+    std::string_view value;
+    for_each_xml_attribute ( element_, [ &value, name_ ] ( std::string_view const n_, std::string_view const v_ ) {
+        if ( name_ == n_ )
+            value = v_;
+    } );
+    return value;
+}
+
+// Calls f_ ( map_zone_t const & ) for each complete mapZone element in buf_. Returns the offset up to which buf_ is
+// consumed, the scan resumes from there once more of the document has been read.
+template<typename Function>
+constexpr std::size_t scan_map_zones ( std::string_view const buf_, Function && f_ ) {
+    constexpr std::string_view tag = "<mapZone";
+    std::size_t consumed = 0u;
+    for ( std::size_t i = buf_.find ( tag ); std::string_view::npos != i; i = buf_.find ( tag, consumed ) ) {
+        std::size_t const e = buf_.find ( '>', i + tag.size ( ) );
+        if ( std::string_view::npos == e )
+            return i; // Incomplete element.
+        map_zone_t zone;
+        for_each_xml_attribute ( buf_.substr ( i, e - i ), [ &zone ] ( std::string_view const n_, std::string_view const v_ ) {
+            if ( "other" == n_ )
+                zone.other = v_;
+            else if ( "territory" == n_ )
+                zone.territory = v_;
+            else if ( "type" == n_ )
+                zone.type = v_;
+        } );
+        f_ ( zone );
+        consumed = e + 1u;
+    }
+    // Keep a tag that might be cut off at the end.
+    return buf_.size ( ) < consumed + tag.size ( ) ? consumed : buf_.size ( ) - tag.size ( ) + 1u;
+}
+
+// Calls f_ ( name ) for each of the space separated IANA names of the type attribute type_.
+template<typename Function>
+constexpr void for_each_iana_name ( std::string_view type_, Function && f_ ) {
+    for ( std::size_t b = type_.find_first_not_of ( ' ' ); std::string_view::npos != b; b = type_.find_first_not_of ( ' ' ) ) {
+        type_.remove_prefix ( b );
+        std::size_t const e = type_.find ( ' ' );
+        f_ ( type_.substr ( 0u, e ) );
+        if ( std::string_view::npos == e )
+            break;
+        type_.remove_prefix ( e );
+    }
+}
@@ -0,0 +1,217 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the \"Software\"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "calendar.hpp"
+
+#include <cstdint>
+
+#include <algorithm>
+#include <optional>
+#include <vector>
+
+// The UTC interval [ begin, end ) [ 100 ns ticks since 1601 ] over which offset [ ticks ] applies.
+struct period_t {
+    std::int64_t begin, end, offset;
+};
+
+// A yearly recurring rule, the information a tzi_t holds: a standard offset and, optionally, a daylight offset and the
+// (local) dates of the transitions into and out of daylight time.
+struct zone_rule_t {
+
+    struct date_t {
+        int month         = 0; // [ 1, 12 ], 0 == no transition.
+        int week          = 0; // The week-th [ 1, 5 ] day_of_week in the month, 5 == the last one.
+        int day_of_week   = 0; // 0 == Sunday.
+        std::int32_t time = 0; // Seconds after local midnight.
+        // If not 0, the day of the year instead, as POSIX TZ strings have them: day [ 1, 366 ] counts February 29 (n + 1),
+        // -day [ 1, 365 ] does not, it falls on the same date every year (Jn). The month, week and day_of_week then are
+        // those of the date in a common year starting on a Monday, a tzi_t can hold those only.
+        int day = 0;
+
+        [[nodiscard]] friend bool operator== ( date_t const &, date_t const & ) noexcept = default;
+    };
+
+    std::int32_t std_offset = 0, dst_offset = 0; // Seconds, local time = UTC + offset.
+    date_t dst_start, dst_end;                   // In local standard, respectively local daylight time.
+
+    [[nodiscard]] bool has_dst ( ) const noexcept { return dst_start.month; }
+
+    // Returns the UTC instants [ in 100 ns ticks since 1601 ] at which daylight time starts and ends in year y_.
+    [[nodiscard]] std::int64_t dst_start_utc ( int const y_ ) const noexcept;
+    [[nodiscard]] std::int64_t dst_end_utc ( int const y_ ) const noexcept;
+    // Returns the offset in ticks at UTC instant utc_, computed from the rule.
+    [[nodiscard]] std::int64_t offset ( std::int64_t const utc_ ) const noexcept;
+    // Returns the period, bounded by the (UTC) year, containing UTC instant utc_, computed from the rule.
+    [[nodiscard]] period_t period ( std::int64_t const utc_ ) const noexcept;
+
+    [[nodiscard]] friend bool operator== ( zone_rule_t const &, zone_rule_t const & ) noexcept = default;
+};
+
+// Local time is ambiguous when daylight time ends, the clock is set back and a local time occurs twice, and nonexistent
+// when it starts, the clock is set forward and skips the local times in between.
+enum class local_kind_t : std::uint8_t { unique, ambiguous, nonexistent };
+
+// The UTC instant(s) [ ticks ] of a local time [ ticks ]. unique: earliest == latest, the local time is one of the
+// interval [ begin, end ) [ local ticks ] over which local time = UTC + offset; ambiguous: earliest < latest, the first and
+// the second occurrence; nonexistent: earliest == latest, the instant the local time shifted forward over the gap maps to.
+struct local_resolution_t {
+    std::int64_t earliest, latest;
+    std::int64_t begin, end, offset; // Valid if unique, begin == end (empty) otherwise.
+    local_kind_t kind;
+};
+
+// How to map an ambiguous, respectively a nonexistent, local time to UTC.
+enum class ambiguous_t : std::uint8_t { earliest, latest, reject };
+enum class nonexistent_t : std::uint8_t { shift_forward, reject };
+
+struct local_policy_t {
+    ambiguous_t ambiguous     = ambiguous_t::earliest;
+    nonexistent_t nonexistent = nonexistent_t::shift_forward;
+
+    // Returns the UTC instant of resolution_ under this policy, nothing if rejected.
+    [[nodiscard]] std::optional<std::int64_t> apply ( local_resolution_t const & resolution_ ) const noexcept {
+        switch ( resolution_.kind ) {
+            case local_kind_t::ambiguous:
+                if ( ambiguous_t::reject == ambiguous )
+                    return std::nullopt;
+                return ambiguous_t::earliest == ambiguous ? resolution_.earliest : resolution_.latest;
+            case local_kind_t::nonexistent:
+                if ( nonexistent_t::reject == nonexistent )
+                    return std::nullopt;
+                [[fallthrough]];
+            default: return resolution_.earliest;
+        }
+    }
+};
+
+// Per-year rules, rules[ y - first_year ] is the rule of year y, as the "Dynamic DST" registry entries of a windows time
+// zone hold them. The first rule also applies before, the last one also after, the years covered.
+struct dynamic_rules_t {
+    int first_year = 0;
+    std::vector<zone_rule_t> rules;
+};
+
+[[nodiscard]] zone_rule_t make_zone_rule ( tzi_t const & tzi_ ) noexcept;
+// The inverse, without the names. A transition time outside the day is clamped to it, a tzi_t cannot express it.
+[[nodiscard]] tzi_t make_tzi ( zone_rule_t const & rule_ ) noexcept;
+
+// A compiled time zone, a sorted table of UTC transition instants and the offsets that take effect at those instants,
+// built once for the years [ first_year_, last_year_ ]. Conversion is a binary search plus an integer add. Instants
+// outside the table are converted by evaluating the rule for the year in question. A zone with per-year rules keeps them
+// in a table indexed by year, the rule of a year is an array index.
+class zone_t {
+
+    public:
+    static constexpr int default_first_year = 1970, default_last_year = 2100;
+
+    zone_t ( ) noexcept = default; // UTC.
+    explicit zone_t ( tzi_t const & tzi_, int const first_year_ = default_first_year,
+                      int const last_year_ = default_last_year );
+    explicit zone_t ( zone_rule_t const & rule_, int const first_year_ = default_first_year,
+                      int const last_year_ = default_last_year );
+    // A zone of which the rule changes from year to year, the last of rules_ applies beyond them. rules_ is not empty.
+    explicit zone_t ( dynamic_rules_t rules_, int const first_year_ = default_first_year,
+                      int const last_year_ = default_last_year );
+    // A zone with a history, as read from a TZif file, offsets_[ i ] applies up to transitions_[ i ] [ UTC ticks, sorted ]
+    // and the last one from there. The table starts in 1601 and is extended with the transitions of rule_ up to and
+    // including last_year_, beyond which rule_ applies.
+    zone_t ( std::vector<std::int64_t> transitions_, std::vector<std::int64_t> offsets_, zone_rule_t const & rule_,
+             int const last_year_ = default_last_year );
+
+    // A zone without a table, which evaluates rule_ for every instant. It is slower, but building it allocates nothing.
+    [[nodiscard]] static zone_t from_rule ( zone_rule_t const & rule_ ) noexcept {
+        zone_t zone;
+        zone.m_rule = rule_;
+        return zone;
+    }
+
+    // Returns the offset in ticks [ 100 ns ] at UTC instant utc_ [ ticks since 1601 ], local time = UTC + offset.
+    [[nodiscard]] std::int64_t offset ( std::int64_t const utc_ ) const noexcept {
+        if ( utc_ < m_begin or utc_ >= m_end )
+            return rule_offset ( utc_ );
+        return m_offsets[ index ( utc_ ) ];
+    }
+    // Returns the period of constant offset containing UTC instant utc_.
+    [[nodiscard]] period_t period ( std::int64_t const utc_ ) const noexcept;
+    // Returns the UTC instant(s) of local time local_ [ ticks ], from the periods around it.
+    [[nodiscard]] local_resolution_t resolve_local ( std::int64_t const local_ ) const noexcept;
+
+    [[nodiscard]] wintime_t to_local ( wintime_t const wintime_ ) const noexcept {
+        wintime_t wt;
+        wt.as_uint64 ( ) = wintime_.as_uint64 ( ) + offset ( static_cast<std::int64_t> ( wintime_.as_uint64 ( ) ) );
+        return wt;
+    }
+    [[nodiscard]] nixtime_t to_local ( nixtime_t const nixtime_ ) const noexcept;
+    [[nodiscard]] systime_t to_local ( systime_t const & systime_ ) const noexcept;
+
+    // The rule that applies beyond the table, respectively the rule of year y_.
+    [[nodiscard]] zone_rule_t const & rule ( ) const noexcept { return m_rule; }
+    [[nodiscard]] zone_rule_t const & rule ( int const y_ ) const noexcept {
+        if ( m_rules.empty ( ) )
+            return m_rule;
+        return m_rules[ static_cast<std::size_t> ( std::clamp ( y_ - m_first_rule_year, 0, static_cast<int> ( m_rules.size ( ) ) - 1 ) ) ];
+    }
+    [[nodiscard]] std::vector<std::int64_t> const & transitions ( ) const noexcept { return m_transitions; }
+    [[nodiscard]] std::vector<std::int64_t> const & offsets ( ) const noexcept { return m_offsets; }
+
+    // Zones compiled alike.
+    [[nodiscard]] friend bool operator== ( zone_t const &, zone_t const & ) noexcept = default;
+
+    private:
+    void compile ( int const first_year_, int const last_year_ );
+
+    // The offset at, respectively the period containing, UTC instant utc_, from the rule of its year.
+    [[nodiscard]] std::int64_t rule_offset ( std::int64_t const utc_ ) const noexcept;
+    [[nodiscard]] period_t rule_period ( std::int64_t const utc_ ) const noexcept;
+
+    // Returns the number of transitions at or before utc_, a branch-light upper_bound.
+    [[nodiscard]] std::size_t index ( std::int64_t const utc_ ) const noexcept {
+        std::int64_t const * const first = m_transitions.data ( );
+        std::size_t lo = 0u, len = m_transitions.size ( );
+        while ( len ) {
+            std::size_t const half = len / 2u;
+            lo += ( first[ lo + half ] <= utc_ ) * ( len - half );
+            len = half;
+        }
+        return lo;
+    }
+
+    zone_rule_t m_rule;
+    std::int64_t m_begin = 0, m_end = 0;     // The table covers [ m_begin, m_end ).
+    std::vector<std::int64_t> m_transitions; // UTC ticks, sorted.
+    std::vector<std::int64_t> m_offsets;     // Ticks, m_offsets[ i ] applies up to m_transitions[ i ].
+    int m_first_rule_year = 0;
+    std::vector<zone_rule_t> m_rules; // The per-year rules, m_rules[ y - m_first_rule_year ] is the rule of year y.
+};
+
+[[nodiscard]] zone_t const & get_zone_utc ( ) noexcept;
+
+// Local time in zone_ to UTC, nothing if policy_ rejects the local time.
+[[nodiscard]] std::optional<wintime_t> local_to_utc ( zone_t const & zone_, wintime_t const local_,
+                                                      local_policy_t const policy_ = { } ) noexcept;
+[[nodiscard]] std::optional<nixtime_t> local_to_utc ( zone_t const & zone_, nixtime_t const local_,
+                                                      local_policy_t const policy_ = { } ) noexcept;
+[[nodiscard]] std::optional<systime_t> local_to_utc ( zone_t const & zone_, systime_t const & local_,
+                                                      local_policy_t const policy_ = { } ) noexcept;
@@ -0,0 +1,184 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the \"Software\"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "perfect_hash.hpp"
+#include "zone.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// An interned zone, the (dense) index of its entry in a zone_cache_t. Two bytes instead of a name, that convert to the
+// zone with an array index instead of a hash. Default constructed, an id is invalid.
+struct zone_id_t {
+    static constexpr std::uint16_t invalid = 0xFFFF;
+
+    std::uint16_t value = invalid;
+
+    [[nodiscard]] constexpr bool is_valid ( ) const noexcept { return invalid != value; }
+    [[nodiscard]] explicit constexpr operator bool ( ) const noexcept { return is_valid ( ); }
+
+    [[nodiscard]] friend constexpr bool operator== ( zone_id_t const a_, zone_id_t const b_ ) noexcept = default;
+    [[nodiscard]] friend constexpr auto operator<=> ( zone_id_t const a_, zone_id_t const b_ ) noexcept = default;
+};
+
+// A cache of compiled zones, keyed by (IANA) name. An open addressing table of pointers to entries, that are never
+// removed: a found zone stays valid for the lifetime of the cache. Lookup is lock-free (acquire loads only), a miss takes a
+// mutex, such that a zone is compiled at most once, however many threads miss on it at the same time. Entries are numbered
+// in the order they are cached, that number is the zone_id_t of the entry. When the data the zones are compiled from
+// changes, refresh recompiles them, each entry then points at its new zone, the zones it replaces stay valid.
+class zone_cache_t {
+
+    public:
+    static constexpr std::size_t capacity = 2'048u; // The number of slots, a power of 2, at most half of them are used.
+    static constexpr std::size_t max_size = capacity / 2u;
+
+    zone_cache_t ( ) noexcept = default;
+
+    zone_cache_t ( zone_cache_t const & ) = delete;
+    zone_cache_t & operator= ( zone_cache_t const & ) = delete;
+
+    // Returns the cached zone of key_, nullptr if not cached (yet).
+    [[nodiscard]] zone_t const * find ( std::string_view const key_ ) const noexcept {
+        entry_t const * const e = find_entry ( key_ );
+        return e ? e->zone.load ( std::memory_order_acquire ) : nullptr;
+    }
+    // Returns the id of key_, an invalid id if not cached (yet).
+    [[nodiscard]] zone_id_t find_id ( std::string_view const key_ ) const noexcept {
+        entry_t const * const e = find_entry ( key_ );
+        return e ? e->id : zone_id_t{ };
+    }
+
+    // Returns the zone of key_, on a miss compiled by make_ ( key_ ), returning a std::optional<zone_t>, and cached.
+    // Returns nullptr if make_ fails (which is not cached) or the cache is full.
+    template<typename Make>
+    [[nodiscard]] zone_t const * get ( std::string_view const key_, Make && make_ ) {
+        entry_t const * const e = get_entry ( key_, std::forward<Make> ( make_ ) );
+        return e ? e->zone.load ( std::memory_order_acquire ) : nullptr;
+    }
+    // As get, returns the id of the zone, an invalid id if make_ fails or the cache is full.
+    template<typename Make>
+    [[nodiscard]] zone_id_t intern ( std::string_view const key_, Make && make_ ) {
+        entry_t const * const e = get_entry ( key_, std::forward<Make> ( make_ ) );
+        return e ? e->id : zone_id_t{ };
+    }
+
+    // Recompiles the cached zones with make_, after the data they are compiled from changed. The ids stay. A zone that
+    // compiles the same, or that make_ fails on, is kept. Returns the number of zones replaced.
+    template<typename Make>
+    std::size_t refresh ( Make && make_ ) {
+        std::scoped_lock const lock ( m_mutex );
+        std::size_t replaced = 0u;
+        for ( std::unique_ptr<entry_t> const & e : m_entries ) {
+            std::optional<zone_t> zone = make_ ( std::string_view{ e->key } );
+            if ( not zone or *zone == *e->zone.load ( std::memory_order_relaxed ) )
+                continue;
+            e->zone.store ( m_zones.emplace_back ( std::make_unique<zone_t const> ( std::move ( *zone ) ) ).get ( ),
+                            std::memory_order_release );
+            ++replaced;
+        }
+        return replaced;
+    }
+
+    // The zone and the key of a valid id, as returned by this cache.
+    [[nodiscard]] zone_t const & operator[] ( zone_id_t const id_ ) const noexcept {
+        return *entry ( id_ ).zone.load ( std::memory_order_acquire );
+    }
+    [[nodiscard]] std::string_view key ( zone_id_t const id_ ) const noexcept { return entry ( id_ ).key; }
+
+    [[nodiscard]] std::size_t size ( ) const {
+        std::scoped_lock const lock ( m_mutex );
+        return m_entries.size ( );
+    }
+
+    private:
+    struct entry_t {
+        entry_t ( std::string_view const key_, zone_t const * const zone_, zone_id_t const id_ ) :
+            key{ key_ }, zone{ zone_ }, id{ id_ } {}
+
+        std::string const key;
+        std::atomic<zone_t const *> zone; // The current compilation.
+        zone_id_t const id;
+    };
+
+    [[nodiscard]] entry_t const * find_entry ( std::string_view const key_ ) const noexcept {
+        for ( std::size_t i = home ( key_ );; i = ( i + 1u ) & ( capacity - 1u ) ) {
+            entry_t const * const e = m_slots[ i ].load ( std::memory_order_acquire );
+            if ( not e )
+                return nullptr;
+            if ( e->key == key_ )
+                return e;
+        }
+    }
+
+    template<typename Make>
+    [[nodiscard]] entry_t const * get_entry ( std::string_view const key_, Make && make_ ) {
+        if ( entry_t const * const e = find_entry ( key_ ); e )
+            return e;
+        std::scoped_lock const lock ( m_mutex );
+        if ( entry_t const * const e = find_entry ( key_ ); e ) // Inserted while waiting for the lock.
+            return e;
+        if ( m_entries.size ( ) >= max_size )
+            return nullptr;
+        std::optional<zone_t> zone = make_ ( key_ );
+        if ( not zone )
+            return nullptr;
+        zone_id_t const id{ static_cast<std::uint16_t> ( m_entries.size ( ) ) };
+        zone_t const * const z  = m_zones.emplace_back ( std::make_unique<zone_t const> ( std::move ( *zone ) ) ).get ( );
+        entry_t const * const e = m_entries.emplace_back ( std::make_unique<entry_t> ( key_, z, id ) ).get ( );
+        m_ids[ id.value ].store ( e, std::memory_order_release );
+        std::size_t i = home ( key_ );
+        while ( m_slots[ i ].load ( std::memory_order_relaxed ) )
+            i = ( i + 1u ) & ( capacity - 1u );
+        m_slots[ i ].store ( e, std::memory_order_release ); // Publishes the entry.
+        return e;
+    }
+
+    [[nodiscard]] entry_t const & entry ( zone_id_t const id_ ) const noexcept {
+        assert ( id_.value < max_size );
+        entry_t const * const e = m_ids[ id_.value ].load ( std::memory_order_acquire );
+        assert ( e );
+        return *e;
+    }
+
+    [[nodiscard]] static std::size_t home ( std::string_view const key_ ) noexcept {
+        return perfect_hash ( key_, 0u ) & ( capacity - 1u );
+    }
+
+    std::atomic<entry_t const *> m_slots[ capacity ]{ };
+    std::atomic<entry_t const *> m_ids[ max_size ]{ }; // The entries by id.
+    mutable std::mutex m_mutex;
+    std::vector<std::unique_ptr<entry_t>> m_entries;    // Owns the entries, guarded by m_mutex.
+    std::vector<std::unique_ptr<zone_t const>> m_zones; // Owns the zones, the replaced ones too, guarded by m_mutex.
+};
@@ -0,0 +1,130 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the \"Software\"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cassert>
+#include <compare>
+#include <cstdint>
+
+#include "calendar.hpp"
+
+// An instant and the UTC offset it was observed at, in 8 bytes: the 100 ns ticks since 1900-01-01 [ UTC ] in the high 57
+// bits, the offset in quarter hours (biased, such that it is positive) in the low 7. Full tick precision over [ 1900,
+// 2356 ], every offset in use, and then some [ -16:00, +15:45 ].
+//
+// The raw value orders as the instant does (equal instants by offset), a comparison is an integer compare. Adding ticks
+// leaves the offset bits as they are, the arithmetic is plain 64-bit integer arithmetic, which vectorizes over arrays.
+// A zone_id_t does not fit next to the ticks at full precision, the offset does (and is what to_local ( ) needs).
+class zoned_time_t {
+
+    public:
+    static constexpr int offset_bits                = 7;
+    static constexpr std::uint64_t offset_mask      = ( 1ULL << offset_bits ) - 1u;
+    static constexpr int offset_bias                = 64;
+    static constexpr std::int64_t ticks_per_quarter = 15LL * 60LL * 10'000'000LL;
+    static constexpr std::int64_t epoch             = 109'207LL * ticks_per_day; // 1900-01-01, in ticks since 1601.
+    static constexpr std::int64_t min_utc           = epoch;
+    static constexpr std::int64_t max_utc           = epoch + static_cast<std::int64_t> ( ~0ULL >> offset_bits );
+    static constexpr int min_offset                 = -offset_bias * 15; // Minutes.
+    static constexpr int max_offset                 = ( static_cast<int> ( offset_mask ) - offset_bias ) * 15;
+
+    // 1900-01-01 00:00 UTC.
+    constexpr zoned_time_t ( ) noexcept = default;
+
+    // The instant utc_ [ ticks since 1601 ] at offset offset_minutes_ (a multiple of 15).
+    constexpr zoned_time_t ( std::int64_t const utc_, int const offset_minutes_ ) noexcept :
+        m_value{ ( static_cast<std::uint64_t> ( utc_ - epoch ) << offset_bits ) |
+                 static_cast<std::uint64_t> ( offset_minutes_ / 15 + offset_bias ) } {
+        assert ( min_utc <= utc_ and utc_ <= max_utc );
+        assert ( min_offset <= offset_minutes_ and offset_minutes_ <= max_offset and not( offset_minutes_ % 15 ) );
+    }
+    zoned_time_t ( wintime_t const utc_, int const offset_minutes_ ) noexcept :
+        zoned_time_t{ static_cast<std::int64_t> ( utc_.as_uint64 ( ) ), offset_minutes_ } {}
+
+    [[nodiscard]] static constexpr zoned_time_t from_raw ( std::uint64_t const raw_ ) noexcept {
+        zoned_time_t t;
+        t.m_value = raw_;
+        return t;
+    }
+    [[nodiscard]] constexpr std::uint64_t raw ( ) const noexcept { return m_value; }
+
+    // Ticks since 1601.
+    [[nodiscard]] constexpr std::int64_t utc ( ) const noexcept {
+        return static_cast<std::int64_t> ( m_value >> offset_bits ) + epoch;
+    }
+    [[nodiscard]] constexpr std::int64_t local ( ) const noexcept { return utc ( ) + offset ( ); }
+    // The offset, in ticks, respectively minutes, local time = UTC + offset.
+    [[nodiscard]] constexpr std::int64_t offset ( ) const noexcept { return quarters ( ) * ticks_per_quarter; }
+    [[nodiscard]] constexpr int offset_minutes ( ) const noexcept { return quarters ( ) * 15; }
+
+    [[nodiscard]] wintime_t utc_wintime ( ) const noexcept { return to_wintime ( utc ( ) ); }
+    [[nodiscard]] wintime_t local_wintime ( ) const noexcept { return to_wintime ( local ( ) ); }
+
+    // The same instant at offset offset_minutes_.
+    [[nodiscard]] constexpr zoned_time_t with_offset ( int const offset_minutes_ ) const noexcept {
+        assert ( min_offset <= offset_minutes_ and offset_minutes_ <= max_offset and not( offset_minutes_ % 15 ) );
+        return from_raw ( ( m_value & ~offset_mask ) | static_cast<std::uint64_t> ( offset_minutes_ / 15 + offset_bias ) );
+    }
+
+    // Whether a_ and b_ are the same instant, whatever their offsets.
+    [[nodiscard]] friend constexpr bool same_instant ( zoned_time_t const a_, zoned_time_t const b_ ) noexcept {
+        return not( ( a_.m_value ^ b_.m_value ) >> offset_bits );
+    }
+
+    [[nodiscard]] friend constexpr bool operator== ( zoned_time_t const, zoned_time_t const ) noexcept                  = default;
+    [[nodiscard]] friend constexpr std::strong_ordering operator<=> ( zoned_time_t const, zoned_time_t const ) noexcept = default;
+
+    // Moves the instant by ticks_ [ 100 ns ], the offset stays.
+    constexpr zoned_time_t & operator+= ( std::int64_t const ticks_ ) noexcept {
+        m_value += static_cast<std::uint64_t> ( ticks_ ) << offset_bits;
+        return *this;
+    }
+    constexpr zoned_time_t & operator-= ( std::int64_t const ticks_ ) noexcept {
+        m_value -= static_cast<std::uint64_t> ( ticks_ ) << offset_bits;
+        return *this;
+    }
+    [[nodiscard]] friend constexpr zoned_time_t operator+ ( zoned_time_t a_, std::int64_t const ticks_ ) noexcept {
+        return a_ += ticks_;
+    }
+    [[nodiscard]] friend constexpr zoned_time_t operator- ( zoned_time_t a_, std::int64_t const ticks_ ) noexcept {
+        return a_ -= ticks_;
+    }
+    // The ticks from b_ to a_.
+    [[nodiscard]] friend constexpr std::int64_t operator- ( zoned_time_t const a_, zoned_time_t const b_ ) noexcept {
+        return static_cast<std::int64_t> ( ( a_.m_value >> offset_bits ) - ( b_.m_value >> offset_bits ) );
+    }
+
+    private:
+    [[nodiscard]] constexpr int quarters ( ) const noexcept { return static_cast<int> ( m_value & offset_mask ) - offset_bias; }
+
+    [[nodiscard]] static wintime_t to_wintime ( std::int64_t const ticks_ ) noexcept {
+        wintime_t wt;
+        wt.as_uint64 ( ) = static_cast<std::uint64_t> ( ticks_ );
+        return wt;
+    }
+
+    std::uint64_t m_value = offset_bias;
+};
+
+static_assert ( sizeof ( zoned_time_t ) == 8u );
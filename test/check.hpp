@@ -0,0 +1,77 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the \"Software\"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstdio>
+
+#include <filesystem>
+#include <source_location>
+#include <system_error>
+
+// The checks run by main, a failed check reports its location and counts, the run goes on to the end.
+
+inline int check_failures = 0;
+
+inline bool check ( bool const ok_, std::source_location const where_ = std::source_location::current ( ) ) noexcept {
+    if ( not ok_ ) {
+        ++check_failures;
+        std::fprintf ( stderr, "%s:%u: check failed\n", where_.file_name ( ), static_cast<unsigned> ( where_.line ( ) ) );
+    }
+    return ok_;
+}
+
+// The root of the repository, where the fixtures are (test/tzif, windowsZones.xml): TIMEZONEINFO_SOURCE_DIR if the build
+// defines it, else the first of the working directory and its parents that holds test/tzif (Visual Studio runs the test
+// in the project directory, test/). Empty if not found, the checks on the fixtures fail then.
+[[nodiscard]] inline std::filesystem::path const & source_dir ( ) {
+    static std::filesystem::path const dir = [ ] {
+#if defined( TIMEZONEINFO_SOURCE_DIR )
+        return std::filesystem::path{ TIMEZONEINFO_SOURCE_DIR };
+#else
+        std::error_code ec;
+        for ( std::filesystem::path p = std::filesystem::current_path ( ec ); not p.empty ( ); p = p.parent_path ( ) ) {
+            if ( std::filesystem::is_directory ( p / "test" / "tzif", ec ) )
+                return p;
+            if ( p == p.parent_path ( ) )
+                break;
+        }
+        return std::filesystem::path{ };
+#endif
+    } ( );
+    return dir;
+}
+
+void check_batch ( );
+void check_business_calendar ( );
+void check_calendar ( );
+void check_clock ( );
+void check_fetcher ( );
+void check_ianamap ( );
+void check_iso8601 ( );
+void check_published ( );
+void check_snapshot ( );
+void check_time_format ( );
+void check_tzif ( );
+void check_zone ( );
+void check_zoned_time ( );
@@ -0,0 +1,165 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the \"Software\"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "check.hpp"
+
+#include "batch.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <optional>
+#include <random>
+#include <vector>
+
+namespace {
+
+zone_rule_t const new_york{ -5 * 3'600, -4 * 3'600, { 3, 2, 0, 2 * 3'600 }, { 11, 1, 0, 2 * 3'600 } };
+
+constexpr simd_level_t levels[]{ simd_level_t::scalar, simd_level_t::sse42, simd_level_t::avx2 };
+
+// Columns of UTC instants [ s ]: a minute apart over the transitions of a year, random over two centuries, and the two
+// interleaved, of every length up to 9 (the tails of the vector loops) and a longer one.
+[[nodiscard]] std::vector<std::vector<std::int64_t>> columns ( ) {
+    std::mt19937_64 rng{ 2019u };
+    std::uniform_int_distribution<std::int64_t> dist{ days_from_civil ( 1900, 1, 1 ) * 86'400,
+                                                      days_from_civil ( 2100, 1, 1 ) * 86'400 };
+    std::int64_t const start = days_from_civil ( 2019, 1, 1 ) * 86'400;
+    std::vector<std::vector<std::int64_t>> columns;
+    for ( std::size_t n : { 0u, 1u, 2u, 3u, 4u, 5u, 6u, 7u, 8u, 9u, 600'000u } ) {
+        std::vector<std::int64_t> ordered ( n ), random ( n ), mixed ( n );
+        for ( std::size_t i = 0u; i < n; ++i ) {
+            ordered[ i ] = start + static_cast<std::int64_t> ( i ) * 60;
+            random[ i ]  = dist ( rng );
+            mixed[ i ]   = i % 5u ? ordered[ i ] : random[ i ];
+        }
+        columns.push_back ( std::move ( ordered ) );
+        columns.push_back ( std::move ( random ) );
+        columns.push_back ( std::move ( mixed ) );
+    }
+    return columns;
+}
+
+// The kernels of each level against the zone, element by element.
+void check_to_local ( ) {
+    zone_t const zone{ new_york };
+    std::vector<std::vector<std::int64_t>> const cs = columns ( );
+    for ( simd_level_t const level : levels ) {
+        if ( level != set_simd_level ( level ) )
+            continue;
+        for ( std::vector<std::int64_t> const & c : cs ) {
+            std::size_t const n = c.size ( );
+            std::vector<nixtime_t> nix ( c.begin ( ), c.end ( ) ), nix_out ( n );
+            std::vector<wintime_t> win ( n ), win_out ( n );
+            for ( std::size_t i = 0u; i < n; ++i )
+                win[ i ] = nixtime_to_wintime ( nix[ i ] );
+            to_local ( zone, nix, nix_out );
+            to_local ( zone, win, win_out );
+            bool ok = true;
+            for ( std::size_t i = 0u; i < n; ++i )
+                ok = ok and nix_out[ i ] == zone.to_local ( nix[ i ] ) and
+                     win_out[ i ].as_uint64 ( ) == zone.to_local ( win[ i ] ).as_uint64 ( );
+            check ( ok );
+            to_local ( zone, nix, nix ); // In place.
+            check ( nix == nix_out );
+        }
+    }
+    set_simd_level ( simd_level_t::avx2 );
+}
+
+// The decomposition of each level against civil_from_days, over all years a date_parts_t holds.
+void check_decompose ( ) {
+    constexpr std::size_t n = 100'000u;
+    // The days of the reference shifted by whole eras, as days_from_civil and civil_from_days are for years from 0.
+    constexpr std::int64_t eras = 100, era_s = 146'097LL * 86'400;
+    std::int64_t const first = days_from_civil ( -32'768 + eras * 400, 1, 1 ) * 86'400 - eras * era_s;
+    std::int64_t const last  = days_from_civil ( 32'767 + eras * 400 + 1, 1, 1 ) * 86'400 - eras * era_s - 1;
+    std::mt19937_64 rng{ 1601u };
+    std::uniform_int_distribution<std::int64_t> dist{ first, last };
+    std::vector<nixtime_t> in ( n );
+    for ( std::size_t i = 0u; i < n; ++i )
+        in[ i ] = dist ( rng );
+    in[ 0 ] = first, in[ 1 ] = last, in[ 2 ] = days_from_civil ( 1601, 1, 1 ) * 86'400 - 1, in[ 3 ] = -1, in[ 4 ] = 0;
+    std::vector<std::int16_t> year ( n );
+    std::vector<std::int8_t> month ( n ), day ( n ), hour ( n ), minute ( n ), second ( n ), day_of_week ( n );
+    for ( simd_level_t const level : levels ) {
+        if ( level != set_simd_level ( level ) )
+            continue;
+        decompose ( in, { year, month, day, hour, minute, second, day_of_week } );
+        bool ok = true;
+        for ( std::size_t i = 0u; i < n; ++i ) {
+            std::int64_t const s    = in[ i ] + eras * era_s;
+            std::int64_t const days = s / 86'400, secs = s % 86'400;
+            civil_t const c         = civil_from_days ( days );
+            ok = ok and year[ i ] == c.year - eras * 400 and month[ i ] == c.month and day[ i ] == c.day and
+                 hour[ i ] == secs / 3'600 and minute[ i ] == secs / 60 % 60 and second[ i ] == secs % 60 and
+                 day_of_week[ i ] == ( days + 4 ) % 7; // 1970-01-01 was a Thursday, eras are whole weeks.
+        }
+        check ( ok );
+    }
+    set_simd_level ( simd_level_t::avx2 );
+}
+
+// The columns as local times, against the zone element by element, under each policy: the rejected elements are the
+// sentinel, the kinds and the count of the irregular ones are those of the resolutions.
+void check_local_to_utc ( ) {
+    zone_t const zone{ new_york };
+    std::vector<std::vector<std::int64_t>> const cs = columns ( );
+    for ( ambiguous_t const a : { ambiguous_t::earliest, ambiguous_t::latest, ambiguous_t::reject } ) {
+        for ( nonexistent_t const e : { nonexistent_t::shift_forward, nonexistent_t::reject } ) {
+            local_policy_t const policy{ a, e };
+            for ( std::vector<std::int64_t> const & c : cs ) {
+                std::size_t const n = c.size ( );
+                std::vector<nixtime_t> nix ( c.begin ( ), c.end ( ) ), nix_out ( n, 0 );
+                std::vector<wintime_t> win ( n ), win_out ( n );
+                std::vector<local_kind_t> kinds ( n );
+                for ( std::size_t i = 0u; i < n; ++i )
+                    win[ i ] = nixtime_to_wintime ( nix[ i ] );
+                std::size_t const irregular = local_to_utc ( zone, nix, nix_out, kinds, policy );
+                check ( irregular == local_to_utc ( zone, win, win_out, { }, policy ) );
+                bool ok           = true;
+                std::size_t count = 0u;
+                for ( std::size_t i = 0u; i < n; ++i ) {
+                    std::int64_t const local               = static_cast<std::int64_t> ( win[ i ].as_uint64 ( ) );
+                    local_resolution_t const r             = zone.resolve_local ( local );
+                    std::optional<nixtime_t> const nix_utc = local_to_utc ( zone, nix[ i ], policy );
+                    std::optional<wintime_t> const win_utc = local_to_utc ( zone, win[ i ], policy );
+                    count += local_kind_t::unique != r.kind;
+                    ok = ok and r.kind == kinds[ i ] and nix_out[ i ] == ( nix_utc ? *nix_utc : rejected_nixtime ) and
+                         win_out[ i ].as_uint64 ( ) == ( win_utc ? win_utc->as_uint64 ( ) : rejected_wintime );
+                }
+                check ( ok and count == irregular );
+                if ( n == 600'000u and c[ 1 ] - c[ 0 ] == 60 ) // The ordered column holds both transitions of 2019.
+                    check ( 2u * 60u == irregular );
+            }
+        }
+    }
+}
+
+} // namespace
+
+void check_batch ( ) {
+    check_to_local ( );
+    check_decompose ( );
+    check_local_to_utc ( );
+}
@@ -0,0 +1,139 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the \"Software\"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "check.hpp"
+
+#include "business_calendar.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+
+#include <random>
+#include <set>
+#include <vector>
+
+namespace {
+
+// The business days of a calendar, day by day.
+class reference_t {
+
+    public:
+    reference_t ( int const first_year_, int const last_year_, business_calendar_t::weekend_t const weekend_,
+                  std::span<civil_t const> holidays_ ) :
+        m_first_day{ days_from_civil ( first_year_, 1, 1 ) },
+        m_end_day{ days_from_civil ( last_year_ + 1, 1, 1 ) }, m_weekend{ weekend_ } {
+        for ( civil_t const & h : holidays_ ) {
+            std::int64_t const day = days_from_civil ( h.year, h.month, h.day );
+            // A date, if it comes back as it went in.
+            if ( civil_t const c = civil_from_days ( day ); c.year == h.year and c.month == h.month and c.day == h.day )
+                m_holidays.insert ( day );
+        }
+    }
+
+    [[nodiscard]] bool is_business_day ( std::int64_t const day_ ) const {
+        int const dow = static_cast<int> ( ( ( day_ + 4 ) % 7 + 7 ) % 7 ); // 1970-01-01 was a Thursday.
+        return m_first_day <= day_ and day_ < m_end_day and not( m_weekend >> dow & 1u ) and not m_holidays.contains ( day_ );
+    }
+
+    // n_ business days on from day_, a day at a time, the last (first) business day of the calendar if it ends before.
+    [[nodiscard]] std::int64_t add ( std::int64_t const day_, std::int64_t const n_ ) const {
+        int const step   = n_ > 0 ? 1 : -1;
+        std::int64_t day = day_;
+        for ( std::int64_t left = std::abs ( n_ ); left; left -= is_business_day ( day ) ) {
+            day += step;
+            if ( step > 0 ? day >= m_end_day : day < m_first_day ) {
+                for ( day = step > 0 ? m_end_day - 1 : m_first_day; not is_business_day ( day ); day -= step )
+                    ;
+                return day;
+            }
+        }
+        return day;
+    }
+
+    std::int64_t m_first_day, m_end_day;
+
+    private:
+    business_calendar_t::weekend_t m_weekend;
+    std::set<std::int64_t> m_holidays;
+};
+
+// Every day of the calendar, with the counts from its first day, and n business days on from random days.
+void check_against ( business_calendar_t const & calendar_, reference_t const & reference_ ) {
+    check ( calendar_.first_day ( ) == reference_.m_first_day and calendar_.end_day ( ) == reference_.m_end_day );
+    std::int64_t const first = reference_.m_first_day - 10, end = reference_.m_end_day + 10;
+    std::vector<std::int64_t> business; // The business days, in order.
+    bool same = true;
+    for ( std::int64_t day = first; day < end; ++day ) {
+        same = same and calendar_.business_days_between ( first, day ) == static_cast<std::int64_t> ( business.size ( ) ) and
+               calendar_.business_days_between ( day, first ) == -static_cast<std::int64_t> ( business.size ( ) );
+        if ( reference_.is_business_day ( day ) )
+            business.push_back ( day );
+        same = same and calendar_.is_business_day ( day ) == reference_.is_business_day ( day );
+    }
+    check ( same );
+    if ( not check ( business.size ( ) ) )
+        return;
+    // The next and previous business days, of every day.
+    same = true;
+    for ( std::int64_t day = first; day < end; ++day )
+        same = same and calendar_.next_business_day ( day ) == reference_.add ( day, 1 ) and
+               calendar_.previous_business_day ( day ) == reference_.add ( day, -1 );
+    check ( same );
+    // Steps of up to a few hundred business days, either way, off the ends too.
+    std::mt19937_64 rng{ 2'020u };
+    std::uniform_int_distribution<std::int64_t> days{ first, end - 1 }, steps{ -300, 300 };
+    same = true;
+    for ( int i = 0; i < 20'000; ++i ) {
+        std::int64_t const day = days ( rng ), n = steps ( rng );
+        same                   = same and calendar_.add_business_days ( day, n ) == reference_.add ( day, n );
+    }
+    check ( same );
+    check ( calendar_.add_business_days ( first, 0 ) == first );
+    check ( calendar_.add_business_days ( first, 1 ) == business.front ( ) );
+    check ( calendar_.add_business_days ( first, static_cast<std::int64_t> ( business.size ( ) ) ) == business.back ( ) );
+    check ( calendar_.add_business_days ( end, -static_cast<std::int64_t> ( business.size ( ) ) ) == business.front ( ) );
+}
+
+} // namespace
+
+void check_business_calendar ( ) {
+    // Holidays on the weekend, outside the years, and ones that are not dates (which would clear the bits of other days,
+    // or bits past the end of the year).
+    civil_t const holidays[]{ { 2020, 1, 1 },  { 2020, 12, 25 }, { 2021, 1, 1 },  { 2021, 12, 25 }, { 2022, 7, 4 },
+                              { 2018, 1, 1 },  { 2024, 1, 1 },   { 2021, 2, 29 }, { 2021, 2, 30 },  { 2020, 13, 1 },
+                              { 2020, 0, 10 }, { 2020, 6, 0 },   { 2020, 12, 99 } };
+    using weekend_t = business_calendar_t::weekend_t;
+    for ( weekend_t const weekend : { business_calendar_t::saturday_sunday, business_calendar_t::friday_saturday } )
+        check_against ( business_calendar_t ( 2019, 2022, weekend, holidays ), reference_t ( 2019, 2022, weekend, holidays ) );
+    check ( business_calendar_t ( 2021, 2021, business_calendar_t::saturday_sunday, holidays )
+                .is_business_day ( days_from_civil ( 2021, 3, 1 ) ) ); // Not cleared by February 29.
+    // A span of centuries, over which a year is not 366 days, from before 1601.
+    civil_t const few[]{ { 1600, 2, 29 }, { 2000, 2, 29 }, { 2399, 12, 31 } };
+    check_against ( business_calendar_t ( 1600, 2400, business_calendar_t::saturday_sunday, few ),
+                    reference_t ( 1600, 2400, business_calendar_t::saturday_sunday, few ) );
+    // A single year, and a calendar without business days.
+    check_against ( business_calendar_t ( 2024, 2024 ), reference_t ( 2024, 2024, business_calendar_t::saturday_sunday, { } ) );
+    business_calendar_t const closed ( 2024, 2024, 0x7fu );
+    check ( 0 == closed.business_days_between ( closed.first_day ( ), closed.end_day ( ) ) );
+    check ( closed.add_business_days ( closed.first_day ( ), 5 ) == closed.first_day ( ) );
+}
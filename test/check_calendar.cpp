@@ -0,0 +1,65 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the \"Software\"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "check.hpp"
+
+#include "timezoneinfo.hpp"
+
+#include <cstring>
+
+#include <string>
+#include <string_view>
+
+namespace {
+
+[[nodiscard]] bool same_grid ( month_t const & a_, month_t const & b_ ) noexcept {
+    return a_.weeks == b_.weeks and 0 == std::memcmp ( a_.week_num, b_.week_num, sizeof ( a_.week_num ) ) and
+           0 == std::memcmp ( a_.days, b_.days, sizeof ( a_.days ) );
+}
+
+// The title line of the rendering of m_, within max_month_text chars.
+[[nodiscard]] std::string title ( month_t const & m_ ) {
+    char buffer[ max_month_text + 1u ];
+    buffer[ max_month_text ] = '\x7f'; // A guard.
+    std::size_t const size   = static_cast<std::size_t> ( render_month ( buffer, m_ ) - buffer );
+    check ( size <= max_month_text and '\x7f' == buffer[ max_month_text ] );
+    std::string_view const text{ buffer, size };
+    return std::string{ text.substr ( 0u, text.find ( '\n' ) ) };
+}
+
+// The years of an int16, all 6 chars of the longest, the years before AD, which repeat those 400 years later.
+void check_render_month ( ) {
+    check ( "      January -32768" == title ( make_month ( -32'768, 1 ) ) );
+    check ( "     September 32767" == title ( make_month ( 32'767, 9 ) ) );
+    check ( "     September -1000" == title ( cached_month ( -1'000, 9 ) ) );
+    check ( "       August 2019" == title ( cached_month ( 2'019, 8 ) ) );
+    for ( int const y : { -32'768, -401, -1, 0 } )
+        for ( int m = 1; m <= 12; ++m )
+            check ( same_grid ( make_month ( y, m ), make_month ( y + 400 * ( 1 - y / 400 ), m ) ) and
+                    same_grid ( cached_month ( y, m ), make_month ( y, m ) ) );
+    check ( 29 == make_month ( 0, 2 ).days[ 4 ][ 2 ] ); // Year 0 (1 BC) is a leap year, its February 29 a Tuesday.
+}
+
+} // namespace
+
+void check_calendar ( ) { check_render_month ( ); }
@@ -0,0 +1,176 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the \"Software\"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "check.hpp"
+
+#include "clock.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <atomic>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+zone_rule_t const new_york{ -5 * 3'600, -4 * 3'600, { 3, 2, 0, 2 * 3'600 }, { 11, 1, 0, 2 * 3'600 } };
+zone_rule_t const sydney{ 10 * 3'600, 11 * 3'600, { 10, 1, 0, 2 * 3'600 }, { 4, 1, 0, 3 * 3'600 } };
+zone_rule_t const at_midnight{ -4 * 3'600, -3 * 3'600, { 9, 1, 0, 0 }, { 4, 1, 0, 0 } }; // Transitions at 00:00 local.
+zone_rule_t const kolkata{ 19'800, 19'800, { }, { } };
+
+constexpr std::int64_t minute = 60LL * 10'000'000LL; // Ticks.
+
+// The ticks since 1601 at y_-m_-d_ 00:00 UTC.
+[[nodiscard]] constexpr std::int64_t ticks ( int const y_, int const m_, int const d_ ) noexcept {
+    return ( days_from_civil ( y_, m_, d_ ) + days_from_winepoch_to_nix ) * ticks_per_day;
+}
+
+[[nodiscard]] bool same ( systime_t const & a_, systime_t const & b_ ) noexcept {
+    return a_.wYear == b_.wYear and a_.wMonth == b_.wMonth and a_.wDayOfWeek == b_.wDayOfWeek and a_.wDay == b_.wDay and
+           a_.wHour == b_.wHour and a_.wMinute == b_.wMinute and a_.wSecond == b_.wSecond and
+           a_.wMilliseconds == b_.wMilliseconds;
+}
+
+// The local time of utc_ in zone_, as the zone converts it.
+[[nodiscard]] systime_t reference ( zone_t const & zone_, std::int64_t const utc_ ) noexcept {
+    wintime_t wt;
+    wt.as_uint64 ( ) = static_cast<std::uint64_t> ( utc_ );
+    return wintime_to_systime ( zone_.to_local ( wt ) );
+}
+
+// The instants of change of offset of zone_ before and after utc_, found by walking the periods (which are split where
+// the offset does not change as well), at most a day away.
+[[nodiscard]] std::int64_t previous_change ( zone_t const & zone_, std::int64_t const utc_ ) noexcept {
+    period_t p = zone_.period ( utc_ );
+    while ( p.begin > utc_ - ticks_per_day and zone_.offset ( p.begin - 1 ) == p.offset )
+        p = zone_.period ( p.begin - 1 );
+    return p.begin;
+}
+[[nodiscard]] std::int64_t next_change ( zone_t const & zone_, std::int64_t const utc_ ) noexcept {
+    period_t p = zone_.period ( utc_ );
+    while ( p.end < utc_ + ticks_per_day and zone_.offset ( p.end ) == p.offset )
+        p = zone_.period ( p.end );
+    return p.end;
+}
+
+// Every quarter hour, and a tick either side, over two days around the transitions and the turns of the years of 2024
+// and 2025: the local day holds at the instant and converts it as the zone does, its interval runs from the later of the
+// local midnight and the previous transition to the earlier of the next local midnight and the next transition. Each
+// zone also compiled for 2024 only, the periods beyond the table end at the turn of each (UTC) year.
+void check_local_days ( ) {
+    std::vector<std::pair<zone_t, zone_rule_t>> zones;
+    for ( zone_rule_t const & rule : { new_york, sydney, at_midnight, kolkata } ) {
+        zones.emplace_back ( zone_t{ rule }, rule );
+        zones.emplace_back ( zone_t{ rule, 2024, 2024 }, rule );
+    }
+    for ( auto const & [ zone, rule ] : zones ) {
+        std::vector<std::int64_t> centres{ ticks ( 2024, 1, 1 ), ticks ( 2025, 1, 1 ), ticks ( 2026, 1, 1 ) };
+        if ( rule.has_dst ( ) )
+            for ( int const y : { 2024, 2025 } )
+                centres.insert ( centres.end ( ), { rule.dst_start_utc ( y ), rule.dst_end_utc ( y ) } );
+        bool ok = true;
+        for ( std::int64_t const centre : centres ) {
+            for ( std::int64_t q = centre / ( 15 * minute ) * 15 * minute - ticks_per_day; q <= centre + ticks_per_day;
+                  q += 15 * minute ) {
+                for ( std::int64_t const t : { q - 1, q, q + 1 } ) {
+                    local_day_t const d         = make_local_day ( zone, t );
+                    std::int64_t const offset   = zone.offset ( t );
+                    std::int64_t const midnight = ( t + offset ) / ticks_per_day * ticks_per_day - offset;
+                    ok = ok and d.contains ( t ) and same ( d.local_systime ( t ), reference ( zone, t ) ) and
+                         d.offset == offset and d.begin == std::max ( midnight, previous_change ( zone, t ) ) and
+                         d.end == std::min ( midnight + ticks_per_day, next_change ( zone, t ) );
+                }
+            }
+        }
+        check ( ok );
+    }
+}
+
+// The day of writer round k_, its fields all derived from k_, and that it holds at instant 1.
+[[nodiscard]] local_day_t day_of ( std::int64_t const k_ ) noexcept {
+    local_day_t d;
+    d.begin       = -k_;
+    d.end         = k_ + 2;
+    d.offset      = k_;
+    d.midnight    = 2 * k_;
+    d.year        = static_cast<std::int16_t> ( k_ );
+    d.month       = static_cast<std::int8_t> ( k_ );
+    d.day         = static_cast<std::int8_t> ( k_ >> 8 );
+    d.day_of_week = static_cast<std::int8_t> ( k_ >> 16 );
+    return d;
+}
+
+// A writer publishes day after day, while readers load: a day that is served is one that was written, whole, a slot in
+// the middle of a write is not served.
+void check_slot_torn ( ) {
+    zone_t const utc;
+    local_day_slot_t slot;
+    slot.store ( utc, day_of ( 1 ) );
+    std::atomic<bool> stop{ false }, torn{ false };
+    std::atomic<std::size_t> served{ 0u };
+    std::vector<std::jthread> readers;
+    for ( int i = 0; i < 3; ++i )
+        readers.emplace_back ( [ &utc, &slot, &stop, &torn, &served ] {
+            while ( not stop.load ( std::memory_order_relaxed ) ) {
+                if ( std::optional<local_day_t> const d = slot.load ( utc, 1 ); d ) {
+                    local_day_t const e = day_of ( d->offset );
+                    if ( d->begin != e.begin or d->end != e.end or d->midnight != e.midnight or d->year != e.year or
+                         d->month != e.month or d->day != e.day or d->day_of_week != e.day_of_week )
+                        torn.store ( true, std::memory_order_relaxed );
+                    served.fetch_add ( 1u, std::memory_order_relaxed );
+                }
+            }
+        } );
+    // Until the readers have been served a while (they may start late), bounded.
+    for ( std::int64_t k = 2; k < 400'000 or ( served.load ( std::memory_order_relaxed ) < 10'000u and k < 100'000'000 ); ++k )
+        slot.store ( utc, day_of ( k ) );
+    stop.store ( true, std::memory_order_relaxed );
+    readers.clear ( );
+    check ( not torn.load ( ) );
+    check ( served.load ( ) > 0u );
+}
+
+// A day is served for the zone it was computed in only, the day of an id follows the zone recompiled under it (with
+// another offset, as after a publish of new zone data), within the day.
+void check_slot_zone ( ) {
+    zone_t const before{ kolkata }, after{ zone_rule_t{ 20'700, 20'700, { }, { } } };
+    std::int64_t const t = ticks ( 2025, 6, 1 ) + 12 * 60 * minute, later = t + minute;
+    zone_id_t const id{ 0u };
+    check ( before.offset ( t ) == today_in_zone ( id, before, t ).offset );
+    check ( after.offset ( later ) == today_in_zone ( id, after, later ).offset );
+    local_day_slot_t slot;
+    slot.store ( before, make_local_day ( before, t ) );
+    check ( slot.load ( before, later ).has_value ( ) and not slot.load ( after, later ).has_value ( ) );
+}
+
+} // namespace
+
+void check_clock ( ) {
+    check_local_days ( );
+    check_slot_torn ( );
+    check_slot_zone ( );
+}
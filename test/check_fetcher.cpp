@@ -0,0 +1,326 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the \"Software\"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "check.hpp"
+
+#include "fetcher.hpp"
+#include "ianamap.hpp"
+#include "timezoneinfo.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#if _WIN32
+#    include <winsock2.h>
+#    include <ws2tcpip.h>
+#else
+#    include <arpa/inet.h>
+#    include <netinet/in.h>
+#    include <sys/socket.h>
+#    include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+
+#if _WIN32
+using socket_t            = SOCKET;
+constexpr int send_flags = 0;
+#else
+using socket_t                    = int;
+constexpr socket_t INVALID_SOCKET = -1;
+constexpr int send_flags          = MSG_NOSIGNAL; // A client that gave up is gone, no SIGPIPE.
+void closesocket ( socket_t const socket_ ) noexcept { ::close ( socket_ ); }
+#endif
+
+// What the server answers, after delay.
+struct response_t {
+    int status = 200;
+    std::string body;
+    std::string etag; // None if empty.
+    std::chrono::milliseconds delay{ 0 };
+};
+
+// An HTTP server on a loopback port, of one request per connection, answered as respond_ has it, given the path and the
+// If-None-Match of the request.
+class server_t {
+
+    public:
+    using respond_t = std::function<response_t ( std::string_view, std::string_view )>;
+
+    explicit server_t ( respond_t respond_ ) : m_respond{ std::move ( respond_ ) } {
+#if _WIN32
+        WSADATA wsa;
+        WSAStartup ( MAKEWORD ( 2, 2 ), &wsa );
+#endif
+        m_listener          = ::socket ( AF_INET, SOCK_STREAM, IPPROTO_TCP );
+        sockaddr_in address = loopback ( 0u ); // Any free port.
+        socklen_t length    = sizeof ( address );
+        if ( INVALID_SOCKET == m_listener or ::bind ( m_listener, reinterpret_cast<sockaddr const *> ( &address ), length ) or
+             ::listen ( m_listener, 16 ) or ::getsockname ( m_listener, reinterpret_cast<sockaddr *> ( &address ), &length ) ) {
+            if ( INVALID_SOCKET != m_listener )
+                closesocket ( m_listener );
+            m_listener = INVALID_SOCKET;
+            return;
+        }
+        m_port   = ntohs ( address.sin_port );
+        m_thread = std::jthread{ [ this ] { serve ( ); } };
+    }
+
+    server_t ( server_t const & ) = delete;
+    server_t & operator= ( server_t const & ) = delete;
+
+    ~server_t ( ) {
+        if ( INVALID_SOCKET != m_listener ) {
+            m_stop.store ( true );
+            closesocket ( connect ( ) ); // Wakes the accept.
+            m_thread.join ( );
+            closesocket ( m_listener );
+        }
+#if _WIN32
+        WSACleanup ( );
+#endif
+    }
+
+    [[nodiscard]] bool is_open ( ) const noexcept { return INVALID_SOCKET != m_listener; }
+    [[nodiscard]] std::string url ( std::string_view const path_ ) const {
+        return "http://127.0.0.1:" + std::to_string ( m_port ) + std::string{ path_ };
+    }
+    // The number of requests answered (or being answered).
+    [[nodiscard]] int requests ( ) const noexcept { return m_requests.load ( ); }
+
+    private:
+    [[nodiscard]] static sockaddr_in loopback ( std::uint16_t const port_ ) noexcept {
+        sockaddr_in address{ };
+        address.sin_family      = AF_INET;
+        address.sin_addr.s_addr = htonl ( INADDR_LOOPBACK );
+        address.sin_port        = htons ( port_ );
+        return address;
+    }
+
+    [[nodiscard]] socket_t connect ( ) const noexcept {
+        socket_t const client     = ::socket ( AF_INET, SOCK_STREAM, IPPROTO_TCP );
+        sockaddr_in const address = loopback ( m_port );
+        ::connect ( client, reinterpret_cast<sockaddr const *> ( &address ), sizeof ( address ) );
+        return client;
+    }
+
+    void serve ( ) {
+        for ( ;; ) {
+            socket_t const client = ::accept ( m_listener, nullptr, nullptr );
+            if ( INVALID_SOCKET == client )
+                return;
+            if ( not m_stop.load ( ) )
+                answer ( client );
+            closesocket ( client );
+            if ( m_stop.load ( ) )
+                return;
+        }
+    }
+
+    void answer ( socket_t const client_ ) {
+        std::string request;
+        char buffer[ 1'024 ];
+        while ( std::string::npos == request.find ( "\r\n\r\n" ) ) {
+            int const n = static_cast<int> ( ::recv ( client_, buffer, static_cast<int> ( sizeof ( buffer ) ), 0 ) );
+            if ( n <= 0 )
+                return;
+            request.append ( buffer, static_cast<std::size_t> ( n ) );
+        }
+        ++m_requests;
+        // GET path HTTP/1.1, and the If-None-Match header as the fetcher writes it.
+        std::size_t const begin = request.find ( ' ' ) + 1u;
+        std::string_view const path{ request.data ( ) + begin, request.find ( ' ', begin ) - begin };
+        std::string_view tag;
+        if ( std::size_t const header = request.find ( "\r\nIf-None-Match: " ); std::string::npos != header ) {
+            std::size_t const value = header + 17u;
+            tag                     = { request.data ( ) + value, request.find ( "\r\n", value ) - value };
+        }
+        response_t const response = m_respond ( path, tag );
+        std::this_thread::sleep_for ( response.delay );
+        std::string out = "HTTP/1.1 " + std::to_string ( response.status ) + " -\r\nConnection: close\r\nContent-Length: " +
+                          std::to_string ( response.body.size ( ) ) + "\r\n";
+        if ( response.etag.size ( ) )
+            out += "ETag: " + response.etag + "\r\n";
+        out += "\r\n" + response.body;
+        for ( std::size_t sent = 0u; sent < out.size ( ); ) {
+            int const n =
+                static_cast<int> ( ::send ( client_, out.data ( ) + sent, static_cast<int> ( out.size ( ) - sent ), send_flags ) );
+            if ( n <= 0 )
+                return;
+            sent += static_cast<std::size_t> ( n );
+        }
+    }
+
+    respond_t m_respond;
+    socket_t m_listener = INVALID_SOCKET;
+    std::uint16_t m_port = 0u;
+    std::atomic<int> m_requests = 0;
+    std::atomic<bool> m_stop    = false;
+    std::jthread m_thread;
+};
+
+[[nodiscard]] std::string read ( fs::path const & path_ ) {
+    std::ifstream in ( path_, std::ios::binary );
+    return { std::istreambuf_iterator<char> ( in ), std::istreambuf_iterator<char> ( ) };
+}
+
+// The repository copy of windowsZones.xml.
+[[nodiscard]] std::string windowszones_xml ( ) {
+    return read ( source_dir ( ) / "windowsZones.xml" );
+}
+
+// Serves the good file under any path, tagged "a", but for /garbage, a 200 of an error page, for /flaky, two 503s first,
+// for /down, 503s, for /missing, a 404, and for /slow, the file after a second.
+[[nodiscard]] response_t respond ( std::string const & good_, int & flaky_, std::string_view const path_,
+                                   std::string_view const tag_ ) {
+    using namespace std::chrono_literals;
+    if ( "/garbage" == path_ )
+        return { 200, "<html><body>Service Unavailable</body></html>", "\"b\"" };
+    if ( "/down" == path_ or ( "/flaky" == path_ and flaky_++ < 2 ) )
+        return { 503, { }, { } };
+    if ( "/missing" == path_ )
+        return { 404, { }, { } };
+    if ( "/slow" == path_ )
+        return { 200, good_, { }, 1'000ms };
+    if ( "\"a\"" == tag_ )
+        return { 304, { }, "\"a\"" };
+    return { 200, good_, "\"a\"" };
+}
+
+// Downloads that verify the body, parsed as it arrives: a good one replaces the file, is not downloaded again, garbage
+// does not replace it.
+void check_download ( server_t const & server_, std::string const & good_ ) {
+    fs::path const path = fs::temp_directory_path ( ) / "timezoneinfo_check_download.xml";
+    std::error_code ec;
+    fs::remove ( path, ec );
+    auto const get = [ &path ] ( std::string const & url_, download_validators_t & validators_ ) {
+        windowszones_parser_t parser ( fill_timezones_db ( ) );
+        auto const feed = [ &parser ] ( std::string_view const piece_ ) { parser.feed ( piece_ ); };
+        return download ( url_.c_str ( ), path, validators_, feed, [ &parser ] { return not parser.finish ( ).empty ( ); } );
+    };
+    download_validators_t validators;
+    check ( download_status_t::changed == get ( server_.url ( "/windowsZones.xml" ), validators ) );
+    check ( "\"a\"" == validators.etag and good_ == read ( path ) );
+    check ( download_status_t::not_modified == get ( server_.url ( "/windowsZones.xml" ), validators ) );
+    download_validators_t none;
+    check ( download_status_t::failed == get ( server_.url ( "/garbage" ), none ) );
+    check ( good_ == read ( path ) and not fs::exists ( fs::path{ path } += ".part" ) );
+    fs::remove ( path, ec );
+}
+
+// A due refresh that gets garbage keeps the file there is, and the data built from it.
+void check_refresh_garbage ( server_t const & server_, std::string const & good_ ) {
+    await_refresh ( );
+    fs::path const & path = windowszones_path ( );
+    if ( not fs::exists ( path ) )
+        std::ofstream ( path, std::ios::binary ) << good_;
+    std::string const before = read ( path );
+    std::string const url    = source_url ( snapshot_source_t::windowszones );
+    Timestamps const stamps  = timestamps ( );
+    char const * const keys[]{ "last_windowszones_download", "last_windowszones_check" };
+    set_source_url ( snapshot_source_t::windowszones, server_.url ( "/garbage" ) );
+    for ( char const * const key : keys )
+        set_timestamp ( key, 0u ); // Due.
+    save_timestamps ( );
+    int const requests = server_.requests ( );
+    init ( );
+    await_refresh ( );
+    check ( server_.requests ( ) > requests );
+    check ( before == read ( path ) );
+    check ( zone_data ( )->map.contains ( "America/New_York" ) );
+    set_source_url ( snapshot_source_t::windowszones, url );
+    for ( char const * const key : keys )
+        if ( auto const it = stamps.find ( key ); std::end ( stamps ) != it )
+            set_timestamp ( key, it->second );
+    save_timestamps ( );
+}
+
+// The retries of fetch ( ), after a backoff that doubles, of what may go better (a 5xx, a timeout), not of what the server
+// refused (a 4xx). An attempt ends at its timeout.
+void check_fetch_retries ( server_t const & server_, std::string const & good_ ) {
+    using namespace std::chrono_literals;
+    using clock         = std::chrono::steady_clock;
+    fs::path const path = fs::temp_directory_path ( ) / "timezoneinfo_check_fetch.xml";
+    auto const make     = [ &server_, &path ] ( std::string_view const path_, int const retries_ ) {
+        fetch_request_t request;
+        request.url     = server_.url ( path_ );
+        request.path    = path;
+        request.retries = retries_;
+        request.backoff = 50ms;
+        request.timeout = 2'000ms;
+        return request;
+    };
+    // Two 503s, then the file: three attempts, 50 and 100 ms apart, the sink starts over with each.
+    std::string body;
+    int restarts          = 0;
+    fetch_request_t flaky = make ( "/flaky", 3 );
+    flaky.sink            = [ &body ] ( std::string_view const piece_ ) { body.append ( piece_ ); };
+    flaky.restart         = [ &body, &restarts ] {
+        body.clear ( );
+        ++restarts;
+    };
+    clock::time_point start = clock::now ( );
+    fetch ( { &flaky, 1u } );
+    check ( download_status_t::changed == flaky.status and 3 == flaky.attempts and 2 == restarts );
+    check ( clock::now ( ) - start >= 150ms and good_ == body and good_ == read ( path ) );
+    // Together, the one runs out of retries, the other is not retried.
+    fetch_request_t refused[ 2 ] = { make ( "/down", 2 ), make ( "/missing", 3 ) };
+    fetch ( refused );
+    check ( download_status_t::failed == refused[ 0 ].status and 3 == refused[ 0 ].attempts and 503 == refused[ 0 ].response_code );
+    check ( download_status_t::failed == refused[ 1 ].status and 1 == refused[ 1 ].attempts and 404 == refused[ 1 ].response_code );
+    // Both attempts time out, long before the server answers.
+    fetch_request_t slow = make ( "/slow", 1 );
+    slow.timeout         = 100ms;
+    start                = clock::now ( );
+    fetch ( { &slow, 1u } );
+    check ( download_status_t::failed == slow.status and 2 == slow.attempts and clock::now ( ) - start < 900ms );
+    // Failed, the file there was stays.
+    check ( good_ == read ( path ) );
+    std::error_code ec;
+    fs::remove ( path, ec );
+}
+
+} // namespace
+
+void check_fetcher ( ) {
+    std::string const good = windowszones_xml ( );
+    int flaky              = 0; // The requests of /flaky, on the thread of the server.
+    server_t const server ( [ &good, &flaky ] ( std::string_view const path_, std::string_view const tag_ ) {
+        return respond ( good, flaky, path_, tag_ );
+    } );
+    if ( not check ( server.is_open ( ) ) )
+        return;
+    check_download ( server, good );
+    check_fetch_retries ( server, good );
+    check_refresh_garbage ( server, good );
+}
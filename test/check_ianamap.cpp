@@ -0,0 +1,100 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the \"Software\"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "check.hpp"
+
+#include "ianamap.hpp"
+#include "windowszones.hpp"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+[[nodiscard]] bool coded ( IanaMap const & map_, std::string_view const key_, std::string_view const name_,
+                           std::string_view const code_ ) {
+    return map_.contains ( key_ ) and name_ == map_.at ( key_ ).name and code_ == map_.at ( key_ ).code;
+}
+
+// The codes of repeated keys, as windowsZones.xml and Mapping.csv define them.
+void check_duplicate_codes ( ) {
+    IanaMapBuilder builder;
+    builder.insert ( "A/Once", "One", "US" );
+    builder.insert ( "A/Xml", "One", "US" );
+    builder.insert ( "A/Xml", "Two", "001" );
+    for ( std::string_view const code : { "001", "US" } ) // Inserted first as the world, then as a territory.
+        builder.insert ( "A/Csv_world_first", "One", code, duplicate_code_t::keep_territory );
+    for ( std::string_view const code : { "US", "001" } ) // A territory, then the world: keeps the territory.
+        builder.insert ( "A/Csv_world_last", "One", code, duplicate_code_t::keep_territory );
+    for ( std::string_view const code : { "US", "CA", "001" } ) // Two territories.
+        builder.insert ( "A/Csv_territories", "One", code, duplicate_code_t::keep_territory );
+    IanaMap const map = builder.build ( );
+    check ( 5u == map.size ( ) );
+    check ( coded ( map, "A/Once", "One", "US" ) );
+    check ( coded ( map, "A/Xml", "One", "001" ) );
+    check ( coded ( map, "A/Csv_world_first", "One", "001" ) );
+    check ( coded ( map, "A/Csv_world_last", "One", "US" ) );
+    check ( coded ( map, "A/Csv_territories", "One", "001" ) );
+}
+
+// An entry with a field too long for its byte of size is skipped, one at the limit is not.
+void check_long_fields ( ) {
+    std::string const at_limit ( IanaMapBuilder::max_field_size, 'x' ), over ( IanaMapBuilder::max_field_size + 1u, 'x' );
+    IanaMapBuilder builder;
+    builder.insert ( "A/Key", "One", "US" );
+    builder.insert ( over, "One", "US" );
+    builder.insert ( "A/Long_name", over, "US" );
+    builder.insert ( "A/Long_code", "One", over );
+    builder.insert ( at_limit, at_limit, at_limit );
+    IanaMap const map = builder.build ( );
+    check ( 2u == map.size ( ) );
+    check ( coded ( map, "A/Key", "One", "US" ) );
+    check ( coded ( map, at_limit, at_limit, at_limit ) );
+    check ( not map.contains ( over ) and not map.contains ( "A/Long_name" ) and not map.contains ( "A/Long_code" ) );
+}
+
+// The attributes, separated by any XML whitespace, with whitespace around the =, up to the first malformed one.
+void check_xml_attributes ( ) {
+    constexpr std::string_view element = "<mapZone\tother=\"One\"\r\n  territory = \"US\"\ntype=\n\"A/X A/Y\"/>";
+    check ( "One" == xml_attribute ( element, "other" ) );
+    check ( "US" == xml_attribute ( element, "territory" ) );
+    check ( "A/X A/Y" == xml_attribute ( element, "type" ) );
+    check ( xml_attribute ( "<mapZone other=One type=\"A/X\"/>", "type" ).empty ( ) );
+    check ( xml_attribute ( "<mapZone\t/>", "other" ).empty ( ) );
+    std::string_view const doc = "<mapTimezones>\n<mapZone\nother=\"One\"\tterritory=\"001\" type=\"A/X\"/>\n"
+                                 "<mapZone other = \"Two\" territory=\"US\"\ttype=\"A/Y A/Z\" />\n</mapTimezones>";
+    std::vector<map_zone_t> zones;
+    scan_map_zones ( doc, [ &zones ] ( map_zone_t const & zone_ ) { zones.push_back ( zone_ ); } );
+    check ( 2u == zones.size ( ) );
+    check ( "One" == zones[ 0 ].other and "001" == zones[ 0 ].territory and "A/X" == zones[ 0 ].type );
+    check ( "Two" == zones[ 1 ].other and "US" == zones[ 1 ].territory and "A/Y A/Z" == zones[ 1 ].type );
+}
+
+} // namespace
+
+void check_ianamap ( ) {
+    check_duplicate_codes ( );
+    check_long_fields ( );
+    check_xml_attributes ( );
+}
@@ -0,0 +1,132 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the \"Software\"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "check.hpp"
+
+#include "iso8601.hpp"
+
+#include <cstdint>
+
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+
+namespace {
+
+[[nodiscard]] std::optional<std::uint64_t> ticks ( std::optional<wintime_t> const t_ ) noexcept {
+    return t_ ? std::optional<std::uint64_t>{ t_->as_uint64 ( ) } : std::nullopt;
+}
+
+[[nodiscard]] std::uint64_t ticks_of ( int const y_, int const m_, int const d_, int const s_ = 0 ) noexcept {
+    return static_cast<std::uint64_t> ( ( days_from_civil ( y_, m_, d_ ) + days_from_winepoch_to_nix ) * ticks_per_day +
+                                        s_ * 10'000'000LL );
+}
+
+// The SWAR parser must agree with the char by char one on all it accepts, and accept all valid fixed layouts.
+void check_fast_against_slow ( ) {
+    std::mt19937_64 rng{ 20190822u };
+    auto const uniform = [ &rng ] ( int const lo_, int const hi_ ) {
+        return std::uniform_int_distribution<int>{ lo_, hi_ }( rng );
+    };
+    char buffer[ 32 ];
+    for ( int i = 0; i < 100'000; ++i ) {
+        int const layout = uniform ( 0, 3 );
+        int n = std::snprintf ( buffer, sizeof ( buffer ), "%04d-%02d-%02dT%02d:%02d:%02d", uniform ( 1601, 9999 ),
+                                uniform ( 1, 12 ), uniform ( 1, 28 ), uniform ( 0, 23 ), uniform ( 0, 59 ), uniform ( 0, 60 ) );
+        if ( layout & 1 )
+            n += std::snprintf ( buffer + n, sizeof ( buffer ) - n, ".%03d", uniform ( 0, 999 ) );
+        if ( layout & 2 )
+            n += std::snprintf ( buffer + n, sizeof ( buffer ) - n, "%c%02d:%02d", uniform ( 0, 1 ) ? '+' : '-', uniform ( 0, 23 ),
+                                 uniform ( 0, 59 ) );
+        else
+            buffer[ n++ ] = 'Z';
+        std::string s{ buffer, static_cast<std::size_t> ( n ) };
+        std::optional<std::uint64_t> const fast = ticks ( parse_wintime_fast ( s ) ), slow = ticks ( parse_wintime_slow ( s ) );
+        // Offsets can move the very first instants before 1601, then neither parses.
+        check ( fast == slow and ( fast or s.starts_with ( "1601-01-01T0" ) ) );
+        // Any char replaced, the layout or the fields may no longer be valid, but the parsers still agree.
+        s[ uniform ( 0, n - 1 ) ] = "0123456789-:.+TZz x"[ uniform ( 0, 18 ) ];
+        if ( std::optional<std::uint64_t> const f = ticks ( parse_wintime_fast ( s ) ); f )
+            check ( f == ticks ( parse_wintime_slow ( s ) ) );
+    }
+}
+
+void check_accepted ( ) {
+    check ( ticks ( parse_wintime ( "2019-08-22T13:41:12Z" ) ) == ticks_of ( 2019, 8, 22, 49'272 ) );
+    check ( ticks ( parse_wintime ( "2019-08-22" ) ) == ticks_of ( 2019, 8, 22 ) );
+    check ( ticks ( parse_wintime ( "2019-08-22 13:41:12" ) ) == ticks_of ( 2019, 8, 22, 49'272 ) );
+    check ( ticks ( parse_wintime ( "2019-08-22t13:41:12z" ) ) == ticks_of ( 2019, 8, 22, 49'272 ) );
+    check ( ticks ( parse_wintime ( "2019-08-22T13:41:12+02:00" ) ) == ticks_of ( 2019, 8, 22, 49'272 - 7'200 ) );
+    check ( ticks ( parse_wintime ( "2019-08-22T13:41:12-0230" ) ) == ticks_of ( 2019, 8, 22, 49'272 + 9'000 ) );
+    check ( ticks ( parse_wintime ( "2019-08-22T13:41:12+02" ) ) == ticks_of ( 2019, 8, 22, 49'272 - 7'200 ) );
+    // Fractions, up to a tick, the further digits ignored, ',' as well as '.'.
+    check ( ticks ( parse_wintime ( "2019-08-22T13:41:12.256Z" ) ) == ticks_of ( 2019, 8, 22, 49'272 ) + 2'560'000u );
+    check ( ticks ( parse_wintime ( "2019-08-22T13:41:12.5Z" ) ) == ticks_of ( 2019, 8, 22, 49'272 ) + 5'000'000u );
+    check ( ticks ( parse_wintime ( "2019-08-22T13:41:12,1234567899Z" ) ) == ticks_of ( 2019, 8, 22, 49'272 ) + 1'234'567u );
+    // Leap days, and a leap second rolls over.
+    check ( ticks ( parse_wintime ( "2000-02-29" ) ) == ticks_of ( 2000, 2, 29 ) );
+    check ( ticks ( parse_wintime ( "2016-02-29T00:00:00Z" ) ) == ticks_of ( 2016, 2, 29 ) );
+    check ( ticks ( parse_wintime ( "2016-12-31T23:59:60Z" ) ) == ticks_of ( 2017, 1, 1 ) );
+    check ( ticks ( parse_wintime ( "1601-01-01T00:00:00Z" ) ) == 0u );
+    check ( parse_nixtime ( "1970-01-01T00:00:00.5Z" ) == 0 and parse_nixtime ( "1969-12-31T23:59:59.5Z" ) == -1 );
+}
+
+void check_rejected ( ) {
+    for ( std::string_view const s : {
+              // Dates.
+              "2019-00-22", "2019-13-22", "2019-08-00", "2019-08-32", "2019-04-31T00:00:00Z", "2019-02-29", "1900-02-29T00:00:00Z",
+              "2100-02-29", "2019-8-22", "19-08-22", "2019/08/22", "2019-08-22T", "2019-08-22X13:41:12Z", "",
+              // Times.
+              "2019-08-22T24:00:00Z", "2019-08-22T13:60:00Z", "2019-08-22T13:41:61Z", "2019-08-22T13:41Z", "2019-08-22T1:41:12Z",
+              // Offsets.
+              "2019-08-22T13:41:12+24:00", "2019-08-22T13:41:12+02:60", "2019-08-22T13:41:12+2:00", "2019-08-22T13:41:12+02:0",
+              "2019-08-22T13:41:12+02:000", "2019-08-22T13:41:12*02:00", "2019-08-22T13:41:12+", "2019-08-22T13:41:12ZZ",
+              "2019-08-22T13:41:12Z+02:00",
+              // Fractions.
+              "2019-08-22T13:41:12.Z", "2019-08-22T13:41:12.", "2019-08-22T13:41:12.25x", "2019-08-22T13:41:12.2.5Z",
+              "2019-08-22T13:41:12.+02:00", "2019-08-22T13:41:12.2a6Z",
+              // Before 1601.
+              "1600-12-31T23:59:59Z", "1601-01-01T00:00:00+00:01" } ) {
+        check ( not parse_wintime ( s ) );
+        check ( not parse_wintime_fast ( s ) );
+    }
+    check ( parse_nixtime ( "1600-12-31T23:59:59Z" ).has_value ( ) and not parse_nixtime ( "2019-02-29" ) );
+}
+
+void check_bulk ( ) {
+    std::string_view const in[]{ "2019-08-22T13:41:12Z", "2019-02-29", "2019-08-22" };
+    wintime_t out[ 3 ]{ };
+    bool ok[ 3 ];
+    check ( 1u == parse_wintime ( in, out, ok ) and ok[ 0 ] and not ok[ 1 ] and ok[ 2 ] );
+    check ( 0u == out[ 1 ].as_uint64 ( ) and ticks_of ( 2019, 8, 22 ) == out[ 2 ].as_uint64 ( ) );
+}
+
+} // namespace
+
+void check_iso8601 ( ) {
+    check_fast_against_slow ( );
+    check_accepted ( );
+    check_rejected ( );
+    check_bulk ( );
+}
@@ -0,0 +1,135 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the \"Software\"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "check.hpp"
+
+#include "published.hpp"
+#include "timezoneinfo.hpp"
+
+#include <cstddef>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// An object that knows whether it was deleted while pinned.
+struct object_t {
+    int value;
+    std::atomic<int> * deleted;
+
+    ~object_t ( ) noexcept { deleted->fetch_add ( 1, std::memory_order_relaxed ); }
+};
+
+[[nodiscard]] std::unique_ptr<object_t const> make_object ( int const value_, std::atomic<int> & deleted_ ) {
+    return std::unique_ptr<object_t const> ( new object_t{ value_, &deleted_ } );
+}
+
+// Nested pins, more than there are slots, grow the slots, each pin keeps the object it pinned.
+void check_published_nested ( ) {
+    std::atomic<int> deleted = 0;
+    object_t const initial{ 0, &deleted };
+    {
+        published_t<object_t, 4u> published{ &initial };
+        std::vector<published_t<object_t, 4u>::pin_t> pins;
+        for ( int i = 1; i <= 13; ++i ) {
+            pins.push_back ( published.pin ( ) );
+            published.publish ( make_object ( i, deleted ) );
+        }
+        bool kept = true;
+        for ( int i = 0; i < 13; ++i )
+            kept = kept and i == pins[ i ]->value;
+        check ( kept );
+        check ( 0 == deleted.load ( ) );
+        check ( not published.collect ( ) );
+        while ( pins.size ( ) > 1u )
+            pins.pop_back ( );
+        check ( published.collect ( ) );
+        check ( 12 == deleted.load ( ) );
+        check ( 13 == published.pin ( )->value );
+    }
+    check ( 13 == deleted.load ( ) ); // And the initial object is not deleted.
+}
+
+// Readers pin, nested, as a writer publishes: a pinned object is never deleted.
+void check_published_concurrent ( ) {
+    std::atomic<int> deleted = 0;
+    object_t const initial{ 0, &deleted };
+    published_t<object_t, 2u> published{ &initial };
+    std::atomic<bool> stop = false, torn = false;
+    std::vector<std::jthread> readers;
+    for ( int r = 0; r < 4; ++r )
+        readers.emplace_back ( [ & ] {
+            while ( not stop.load ( std::memory_order_relaxed ) ) {
+                auto const outer = published.pin ( );
+                int const value  = outer->value;
+                auto const inner = published.pin ( );
+                if ( inner->value < value or outer->value != value )
+                    torn.store ( true, std::memory_order_relaxed );
+            }
+        } );
+    for ( int i = 1; i <= 20'000; ++i )
+        published.publish ( make_object ( i, deleted ) );
+    stop.store ( true, std::memory_order_relaxed );
+    readers.clear ( );
+    check ( not torn.load ( ) );
+    check ( published.collect ( ) );
+}
+
+// The repository copy of windowsZones.xml, as a file:// URL.
+[[nodiscard]] std::string windowszones_url ( ) {
+    std::string const name = ( source_dir ( ) / "windowsZones.xml" ).generic_string ( );
+    return ( '/' == name.front ( ) ? "file://" : "file:///" ) + name;
+}
+
+// A refresh from a local copy, due as it was never checked: the file is fetched, parsed, recorded and published, the
+// cached zones keep their ids.
+void check_published_refresh ( ) {
+    zone_id_t const id = lookup ( "America/New_York" );
+    set_source_url ( snapshot_source_t::windowszones, windowszones_url ( ) );
+    for ( char const * const key : { "last_windowszones_download", "last_windowszones_check", "windowszones_last_modified" } )
+        set_timestamp ( key, 0u );
+    save_timestamps ( );
+    init ( );
+    await_refresh ( );
+    Timestamps const stamps = timestamps ( );
+    check ( stamps.at ( "last_windowszones_download" ) and stamps.at ( "last_windowszones_check" ) );
+    {
+        zone_data_pin_t const data = zone_data ( );
+        check ( data->map.contains ( "America/New_York" ) and "Eastern Standard Time" == data->map.at ( "America/New_York" ).name );
+        check ( not data->snapshot.is_open ( ) or snapshot_source_t::windowszones == data->snapshot.source ( ) );
+    }
+    if ( check ( static_cast<bool> ( id ) ) )
+        check ( lookup ( "America/New_York" ) == id and "America/New_York" == get_name ( id ) );
+}
+
+} // namespace
+
+void check_published ( ) {
+    check_published_nested ( );
+    check_published_concurrent ( );
+    check_published_refresh ( );
+}
@@ -0,0 +1,162 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the \"Software\"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "check.hpp"
+
+#include "ianamap.hpp"
+#include "snapshot.hpp"
+#include "zone.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <string_view>
+#include <vector>
+
+#include <zlib.h>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+zone_rule_t const new_york{ -5 * 3'600, -4 * 3'600, { 3, 2, 0, 2 * 3'600 }, { 11, 1, 0, 2 * 3'600 } };
+zone_rule_t const sydney{ 10 * 3'600, 11 * 3'600, { 10, 1, 0, 2 * 3'600 }, { 4, 1, 0, 3 * 3'600 } };
+
+[[nodiscard]] tzi_t tzi_of ( std::string_view const name_ ) noexcept {
+    return "Eastern Standard Time" == name_ ? make_tzi ( new_york ) : make_tzi ( sydney );
+}
+
+[[nodiscard]] std::vector<char> read ( fs::path const & path_ ) {
+    std::ifstream in ( path_, std::ios::binary );
+    return { std::istreambuf_iterator<char> ( in ), std::istreambuf_iterator<char> ( ) };
+}
+
+void write ( fs::path const & path_, std::vector<char> const & bytes_ ) {
+    std::ofstream out ( path_, std::ios::binary | std::ios::trunc );
+    out.write ( bytes_.data ( ), static_cast<std::streamsize> ( bytes_.size ( ) ) );
+}
+
+[[nodiscard]] snapshot_header_t & header ( std::vector<char> & bytes_ ) noexcept {
+    return *reinterpret_cast<snapshot_header_t *> ( bytes_.data ( ) );
+}
+
+// The checksum of what follows the header, as the snapshot computes it, to forge a corrupt but consistent file.
+void seal ( std::vector<char> & bytes_ ) noexcept {
+    std::size_t const n = sizeof ( snapshot_header_t );
+    header ( bytes_ ).checksum =
+        static_cast<std::uint32_t> ( crc32 ( 0uL, reinterpret_cast<Bytef const *> ( bytes_.data ( ) + n ),
+                                             static_cast<uInt> ( bytes_.size ( ) - n ) ) );
+}
+
+// Whether the snapshot of bytes_, patched by patch_, (re)sealed if seal_, is rejected.
+[[nodiscard]] bool rejected ( fs::path const & path_, std::vector<char> bytes_,
+                              std::function<void ( std::vector<char> & )> const & patch_, bool const seal_ = true ) {
+    patch_ ( bytes_ );
+    if ( seal_ )
+        seal ( bytes_ );
+    write ( path_, bytes_ );
+    return not snapshot_t{ path_ }.is_open ( );
+}
+
+void check_snapshot_round_trip ( fs::path const & path_ ) {
+    IanaMapBuilder builder;
+    builder.insert ( "America/New_York", "Eastern Standard Time", "001" );
+    builder.insert ( "America/Detroit", "Eastern Standard Time", "US" );
+    builder.insert ( "Australia/Sydney", "AUS Eastern Standard Time", "001" );
+    IanaMap const map = builder.build ( );
+    check ( write_snapshot ( path_, map, tzi_of, snapshot_source_t::windowszones_alt, 123u, 456u ) );
+    snapshot_t const snapshot ( path_ );
+    if ( not check ( snapshot.is_open ( ) ) )
+        return;
+    check ( snapshot_source_t::windowszones_alt == snapshot.source ( ) );
+    check ( 123u == snapshot.source_time ( ) and 456u == snapshot.tzi_version ( ) );
+    check ( 3u == snapshot.map ( ).size ( ) and 2u == snapshot.tzis ( ).size ( ) and 2u == snapshot.rules ( ).size ( ) );
+    for ( auto const & [ key, value ] : map ) {
+        check ( snapshot.map ( ).contains ( key ) and value.name == snapshot.map ( ).at ( key ).name and
+                value.code == snapshot.map ( ).at ( key ).code );
+        tzi_t const * const tzi = snapshot.find_tzi ( key );
+        tzi_t const expected    = tzi_of ( value.name );
+        check ( tzi and 0 == std::memcmp ( tzi, &expected, sizeof ( tzi_t ) ) );
+    }
+    check ( not snapshot.find_tzi ( "Europe/Paris" ) );
+    check ( new_york == snapshot.rules ( )[ snapshot.zones ( )[ snapshot.map ( ).index ( "America/Detroit" ) ] ] );
+}
+
+// A snapshot that is not what it says it is, truncated, damaged, or forged with a valid checksum, is not opened.
+void check_snapshot_rejects ( fs::path const & path_ ) {
+    std::vector<char> const bytes = read ( path_ );
+    if ( not check ( bytes.size ( ) > sizeof ( snapshot_header_t ) ) )
+        return;
+    snapshot_header_t const h   = *reinterpret_cast<snapshot_header_t const *> ( bytes.data ( ) );
+    std::size_t const entries   = ( sizeof ( snapshot_header_t ) + 7u ) & ~std::size_t{ 7u };
+    std::size_t const arena     = bytes.size ( ) - h.arena_size;
+    auto const entry            = [ entries ] ( std::vector<char> & b_, std::size_t const i_ ) -> IanaMapEntry & {
+        return reinterpret_cast<IanaMapEntry *> ( b_.data ( ) + entries )[ i_ ];
+    };
+    check ( not snapshot_t{ path_.parent_path ( ) / "absent.snapshot" }.is_open ( ) );
+    check ( rejected ( path_, { bytes.begin ( ), bytes.begin ( ) + 16 }, [ ] ( auto & ) {}, false ) );
+    check ( rejected ( path_, bytes, [ ] ( auto & b_ ) { b_.pop_back ( ); }, false ) );
+    check ( rejected ( path_, bytes, [ ] ( auto & b_ ) { b_.push_back ( 0 ); }, false ) );
+    check ( rejected ( path_, bytes, [ arena ] ( auto & b_ ) { b_[ arena ] ^= 1; }, false ) );
+    check ( rejected ( path_, bytes, [ ] ( auto & b_ ) { header ( b_ ).version = 1u; } ) );
+    check ( rejected ( path_, bytes, [ ] ( auto & b_ ) { header ( b_ ).entry_count = UINT32_MAX; } ) );
+    check ( rejected ( path_, bytes, [ ] ( auto & b_ ) { header ( b_ ).arena_size += 8u; } ) );
+    check ( rejected ( path_, bytes, [ ] ( auto & b_ ) { header ( b_ ).displacement_count -= 1u; } ) );
+    check ( rejected ( path_, bytes, [ ] ( auto & b_ ) { header ( b_ ).zone_count = UINT32_MAX; } ) );
+    // Offsets, indices and rules in the sections, with a checksum to match.
+    check ( rejected ( path_, bytes, [ &h, &entry ] ( auto & b_ ) { entry ( b_, 0u ).key = h.arena_size; } ) );
+    check ( rejected ( path_, bytes, [ &h, &entry ] ( auto & b_ ) { entry ( b_, 1u ).code = h.arena_size - 1u; } ) );
+    check ( rejected ( path_, bytes, [ &entry ] ( auto & b_ ) { entry ( b_, 2u ).name = UINT32_MAX; } ) );
+    std::size_t const d     = entries + h.entry_count * sizeof ( IanaMapEntry );
+    std::size_t const slots = ( d + h.displacement_count * sizeof ( std::uint32_t ) + 7u ) & ~std::size_t{ 7u };
+    std::size_t const zones = ( slots + h.entry_count * sizeof ( std::uint16_t ) + 7u ) & ~std::size_t{ 7u };
+    std::size_t const tzis  = ( zones + h.entry_count * sizeof ( std::uint16_t ) + 7u ) & ~std::size_t{ 7u };
+    std::size_t const rules = ( tzis + h.zone_count * sizeof ( tzi_t ) + 7u ) & ~std::size_t{ 7u };
+    auto const u16          = [ ] ( std::vector<char> & b_, std::size_t const o_ ) -> std::uint16_t & {
+        return *reinterpret_cast<std::uint16_t *> ( b_.data ( ) + o_ );
+    };
+    check ( rejected ( path_, bytes, [ &h, slots, &u16 ] ( auto & b_ ) { u16 ( b_, slots ) = h.entry_count; } ) );
+    check ( rejected ( path_, bytes, [ &h, zones, &u16 ] ( auto & b_ ) { u16 ( b_, zones ) = h.zone_count; } ) );
+    check ( rejected ( path_, bytes, [ rules ] ( auto & b_ ) {
+        reinterpret_cast<zone_rule_t *> ( b_.data ( ) + rules )->dst_start.month = 13;
+    } ) );
+    check ( rejected ( path_, bytes, [ rules ] ( auto & b_ ) {
+        reinterpret_cast<zone_rule_t *> ( b_.data ( ) + rules )->std_offset += 60;
+    } ) );
+    // Resealed, but otherwise untouched, it is the snapshot it was.
+    check ( not rejected ( path_, bytes, [ ] ( auto & ) {} ) );
+}
+
+} // namespace
+
+void check_snapshot ( ) {
+    fs::path const path = fs::temp_directory_path ( ) / "timezoneinfo_check.snapshot";
+    check_snapshot_round_trip ( path );
+    check_snapshot_rejects ( path );
+    std::error_code ec;
+    fs::remove ( path, ec );
+}
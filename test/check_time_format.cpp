@@ -0,0 +1,239 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the \"Software\"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "check.hpp"
+
+#include "time_format.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+// The cached format against a full format of each instant, on instants in the same minute (which rewrite the second and
+// millisecond digits only) and on instants of other minutes, of patterns with none, one and several such fields.
+void check_cached_time_format ( ) {
+    constexpr std::uint64_t ticks_per_ms = 10'000u, ticks_per_minute = 60'000u * ticks_per_ms;
+    std::mt19937_64 rng{ 2019u };
+    std::uniform_int_distribution<std::uint64_t> dist{ 0u, 60'000u * ticks_per_minute };
+    for ( std::string_view const pattern : { systime_pattern, std::string_view{ "%S %T.%f|%f %S" }, std::string_view{ "%F %R" },
+                                             std::string_view{ "%f%f%S%S" } } ) {
+        time_format_t const format{ pattern };
+        cached_time_format_t cached{ pattern };
+        char buffer[ time_format_t::max_output ];
+        wintime_t wt;
+        wt.as_uint64 ( ) = nixtime_to_wintime ( 1'566'481'272 ).as_uint64 ( ); // Thu Aug 22 13:41:12 2019.
+        bool ok          = true;
+        for ( int i = 0; i < 100'000; ++i ) {
+            // Mostly a few ms on, in the same minute, sometimes a jump.
+            wt.as_uint64 ( ) += i % 97 ? ( dist ( rng ) % 4'000u ) * ticks_per_ms : dist ( rng );
+            std::string_view const expected{ buffer, static_cast<std::size_t> (
+                                                         format.format_to ( buffer, wintime_to_systime ( wt ) ) - buffer ) };
+            ok = ok and expected == cached.format ( wt );
+        }
+        check ( ok );
+    }
+    cached_time_format_t cached{ "%S.%f %S.%f" };
+    wintime_t wt = nixtime_to_wintime ( 1'566'481'272 );
+    check ( "12.000 12.000" == cached.format ( wt ) );
+    wt.as_uint64 ( ) += 253'210'000u; // 25.321 s.
+    check ( "37.321 37.321" == cached.format ( wt ) );
+}
+
+[[nodiscard]] systime_t make_systime ( int const y_, int const m_, int const d_, int const dow_, int const h_, int const mi_,
+                                       int const s_, int const ms_ ) noexcept {
+    systime_t st{ };
+    st.wYear         = static_cast<std::uint16_t> ( y_ );
+    st.wMonth        = static_cast<std::uint16_t> ( m_ );
+    st.wDay          = static_cast<std::uint16_t> ( d_ );
+    st.wDayOfWeek    = static_cast<std::uint16_t> ( dow_ );
+    st.wHour         = static_cast<std::uint16_t> ( h_ );
+    st.wMinute       = static_cast<std::uint16_t> ( mi_ );
+    st.wSecond       = static_cast<std::uint16_t> ( s_ );
+    st.wMilliseconds = static_cast<std::uint16_t> ( ms_ );
+    return st;
+}
+
+[[nodiscard]] std::uint64_t ticks_of ( systime_t const & systime_ ) noexcept {
+    return systime_to_wintime ( systime_ ).as_uint64 ( );
+}
+
+[[nodiscard]] std::string formatted ( std::string_view const pattern_, systime_t const & systime_ ) {
+    time_format_t const format{ pattern_ };
+    char buffer[ time_format_t::max_output ];
+    return { buffer, format.format_to ( buffer, systime_ ) };
+}
+
+// The text of the C library, in the "C" locale.
+[[nodiscard]] std::string strftime_of ( std::string const & pattern_, systime_t const & systime_ ) {
+    std::tm tm{ };
+    tm.tm_year = systime_.wYear - 1'900;
+    tm.tm_mon  = systime_.wMonth - 1;
+    tm.tm_mday = systime_.wDay;
+    tm.tm_hour = systime_.wHour;
+    tm.tm_min  = systime_.wMinute;
+    tm.tm_sec  = systime_.wSecond;
+    tm.tm_wday = systime_.wDayOfWeek;
+    tm.tm_yday = static_cast<int> ( days_from_civil ( systime_.wYear, systime_.wMonth, systime_.wDay ) -
+                                    days_from_civil ( systime_.wYear, 1, 1 ) );
+    char buffer[ 256 ];
+    return { buffer, std::strftime ( buffer, sizeof ( buffer ), pattern_.c_str ( ), &tm ) };
+}
+
+// The specifiers strftime has, alone and 4 to a pattern (with text in between), against strftime, on instants over
+// [ 1601, 9999 ] (the years the C library of MSVC takes).
+void check_strftime_specifiers ( ) {
+    constexpr std::string_view specifiers = "YymdejHIpMSaAbBwuFTRnt%";
+    std::vector<std::string> patterns, groups;
+    for ( std::size_t i = 0u; i < specifiers.size ( ); ++i ) {
+        patterns.push_back ( std::string{ '%', specifiers[ i ] } );
+        if ( not( i % 4u ) )
+            groups.emplace_back ( "<" );
+        groups.back ( ) += patterns.back ( ) + "| ";
+    }
+    patterns.insert ( patterns.end ( ), groups.begin ( ), groups.end ( ) );
+    std::mt19937_64 rng{ 1601u };
+    std::uniform_int_distribution<std::uint64_t> dist{ 0u, ticks_of ( make_systime ( 10'000, 1, 1, 6, 0, 0, 0, 0 ) ) - 1u };
+    bool ok = true;
+    for ( int i = 0; i < 20'000; ++i ) {
+        wintime_t wt;
+        wt.as_uint64 ( ) = dist ( rng );
+        systime_t const st = wintime_to_systime ( wt );
+        for ( std::string const & pattern : patterns )
+            ok = ok and strftime_of ( pattern, st ) == formatted ( pattern, st );
+    }
+    check ( ok );
+}
+
+// Every specifier, %f and the 5-digit years included, against the expected text.
+void check_expected_specifiers ( ) {
+    struct expected_t {
+        std::string_view pattern, a, b, c;
+    };
+    // Thu 2019-08-22 13:41:12.256, Fri 1601-01-05 00:07:09.045 and Fri 30827-12-31 12:59:59.999.
+    systime_t const a = make_systime ( 2019, 8, 22, 4, 13, 41, 12, 256 ), b = make_systime ( 1601, 1, 5, 5, 0, 7, 9, 45 ),
+                    c = make_systime ( 30'827, 12, 31, 5, 12, 59, 59, 999 );
+    constexpr expected_t expected[]{
+        { "%Y", "2019", "1601", "30827" },
+        { "%y", "19", "01", "27" },
+        { "%m", "08", "01", "12" },
+        { "%d", "22", "05", "31" },
+        { "%e", "22", " 5", "31" },
+        { "%j", "234", "005", "365" },
+        { "%H", "13", "00", "12" },
+        { "%I", "01", "12", "12" },
+        { "%p", "PM", "AM", "PM" },
+        { "%M", "41", "07", "59" },
+        { "%S", "12", "09", "59" },
+        { "%f", "256", "045", "999" },
+        { "%a", "Thu", "Fri", "Fri" },
+        { "%A", "Thursday", "Friday", "Friday" },
+        { "%b", "Aug", "Jan", "Dec" },
+        { "%B", "August", "January", "December" },
+        { "%w", "4", "5", "5" },
+        { "%u", "4", "5", "5" },
+        { "%F", "2019-08-22", "1601-01-05", "30827-12-31" },
+        { "%T", "13:41:12", "00:07:09", "12:59:59" },
+        { "%R", "13:41", "00:07", "12:59" },
+        { "%n%t%%", "\n\t%", "\n\t%", "\n\t%" },
+        { "%q %", "%q %", "%q %", "%q %" }, // Not a specifier, copied as is.
+        { systime_pattern, "Thu Aug 22 13:41:12.256 2019", "Fri Jan  5 00:07:09.045 1601", "Fri Dec 31 12:59:59.999 30827" },
+    };
+    for ( expected_t const & e : expected )
+        check ( e.a == formatted ( e.pattern, a ) and e.b == formatted ( e.pattern, b ) and e.c == formatted ( e.pattern, c ) );
+}
+
+// No output is longer than max_size ( ), nor is anything written beyond it, over the whole range of a systime_t, on
+// patterns of the widest fields.
+void check_max_size ( ) {
+    systime_t const widest = make_systime ( 30'827, 9, 27, 3, 0, 0, 0, 0 ); // Wednesday September 30827.
+    std::mt19937_64 rng{ 30'827u };
+    std::uniform_int_distribution<std::uint64_t> dist{ 0u, ticks_of ( make_systime ( 30'827, 12, 31, 5, 23, 59, 59, 999 ) ) };
+    bool ok = true;
+    for ( std::string_view const pattern : { systime_pattern, std::string_view{ "%A %B %e %Y %j %f %p %F %T" },
+                                             std::string_view{ "%A%A%B%B%Y%Y%Y" }, std::string_view{ "%n%%%t" } } ) {
+        time_format_t const format{ pattern };
+        std::size_t const size = format.max_size ( );
+        ok = ok and size <= time_format_t::max_output;
+        for ( int i = 0; i < 20'000; ++i ) {
+            wintime_t wt;
+            wt.as_uint64 ( ) = i ? dist ( rng ) : ticks_of ( widest );
+            char buffer[ time_format_t::max_output + 16u ];
+            std::fill ( std::begin ( buffer ), std::end ( buffer ), '#' );
+            char const * const end = format.format_to ( buffer, wintime_to_systime ( wt ) );
+            ok = ok and end <= buffer + size and
+                 std::all_of ( buffer + size, std::end ( buffer ), [] ( char const c_ ) { return '#' == c_; } );
+        }
+    }
+    check ( ok );
+    // The widest text reaches it.
+    check ( formatted ( "%A %B %Y", widest ).size ( ) == time_format_t{ "%A %B %Y" }.max_size ( ) );
+}
+
+[[nodiscard]] bool throws ( std::string const & pattern_ ) {
+    try {
+        time_format_t const format{ pattern_ };
+    }
+    catch ( std::invalid_argument const & ) {
+        return true;
+    }
+    return false;
+}
+
+// A pattern of up to max_ops ops and max_text literal chars compiles, one more of either throws.
+void check_limits ( ) {
+    auto const repeat = [] ( std::string_view const s_, std::size_t const n_ ) {
+        std::string r;
+        for ( std::size_t i = 0u; i < n_; ++i )
+            r += s_;
+        return r;
+    };
+    check ( not throws ( repeat ( "%S", time_format_t::max_ops ) ) );
+    check ( throws ( repeat ( "%S", time_format_t::max_ops + 1u ) ) );
+    check ( not throws ( repeat ( "%S-", time_format_t::max_ops / 2u ) ) );
+    check ( throws ( repeat ( "%S-", time_format_t::max_ops / 2u ) + "%S" ) );
+    check ( throws ( repeat ( "%F", 7u ) ) ); // 5 ops each.
+    check ( not throws ( std::string ( time_format_t::max_text, 'x' ) ) );
+    check ( throws ( std::string ( time_format_t::max_text + 1u, 'x' ) ) );
+    check ( throws ( std::string ( 40u, 'x' ) + "%S" + std::string ( time_format_t::max_text - 39u, 'x' ) ) );
+    check ( throws ( repeat ( "%%", time_format_t::max_text + 1u ) ) );
+}
+
+} // namespace
+
+void check_time_format ( ) {
+    check_strftime_specifiers ( );
+    check_expected_specifiers ( );
+    check_max_size ( );
+    check_limits ( );
+    check_cached_time_format ( );
+}
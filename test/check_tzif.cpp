@@ -0,0 +1,163 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the \"Software\"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "check.hpp"
+
+#include "tzif.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr std::int64_t hour = 3'600LL * 10'000'000LL; // Ticks.
+
+// The ticks since 1601 at y_-m_-d_ h_:00 UTC.
+[[nodiscard]] constexpr std::int64_t ticks ( int const y_, int const m_, int const d_, int const h_ = 0 ) noexcept {
+    return ( days_from_civil ( y_, m_, d_ ) + days_from_winepoch_to_nix ) * ticks_per_day + h_ * hour;
+}
+
+// The fixtures, copies of the TZif files of tzdata 2025b, in test/tzif.
+[[nodiscard]] std::vector<std::byte> fixture ( std::string_view const iana_ ) {
+    fs::path const path = source_dir ( ) / "test" / "tzif" / iana_;
+    std::ifstream in ( path, std::ios::binary );
+    std::vector<char> const bytes{ std::istreambuf_iterator<char> ( in ), std::istreambuf_iterator<char> ( ) };
+    return { reinterpret_cast<std::byte const *> ( bytes.data ( ) ),
+             reinterpret_cast<std::byte const *> ( bytes.data ( ) + bytes.size ( ) ) };
+}
+
+[[nodiscard]] std::uint32_t be32 ( std::byte const * const p_ ) noexcept {
+    return static_cast<std::uint32_t> ( p_[ 0 ] ) << 24 | static_cast<std::uint32_t> ( p_[ 1 ] ) << 16 |
+           static_cast<std::uint32_t> ( p_[ 2 ] ) << 8 | static_cast<std::uint32_t> ( p_[ 3 ] );
+}
+
+void check_tzif_fixtures ( ) {
+    std::vector<std::byte> const bytes = fixture ( "America/New_York" );
+    if ( not check ( bytes.size ( ) > 44u ) )
+        return;
+    if ( std::optional<tzif_t> const ny = parse_tzif ( bytes ); check ( ny.has_value ( ) ) ) {
+        check ( zone_rule_t{ -5 * 3'600, -4 * 3'600, { 3, 2, 0, 7'200 }, { 11, 1, 0, 7'200 } } == ny->zone.rule ( ) );
+        check ( "EST" == ny->std_name and "EDT" == ny->dst_name );
+        check ( -( 4 * 3'600 + 56 * 60 + 2 ) * 10'000'000LL == ny->zone.offset ( ticks ( 1850, 1, 1 ) ) ); // LMT.
+        check ( -4 * hour == ny->zone.offset ( ticks ( 1950, 7, 1 ) ) );
+        check ( -5 * hour == ny->zone.offset ( ticks ( 2021, 1, 1 ) ) );
+        check ( -4 * hour == ny->zone.offset ( ticks ( 2021, 7, 1 ) ) );
+        check ( -4 * hour == ny->zone.offset ( ticks ( 2021, 3, 14, 7 ) ) ); // 02:00 EST.
+        check ( -5 * hour == ny->zone.offset ( ticks ( 2021, 3, 14, 7 ) - 1 ) );
+        check ( -4 * hour == ny->zone.offset ( ticks ( 2300, 7, 1 ) ) ); // Beyond the table, the footer.
+    }
+    if ( std::optional<tzif_t> const sydney = parse_tzif ( fixture ( "Australia/Sydney" ) ); check ( sydney.has_value ( ) ) ) {
+        check ( zone_rule_t{ 10 * 3'600, 11 * 3'600, { 10, 1, 0, 7'200 }, { 4, 1, 0, 10'800 } } == sydney->zone.rule ( ) );
+        check ( 11 * hour == sydney->zone.offset ( ticks ( 2021, 1, 1 ) ) );
+        check ( 10 * hour == sydney->zone.offset ( ticks ( 2021, 7, 1 ) ) );
+    }
+    if ( std::optional<tzif_t> const tehran = parse_tzif ( fixture ( "Asia/Tehran" ) ); check ( tehran.has_value ( ) ) ) {
+        check ( not tehran->zone.rule ( ).has_dst ( ) and 12'600 == tehran->zone.rule ( ).std_offset );
+        check ( "+0330" == tehran->std_name and tehran->dst_name.empty ( ) );
+        check ( 45 * hour / 10 == tehran->zone.offset ( ticks ( 2008, 7, 1 ) ) ); // Daylight time, abolished in 2022.
+        check ( 35 * hour / 10 == tehran->zone.offset ( ticks ( 2023, 7, 1 ) ) );
+    }
+    if ( std::optional<tzif_t> const utc = parse_tzif ( fixture ( "Etc/UTC" ) ); check ( utc.has_value ( ) ) ) {
+        check ( zone_rule_t{ } == utc->zone.rule ( ) and "UTC" == utc->std_name );
+        check ( 0 == utc->zone.offset ( ticks ( 1700, 1, 1 ) ) and 0 == utc->zone.offset ( ticks ( 2021, 7, 1 ) ) );
+    }
+    // Damaged files.
+    auto const parses = [ &bytes ] ( std::size_t const size_, auto const & patch_ ) {
+        std::vector<std::byte> b{ bytes.begin ( ), bytes.begin ( ) + static_cast<std::ptrdiff_t> ( size_ ) };
+        patch_ ( b );
+        return parse_tzif ( b ).has_value ( );
+    };
+    auto const none = [ ] ( std::vector<std::byte> & ) {};
+    check ( not parse_tzif ( { } ) );
+    check ( not parses ( 43u, none ) and not parses ( 44u, none ) and not parses ( bytes.size ( ) / 2u, none ) );
+    check ( not parses ( bytes.size ( ), [ ] ( auto & b_ ) { b_[ 3 ] = std::byte{ 'F' }; } ) );
+    // A time type index out of range, the first of the 64-bit data.
+    std::size_t const v1 = 44u + std::size_t{ be32 ( &bytes[ 32 ] ) } * 5u + std::size_t{ be32 ( &bytes[ 36 ] ) } * 6u +
+                           be32 ( &bytes[ 40 ] ) + std::size_t{ be32 ( &bytes[ 28 ] ) } * 8u + be32 ( &bytes[ 24 ] ) +
+                           be32 ( &bytes[ 20 ] );
+    std::size_t const types = v1 + 44u + std::size_t{ be32 ( &bytes[ v1 + 32u ] ) } * 8u;
+    std::byte const typecnt{ static_cast<unsigned char> ( be32 ( &bytes[ v1 + 36u ] ) ) };
+    check ( parses ( bytes.size ( ), none ) );
+    check ( not parses ( bytes.size ( ), [ types, typecnt ] ( auto & b_ ) { b_[ types ] = typecnt; } ) );
+}
+
+void check_posix_tz ( ) {
+    auto const rule = [ ] ( std::string_view const tz_ ) {
+        std::optional<posix_tz_t> const tz = parse_posix_tz ( tz_ );
+        return tz ? tz->rule : zone_rule_t{ -1, -1, { }, { } };
+    };
+    check ( zone_rule_t{ -5 * 3'600, -4 * 3'600, { 3, 2, 0, 7'200 }, { 11, 1, 0, 7'200 } } == rule ( "EST5EDT,M3.2.0,M11.1.0" ) );
+    check ( rule ( "EST5EDT,M3.2.0,M11.1.0" ) == rule ( "EST5EDT" ) ); // The default, the US rules.
+    check ( zone_rule_t{ 12'600, 12'600, { }, { } } == rule ( "<+0330>-3:30" ) );
+    check ( zone_rule_t{ 45'900, 49'500, { 9, 5, 0, 9'900 }, { 4, 1, 0, 13'500 } } ==
+            rule ( "<+1245>-12:45<+1345>,M9.5.0/2:45,M4.1.0/3:45" ) );
+    check ( zone_rule_t{ 7'200, 10'800, { 3, 4, 4, 93'600 }, { 10, 5, 0, 7'200 } } == rule ( "IST-2IDT,M3.4.4/26,M10.5.0" ) );
+    check ( zone_rule_t{ -10'800, -7'200, { 3, 5, 0, -7'200 }, { 10, 5, 0, -3'600 } } ==
+            rule ( "<-03>3<-02>,M3.5.0/-2,M10.5.0/-1" ) );
+    if ( std::optional<posix_tz_t> const tz = parse_posix_tz ( "<+0330>-3:30<+0430>,J79/24,J263/24" ); check ( tz.has_value ( ) ) )
+        check ( "+0330" == tz->std_name and "+0430" == tz->dst_name );
+    // Jn, the same date every year, February 29 is not counted.
+    zone_rule_t const j = rule ( "XXX3YYY,J60/2,J300" );
+    check ( -60 == j.dst_start.day and -300 == j.dst_end.day and j.has_dst ( ) );
+    check ( 3 == j.dst_start.month and 1 == j.dst_start.week and 4 == j.dst_start.day_of_week ); // 2001-03-01, a Thursday.
+    for ( int const y : { 2023, 2024 } ) {
+        check ( ticks ( y, 3, 1, 2 + 3 ) == j.dst_start_utc ( y ) );
+        check ( ticks ( y, 10, 27, 2 + 2 ) == j.dst_end_utc ( y ) );
+    }
+    zone_t const zone = zone_t::from_rule ( j );
+    check ( -2 * hour == zone.offset ( ticks ( 2024, 3, 1, 5 ) ) and -3 * hour == zone.offset ( ticks ( 2024, 3, 1, 5 ) - 1 ) );
+    // n, zero based, February 29 is counted.
+    zone_rule_t const n = rule ( "XXX3YYY,59,299/0" );
+    check ( 60 == n.dst_start.day and 300 == n.dst_end.day );
+    check ( ticks ( 2024, 2, 29, 2 + 3 ) == n.dst_start_utc ( 2024 ) and ticks ( 2023, 3, 1, 2 + 3 ) == n.dst_start_utc ( 2023 ) );
+    check ( ticks ( 2024, 10, 26, 0 + 2 ) == n.dst_end_utc ( 2024 ) and ticks ( 2023, 10, 27, 0 + 2 ) == n.dst_end_utc ( 2023 ) );
+    check ( 12 == rule ( "XXX3YYY,0,365" ).dst_end.month ); // Day 365 is December 31 of a leap year.
+    for ( std::string_view const tz : { "", "EST", "ES5", "<AB>5", "EST5x", "EST5EDT,M13.1.0,M11.1.0", "EST5EDT,M3.6.0,M11.1.0",
+                                        "EST5EDT,M3.2.7,M11.1.0", "EST5EDT,M3.2.0", "EST5EDT,M3.2.0,M11.1.0,", "EST5EDT,J0,J365",
+                                        "EST5EDT,J1,J366", "EST5EDT,0,366", "EST5EDT,M3.2.0/x,M11.1.0", "EST168" } )
+        check ( not parse_posix_tz ( tz ) );
+}
+
+// The root is fixed at first use, later sets change nothing.
+void check_zoneinfo_root ( ) {
+    fs::path const root = zoneinfo_root ( );
+    check ( not set_zoneinfo_root ( "/nonexistent" ) );
+    check ( root == zoneinfo_root ( ) );
+}
+
+} // namespace
+
+void check_tzif ( ) {
+    check_tzif_fixtures ( );
+    check_posix_tz ( );
+    check_zoneinfo_root ( );
+}
@@ -0,0 +1,206 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the \"Software\"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "check.hpp"
+
+#include "timezoneinfo.hpp"
+#include "zone_cache.hpp"
+
+#include <cstdint>
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <random>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+// New York and Sydney, the latter on the southern hemisphere.
+zone_rule_t const new_york{ -5 * 3'600, -4 * 3'600, { 3, 2, 0, 2 * 3'600 }, { 11, 1, 0, 2 * 3'600 } };
+zone_rule_t const sydney{ 10 * 3'600, 11 * 3'600, { 10, 1, 0, 2 * 3'600 }, { 4, 1, 0, 3 * 3'600 } };
+
+constexpr std::int64_t hour = 3'600LL * 10'000'000LL; // Ticks.
+
+// The ticks since 1601 at midnight of y_-m_-d_.
+[[nodiscard]] constexpr std::int64_t ticks ( int const y_, int const m_, int const d_ ) noexcept {
+    return ( days_from_civil ( y_, m_, d_ ) + days_from_winepoch_to_nix ) * ticks_per_day;
+}
+
+[[nodiscard]] std::int64_t random_instant ( std::mt19937_64 & rng_ ) noexcept {
+    std::int64_t const first = ( days_from_civil ( 1900, 1, 1 ) + days_from_winepoch_to_nix ) * ticks_per_day;
+    std::int64_t const last  = ( days_from_civil ( 2200, 1, 1 ) + days_from_winepoch_to_nix ) * ticks_per_day;
+    return std::uniform_int_distribution<std::int64_t>{ first, last }( rng_ );
+}
+
+// The tzi_t wrappers keep the zone of each tzi_t, calls alternating between zones give what a fresh zone gives.
+void check_tzi_zones ( ) {
+    tzi_t const tzis[ 2 ]   = { make_tzi ( new_york ), make_tzi ( sydney ) };
+    zone_t const zones[ 2 ] = { zone_t{ tzis[ 0 ] }, zone_t{ tzis[ 1 ] } };
+    std::mt19937_64 rng{ 1601u };
+    for ( int i = 0; i < 10'000; ++i ) {
+        wintime_t wt;
+        wt.as_uint64 ( ) = static_cast<std::uint64_t> ( random_instant ( rng ) );
+        check ( get_wintime_in_tz ( tzis[ i & 1 ], wt ).as_uint64 ( ) == zones[ i & 1 ].to_local ( wt ).as_uint64 ( ) );
+    }
+    // The names, and what follows their NULs, are not of the rule, more renamed tzi_t's than the cache holds give what
+    // their rules give.
+    bool same = true;
+    for ( int i = 0; i < 4'000; ++i ) {
+        tzi_t tzi              = tzis[ i & 1 ];
+        tzi.StandardName[ 0 ]  = static_cast<wchar_t> ( L'A' + i % 26 );
+        tzi.DaylightName[ 31 ] = static_cast<wchar_t> ( i );
+        wintime_t wt;
+        wt.as_uint64 ( ) = static_cast<std::uint64_t> ( random_instant ( rng ) );
+        same = same and get_wintime_in_tz ( tzi, wt ).as_uint64 ( ) == zones[ i & 1 ].to_local ( wt ).as_uint64 ( );
+    }
+    check ( same );
+    for ( int i = 0; i < 4; ++i ) {
+        std::int64_t const now = static_cast<std::int64_t> ( wintime ( ).as_uint64 ( ) );
+        check ( today_in_tz ( tzis[ i & 1 ] ).offset == zones[ i & 1 ].offset ( now ) );
+    }
+}
+
+// The table-less zone of a rule, the fallback that does not allocate, agrees with the compiled one.
+void check_rule_zone ( ) {
+    std::mt19937_64 rng{ 1970u };
+    for ( zone_rule_t const & rule : { new_york, sydney } ) {
+        zone_t const compiled{ rule }, evaluated = zone_t::from_rule ( rule );
+        for ( int i = 0; i < 10'000; ++i ) {
+            std::int64_t const t = random_instant ( rng );
+            check ( compiled.offset ( t ) == evaluated.offset ( t ) );
+        }
+    }
+}
+
+// A refresh recompiles the cached zones under the same ids, the zones handed out before stay valid.
+void check_zone_cache_refresh ( ) {
+    static zone_cache_t cache;
+    zone_rule_t rule = new_york;
+    auto const make  = [ &rule ] ( std::string_view const key_ ) -> std::optional<zone_t> {
+        if ( "America/New_York" != key_ )
+            return std::nullopt;
+        return zone_t{ rule };
+    };
+    zone_id_t const id     = cache.intern ( "America/New_York", make );
+    zone_t const * const z = cache.get ( "America/New_York", make );
+    check ( id and z == &cache[ id ] and not cache.get ( "Europe/Paris", make ) );
+    check ( 0u == cache.refresh ( make ) and z == &cache[ id ] ); // Unchanged, not replaced.
+    rule.dst_offset = rule.std_offset;
+    check ( 1u == cache.refresh ( make ) );
+    check ( id == cache.find_id ( "America/New_York" ) and z != &cache[ id ] and
+            &cache[ id ] == cache.find ( "America/New_York" ) );
+    check ( *z == zone_t{ new_york } and cache[ id ] == zone_t{ rule } );
+}
+
+// The UTC instant of local_ [ ticks ] under policy_, by local_to_utc.
+[[nodiscard]] std::optional<std::int64_t> utc_of ( zone_t const & zone_, std::int64_t const local_, local_policy_t const policy_ ) {
+    wintime_t wt;
+    wt.as_uint64 ( )                   = static_cast<std::uint64_t> ( local_ );
+    std::optional<wintime_t> const utc = local_to_utc ( zone_, wt, policy_ );
+    return utc ? std::optional<std::int64_t>{ static_cast<std::int64_t> ( utc->as_uint64 ( ) ) } : std::nullopt;
+}
+
+// The gap and the overlap of New York in 2021, of the compiled zone and of the rule, under each policy.
+void check_local_policies ( ) {
+    std::int64_t const gap = ticks ( 2021, 3, 14 ) + 5 * hour / 2, overlap = ticks ( 2021, 11, 7 ) + 3 * hour / 2; // 02:30, 01:30.
+    std::int64_t const summer = ticks ( 2021, 7, 1 ) + 12 * hour, new_year = ticks ( 2021, 1, 1 ) + hour / 2;
+    for ( zone_t const & zone : { zone_t{ new_york }, zone_t::from_rule ( new_york ) } ) {
+        local_resolution_t const g = zone.resolve_local ( gap ), o = zone.resolve_local ( overlap );
+        local_resolution_t const s = zone.resolve_local ( summer ), n = zone.resolve_local ( new_year );
+        check ( local_kind_t::nonexistent == g.kind and gap + 5 * hour == g.earliest and g.earliest == g.latest ); // 03:30 EDT.
+        check ( local_kind_t::ambiguous == o.kind and overlap + 4 * hour == o.earliest and overlap + 5 * hour == o.latest );
+        check ( local_kind_t::unique == s.kind and summer + 4 * hour == s.earliest and s.earliest == s.latest );
+        check ( -4 * hour == s.offset and s.begin <= summer and summer < s.end );
+        check ( local_kind_t::unique == n.kind and new_year + 5 * hour == n.earliest and n.begin <= new_year and new_year < n.end );
+        // The local times of the unique interval (of the table) span the period, between the gap and the overlap.
+        if ( zone.transitions ( ).size ( ) )
+            check ( ticks ( 2021, 3, 14 ) + 3 * hour == s.begin and ticks ( 2021, 11, 7 ) + hour == s.end );
+        for ( ambiguous_t const a : { ambiguous_t::earliest, ambiguous_t::latest, ambiguous_t::reject } ) {
+            for ( nonexistent_t const e : { nonexistent_t::shift_forward, nonexistent_t::reject } ) {
+                local_policy_t const policy{ a, e };
+                std::optional<std::int64_t> const expected_gap = nonexistent_t::reject == e ? std::nullopt
+                                                                                             : std::optional{ g.earliest };
+                std::optional<std::int64_t> const expected_overlap =
+                    ambiguous_t::reject == a ? std::nullopt : std::optional{ ambiguous_t::earliest == a ? o.earliest : o.latest };
+                check ( expected_gap == utc_of ( zone, gap, policy ) and expected_gap == policy.apply ( g ) );
+                check ( expected_overlap == utc_of ( zone, overlap, policy ) and expected_overlap == policy.apply ( o ) );
+                check ( std::optional{ s.earliest } == utc_of ( zone, summer, policy ) );
+            }
+        }
+    }
+}
+
+// Periods shorter than the offset changes, an hour, offsets alternating between 0 and 3 hours, against the periods local
+// times map into by brute force. Local times map into up to 3 periods, and the unique intervals are exactly that.
+void check_short_periods ( ) {
+    std::int64_t const t0 = ticks ( 2021, 6, 1 );
+    std::vector<std::int64_t> transitions, offsets{ 0 };
+    for ( std::int64_t i = 0; i < 12; ++i ) {
+        transitions.push_back ( t0 + i * hour );
+        offsets.push_back ( i % 2 or 11 == i ? 0 : 3 * hour );
+    }
+    zone_t const zone{ transitions, offsets, zone_rule_t{ } };
+    auto const begin = [ &transitions ] ( std::size_t const i_ ) {
+        return i_ ? transitions[ i_ - 1u ] : std::numeric_limits<std::int64_t>::min ( ) / 2;
+    };
+    auto const end = [ &transitions ] ( std::size_t const i_ ) {
+        return i_ < transitions.size ( ) ? transitions[ i_ ] : std::numeric_limits<std::int64_t>::max ( ) / 2;
+    };
+    for ( std::int64_t local = t0 - 6 * hour; local < t0 + 18 * hour; local += hour / 4 ) {
+        std::vector<std::int64_t> utc;
+        std::int64_t before = 0;
+        for ( std::size_t i = 0u; i < offsets.size ( ); ++i ) {
+            if ( begin ( i ) <= local - offsets[ i ] and local - offsets[ i ] < end ( i ) )
+                utc.push_back ( local - offsets[ i ] );
+            else if ( local - offsets[ i ] >= end ( i ) )
+                before = local - offsets[ i ];
+        }
+        local_resolution_t const r = zone.resolve_local ( local );
+        if ( utc.empty ( ) ) {
+            check ( local_kind_t::nonexistent == r.kind and before == r.earliest and before == r.latest );
+            continue;
+        }
+        check ( ( 1u == utc.size ( ) ? local_kind_t::unique : local_kind_t::ambiguous ) == r.kind );
+        check ( utc.front ( ) == r.earliest and utc.back ( ) == r.latest );
+        if ( local_kind_t::unique != r.kind )
+            continue;
+        // Every local time of the unique interval maps there, and only there.
+        check ( r.begin <= local and local < r.end );
+        for ( std::int64_t l = r.begin; l < r.end; l += std::max<std::int64_t> ( 1, ( r.end - r.begin ) / 16 ) ) {
+            local_resolution_t const q = zone.resolve_local ( l );
+            check ( local_kind_t::unique == q.kind and l - r.offset == q.earliest );
+        }
+    }
+}
+
+} // namespace
+
+void check_zone ( ) {
+    check_tzi_zones ( );
+    check_rule_zone ( );
+    check_zone_cache_refresh ( );
+    check_local_policies ( );
+    check_short_periods ( );
+}
@@ -0,0 +1,147 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the \"Software\"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "check.hpp"
+
+#include "batch.hpp"
+#include "zoned_time.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr std::int64_t minute = 60LL * 10'000'000LL; // Ticks.
+
+constexpr std::int64_t instants[]{ zoned_time_t::min_utc, zoned_time_t::min_utc + 1, zoned_time_t::epoch + 3'600 * 10'000'000LL,
+                                   zoned_time_t::max_utc - 1, zoned_time_t::max_utc };
+constexpr int offsets[]{ zoned_time_t::min_offset, -600, -210, -15, 0, 15, 345, 840, zoned_time_t::max_offset };
+
+static_assert ( -16 * 60 == zoned_time_t::min_offset and 15 * 60 + 45 == zoned_time_t::max_offset );
+
+// Each instant at each offset reads back as constructed, raw and back, at the ends of both ranges.
+void check_round_trips ( ) {
+    bool ok = true;
+    for ( std::int64_t const utc : instants ) {
+        for ( int const offset : offsets ) {
+            zoned_time_t const z{ utc, offset };
+            ok = ok and utc == z.utc ( ) and offset == z.offset_minutes ( ) and offset * minute == z.offset ( ) and
+                 utc + offset * minute == z.local ( ) and z == zoned_time_t::from_raw ( z.raw ( ) ) and
+                 static_cast<std::uint64_t> ( utc ) == z.utc_wintime ( ).as_uint64 ( ) and
+                 static_cast<std::uint64_t> ( utc + offset * minute ) == z.local_wintime ( ).as_uint64 ( );
+        }
+    }
+    check ( ok );
+    check ( zoned_time_t::epoch == zoned_time_t{ }.utc ( ) and 0 == zoned_time_t{ }.offset_minutes ( ) );
+}
+
+// The instant orders first, equal instants by offset (the most negative first), equal is the same instant at the same
+// offset. with_offset moves the offset only, at the ends of the ranges too, the arithmetic moves the instant only.
+void check_order_and_offsets ( ) {
+    bool ok = true;
+    for ( std::int64_t const utc : instants ) {
+        for ( int const a : offsets ) {
+            zoned_time_t const z{ utc, a };
+            for ( int const b : offsets ) {
+                zoned_time_t const w = z.with_offset ( b );
+                ok = ok and same_instant ( z, w ) and utc == w.utc ( ) and b == w.offset_minutes ( ) and
+                     ( a < b ) == ( z < w ) and ( a == b ) == ( z == w );
+                if ( utc < zoned_time_t::max_utc )
+                    ok = ok and z < zoned_time_t{ utc + 1, b } and not same_instant ( z, zoned_time_t{ utc + 1, b } );
+            }
+        }
+    }
+    check ( ok );
+    zoned_time_t const z{ zoned_time_t::epoch + 1'000 * minute, -300 };
+    check ( z + minute - z == minute and ( z + minute ).offset_minutes ( ) == -300 and z - minute < z );
+    check ( ( z - minute ).utc ( ) == z.utc ( ) - minute and ( z + minute - minute ) == z );
+}
+
+// to_zoned rounds an offset that is not a whole number of quarter hours (a local mean time) to the nearest quarter hour,
+// halves away from zero, as std::lround does.
+void check_rounding ( ) {
+    bool ok = true;
+    for ( std::int32_t const seconds : { 1'172, -1'172, 449, 450, -449, -450, -1'350, 1'350, 16'200 + 37, -17'762 } ) {
+        zone_t const zone{ zone_rule_t{ seconds, seconds, { }, { } } };
+        std::vector<wintime_t> in ( 3 );
+        for ( std::size_t i = 0u; i < in.size ( ); ++i ) // A month apart.
+            in[ i ].as_uint64 ( ) =
+                static_cast<std::uint64_t> ( zoned_time_t::epoch + static_cast<std::int64_t> ( i ) * 43'200 * minute );
+        std::vector<zoned_time_t> out ( in.size ( ) );
+        to_zoned ( zone, in, out );
+        int const expected = static_cast<int> ( std::lround ( seconds / 900.0 ) ) * 15;
+        for ( std::size_t i = 0u; i < in.size ( ); ++i )
+            ok = ok and expected == out[ i ].offset_minutes ( ) and in[ i ].as_uint64 ( ) == out[ i ].utc_wintime ( ).as_uint64 ( );
+    }
+    check ( ok );
+}
+
+// The column kernels against the accessors, element by element, over columns of every length up to 9 (the tails) and a
+// longer one, random instants and offsets, the ends of the ranges included. to_zoned against the zone.
+void check_columns ( ) {
+    std::mt19937_64 rng{ 1900u };
+    std::uniform_int_distribution<std::int64_t> instant{ zoned_time_t::min_utc, zoned_time_t::max_utc };
+    std::uniform_int_distribution<int> quarter{ zoned_time_t::min_offset / 15, zoned_time_t::max_offset / 15 };
+    zone_t const new_york{ zone_rule_t{ -5 * 3'600, -4 * 3'600, { 3, 2, 0, 2 * 3'600 }, { 11, 1, 0, 2 * 3'600 } } };
+    bool ok = true;
+    for ( std::size_t const n : { 0u, 1u, 2u, 3u, 4u, 5u, 6u, 7u, 8u, 9u, 10'000u } ) {
+        std::vector<zoned_time_t> zoned ( n );
+        for ( std::size_t i = 0u; i < n; ++i )
+            zoned[ i ] = zoned_time_t{ instant ( rng ), quarter ( rng ) * 15 };
+        if ( n > 2u ) {
+            zoned[ 0 ] = zoned_time_t{ zoned_time_t::min_utc, zoned_time_t::min_offset };
+            zoned[ 1 ] = zoned_time_t{ zoned_time_t::max_utc, zoned_time_t::max_offset };
+            zoned[ 2 ] = zoned_time_t{ zoned_time_t::max_utc, zoned_time_t::min_offset };
+        }
+        std::vector<wintime_t> utc ( n ), local ( n );
+        to_utc ( zoned, utc );
+        to_local ( zoned, local );
+        for ( std::size_t i = 0u; i < n; ++i )
+            ok = ok and utc[ i ].as_uint64 ( ) == zoned[ i ].utc_wintime ( ).as_uint64 ( ) and
+                 local[ i ].as_uint64 ( ) == zoned[ i ].local_wintime ( ).as_uint64 ( );
+        // Back through to_zoned, the instants within the years the zone is compiled for.
+        for ( std::size_t i = 0u; i < n; ++i )
+            utc[ i ].as_uint64 ( ) =
+                static_cast<std::uint64_t> ( zoned_time_t::epoch + zoned[ i ].utc ( ) % ( 200 * 365 * ticks_per_day ) );
+        std::vector<zoned_time_t> out ( n );
+        to_zoned ( new_york, utc, out );
+        for ( std::size_t i = 0u; i < n; ++i ) {
+            std::int64_t const t = static_cast<std::int64_t> ( utc[ i ].as_uint64 ( ) );
+            ok = ok and t == out[ i ].utc ( ) and new_york.offset ( t ) == out[ i ].offset ( );
+        }
+    }
+    check ( ok );
+}
+
+} // namespace
+
+void check_zoned_time ( ) {
+    check_round_trips ( );
+    check_order_and_offsets ( );
+    check_rounding ( );
+    check_columns ( );
+}
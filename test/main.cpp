@@ -21,6 +21,10 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+#include "check.hpp"
+
+#include "batch.hpp"
+#include "business_calendar.hpp"
 #include "timezoneinfo.hpp"
 
 #include <cassert>
@@ -30,6 +34,7 @@
 
 #include <array>
 #include <charconv>
+#include <chrono>
 #include <filesystem>
 #include <fstream>
 #include <iterator>
@@ -47,68 +52,184 @@
 
 void print_calendar ( int const y_, int const m_ ) noexcept { std::cout << calendar ( y_, m_ ); }
 
-struct Week {
-
-    int week_num;
-    int days[ 7 ]{ };
-
-    Week ( ) noexcept {}
-    Week ( int w_ ) noexcept : week_num{ w_ } {}
-};
-
-struct Month {
-
-    int year, month;
-    char name[ 16 ]{ };
-    std::vector<Week> weeks;
-
-    Month ( ) { weeks.reserve ( 6 ); }
-};
-
-[[nodiscard]] Month calendar_ ( int const y_, int const m_ ) noexcept {
-    Month m;
-    m.year  = y_;
-    m.month = m_;
-    std::memcpy ( m.name, month_of_the_year[ m_ - 1 ], std::strlen ( month_of_the_year[ m_ - 1 ] ) );
-    int w = year_weeks ( y_, m_, 1 ), f = day_week ( y_, m_, 1 );
-    // first line.
-    int *dp = m.weeks.emplace_back ( w++ ).days, c = 1;
-    while ( f < 7 )
-        dp[ f++ ] = c++;
-    // middle lines.
-    int const l = days_month ( y_, m_ );
-    while ( c <= ( l - 7 ) ) {
-        dp = m.weeks.emplace_back ( w++ ).days;
-        f  = 0;
-        while ( f < 7 )
-            dp[ f++ ] = c++;
-    }
-    // last line (iff applicable).
-    if ( c <= l ) {
-        dp = m.weeks.emplace_back ( w ).days;
-        do
-            *dp++ = c++;
-        while ( c <= l );
+// Times the windowsZones.xml scanner against the tinyxml2 DOM, on the file and on a synthetic one with 100 times the
+// mapZone elements.
+void bench_windowszones ( fs::path const & path_ ) {
+    WinTzSet const db = fill_timezones_db ( );
+    std::ifstream inf ( path_, std::ios::binary );
+    std::string const xml{ std::istreambuf_iterator<char> ( inf ), std::istreambuf_iterator<char> ( ) };
+    std::size_t const b = xml.find ( '>', xml.find ( "<mapTimezones" ) ) + 1u, e = xml.find ( "</mapTimezones>" );
+    std::string big = xml.substr ( 0u, b );
+    for ( int i = 0; i < 100; ++i )
+        big.append ( xml, b, e - b );
+    big.append ( xml, e );
+    fs::path const big_path = fs::temp_directory_path ( ) / L"windowszones_100.xml";
+    std::ofstream ( big_path, std::ios::binary ) << big;
+    auto const time = [ &db ] ( auto parse_, fs::path const & p_, int const n_ ) {
+        auto const start = std::chrono::steady_clock::now ( );
+        for ( int i = 0; i < n_; ++i )
+            [[maybe_unused]] IanaMap const map = parse_ ( p_, db );
+        return std::chrono::duration<double, std::milli> ( std::chrono::steady_clock::now ( ) - start ).count ( ) / n_;
+    };
+    for ( auto const & [ p, n ] : { std::pair{ path_, 100 }, std::pair{ big_path, 5 } } )
+        std::cout << p.filename ( ).string ( ) << " (" << fs::file_size ( p ) << " bytes): scanner " << time ( parse_windowszones, p, n )
+                  << " ms, tinyxml2 " << time ( parse_windowszones_tinyxml2, p, n ) << " ms" << nl;
+    fs::remove ( big_path );
+}
+
+// Times stamping with the systime_pattern: fmt::format (the former print_systime), the compiled time_format_t and the
+// cached_time_format_t, on monotonic (1 ms apart) and on random instants.
+void bench_time_format ( ) {
+    constexpr int n = 1'000'000;
+    std::vector<wintime_t> monotonic ( n ), random ( n );
+    std::uint64_t const start = wintime ( ).as_uint64 ( );
+    std::mt19937_64 rng{ start };
+    std::uniform_int_distribution<std::uint64_t> dist{ 0u, 10ULL * 365ULL * 24ULL * 3'600ULL * 10'000'000ULL };
+    for ( int i = 0; i < n; ++i ) {
+        monotonic[ i ].as_uint64 ( ) = start + static_cast<std::uint64_t> ( i ) * 10'000ULL;
+        random[ i ].as_uint64 ( )    = start - dist ( rng );
     }
-    return m;
+    std::size_t sink = 0u;
+    auto const time  = [ &sink ] ( std::vector<wintime_t> const & in_, auto stamp_ ) {
+        auto const begin = std::chrono::steady_clock::now ( );
+        for ( wintime_t const wt : in_ )
+            sink += stamp_ ( wt ).size ( );
+        return std::chrono::duration<double, std::nano> ( std::chrono::steady_clock::now ( ) - begin ).count ( ) / in_.size ( );
+    };
+    time_format_t const format{ systime_pattern };
+    cached_time_format_t cached;
+    char buffer[ time_format_t::max_output ];
+    auto const fmt_stamp = [] ( wintime_t const wt_ ) {
+        systime_t const st = wintime_to_systime ( wt_ );
+        return fmt::format ( "{} {} {:2} {:02}:{:02}:{:02}.{:03} {}", dow[ st.wDayOfWeek ], moy[ st.wMonth - 1 ], st.wDay, st.wHour,
+                             st.wMinute, st.wSecond, st.wMilliseconds, st.wYear );
+    };
+    auto const compiled_stamp = [ &format, &buffer ] ( wintime_t const wt_ ) {
+        return std::string_view{ buffer,
+                                 static_cast<std::size_t> ( format.format_to ( buffer, wintime_to_systime ( wt_ ) ) - buffer ) };
+    };
+    auto const cached_stamp = [ &cached ] ( wintime_t const wt_ ) { return cached.format ( wt_ ); };
+    for ( auto const & [ name, in ] : { std::pair{ "monotonic", &monotonic }, std::pair{ "random", &random } } )
+        std::cout << name << ": fmt::format " << time ( *in, fmt_stamp ) << " ns/op, time_format_t " << time ( *in, compiled_stamp )
+                  << " ns/op, cached_time_format_t " << time ( *in, cached_stamp ) << " ns/op" << nl;
+    std::cout << "(" << sink << " chars)" << nl;
 }
 
-int main ( ) {
+// Times "which local day is it in zone X", the cached local day against the decomposition of the current local time.
+void bench_clock ( ) {
+    constexpr int n    = 1'000'000;
+    zone_id_t const id = lookup ( "America/New_York" );
+    if ( not id )
+        return;
+    zone_t const & zone = get_zone ( id );
+    int sink            = 0;
+    auto const time     = [ &sink ] ( auto day_ ) {
+        auto const begin = std::chrono::steady_clock::now ( );
+        for ( int i = 0; i < n; ++i )
+            sink += day_ ( );
+        return std::chrono::duration<double, std::nano> ( std::chrono::steady_clock::now ( ) - begin ).count ( ) / n;
+    };
+    std::cout << "today: to_local " << time ( [ &zone ] { return zone.to_local ( systime ( ) ).wDay; } ) << " ns/op, today_in_tz "
+              << time ( [ id ] { return today_in_tz ( id ).day; } ) << " ns/op (" << sink << ")" << nl;
+}
 
-    init_alt ( );
+// Times stamping a column of UTC instants with their offset, packed, and taking the local time back out of it, against
+// the conversion of the wintime_t column.
+void bench_zoned ( ) {
+    constexpr std::size_t n = 1'000'000u;
+    zone_id_t const id      = lookup ( "America/New_York" );
+    if ( not id )
+        return;
+    zone_t const & zone = get_zone ( id );
+    std::vector<wintime_t> utc ( n ), local ( n );
+    std::vector<zoned_time_t> zoned ( n );
+    std::uint64_t const now = wintime ( ).as_uint64 ( ), step = 365u * static_cast<std::uint64_t> ( ticks_per_day ) / n;
+    for ( std::size_t i = 0u; i < n; ++i )
+        utc[ i ].as_uint64 ( ) = now + i * step;
+    auto const time = [ ] ( auto f_ ) {
+        auto const begin = std::chrono::steady_clock::now ( );
+        f_ ( );
+        return std::chrono::duration<double, std::nano> ( std::chrono::steady_clock::now ( ) - begin ).count ( ) / n;
+    };
+    std::cout << "zoned: to_local (wintime_t) " << time ( [ & ] { to_local ( zone, utc, local ); } ) << " ns/op, to_zoned "
+              << time ( [ & ] { to_zoned ( zone, utc, zoned ); } ) << " ns/op, to_local (zoned_time_t) "
+              << time ( [ & ] { to_local ( zoned, local ); } ) << " ns/op" << nl;
+}
 
-    Month m = calendar_ ( 2020, 5 );
+// Times settling T+2 over a range of trade dates, on the calendar and by stepping a day at a time over the weekends, and
+// counting the business days between two dates.
+void bench_business_days ( ) {
+    constexpr std::size_t n = 1'000'000u;
+    civil_t const holidays[]{ { 2020, 1, 1 }, { 2020, 12, 25 }, { 2021, 1, 1 }, { 2021, 12, 24 } };
+    business_calendar_t const calendar ( 2000, 2099, business_calendar_t::saturday_sunday, holidays );
+    std::int64_t const first = days_from_civil ( 2010, 1, 1 );
+    auto const time = [ ] ( auto f_ ) {
+        std::int64_t sink = 0;
+        auto const begin  = std::chrono::steady_clock::now ( );
+        for ( std::size_t i = 0u; i < n; ++i )
+            sink += f_ ( static_cast<std::int64_t> ( i % 3'650u ) );
+        double const ns = std::chrono::duration<double, std::nano> ( std::chrono::steady_clock::now ( ) - begin ).count ( ) / n;
+        return std::pair{ ns, sink };
+    };
+    auto const [ stepped, a ] = time ( [ first ] ( std::int64_t const i_ ) {
+        std::int64_t day = first + i_;
+        for ( int k = 0; k < 2; ) {
+            int const weekday = static_cast<int> ( ( ++day + 4 ) % 7 ); // 1970-01-01 was a Thursday.
+            k += weekday != 0 and weekday != 6;
+        }
+        return day;
+    } );
+    auto const [ settled, b ] = time ( [ & ] ( std::int64_t const i_ ) { return calendar.add_business_days ( first + i_, 2 ); } );
+    auto const [ between, c ] =
+        time ( [ & ] ( std::int64_t const i_ ) { return calendar.business_days_between ( first, first + 3 * i_ ); } );
+    std::cout << "business days: T+2 stepped " << stepped << " ns/op, T+2 " << settled << " ns/op, between " << between
+              << " ns/op (" << a + b + c << ")" << nl;
+}
+
+// Runs the checks, and with --bench the benchmarks as well.
+int main ( int argc, char ** argv ) {
+
+    check_batch ( );
+    check_business_calendar ( );
+    check_calendar ( );
+    check_clock ( );
+    check_fetcher ( );
+    check_ianamap ( );
+    check_iso8601 ( );
+    check_published ( );
+    check_snapshot ( );
+    check_time_format ( );
+    check_tzif ( );
+    check_zone ( );
+    check_zoned_time ( );
+
+    if ( argc > 1 and std::string_view{ argv[ 1 ] } == "--bench" ) {
+        init_alt ( );
+        await_refresh ( ); // The benchmarks want the files, the first run downloads them.
+
+        bench_time_format ( );
+        bench_clock ( );
+        bench_zoned ( );
+        bench_business_days ( );
+
+        if ( fs::exists ( windowszones_path ( ) ) )
+            bench_windowszones ( windowszones_path ( ) );
+    }
 
-    std::cout << m.name << nl;
-    std::cout << m.year << ' ' << m.month << nl;
-    std::cout << m.weeks.size ( ) << nl;
-    std::cout << m.weeks[ 0 ].week_num << nl;
+    month_t const m = cached_month ( 2020, 5 );
+
+    std::cout << month_of_the_year[ m.month - 1 ] << nl;
+    std::cout << m.year << ' ' << +m.month << nl;
+    std::cout << +m.weeks << nl;
+    std::cout << +m.week_num[ 0 ] << nl;
 
     /*
 
-    std::cout << g_iana.size ( ) << nl;
+    zone_data_pin_t const data = zone_data ( );
+
+    std::cout << data->map.size ( ) << nl;
 
-    for ( auto const & e : g_iana )
+    for ( auto const & e : data->map )
         std::cout << e.first << " - " << e.second.name << " - " << e.second.code << nl;
 
 
@@ -137,7 +258,7 @@ int main ( ) {
 
     */
 
-    return EXIT_SUCCESS;
+    return check_failures ? EXIT_FAILURE : EXIT_SUCCESS;
 }
 
 std::uint16_t fletcher16 ( std::uint8_t const * const data, int const count ) {
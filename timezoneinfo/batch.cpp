@@ -0,0 +1,367 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the \"Software\"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "batch.hpp"
+#include "decompose_block.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <optional>
+
+#if defined( __x86_64__ ) or defined( _M_X64 ) or defined( __i386__ ) or defined( _M_IX86 )
+#    define HAVE_X86_SIMD 1
+#    include <immintrin.h>
+#    if defined( _MSC_VER )
+#        include <intrin.h>
+#    endif
+#    if defined( __GNUC__ ) or defined( __clang__ )
+#        define TARGET_AVX2 __attribute__ ( ( target ( "avx2" ) ) )
+#        define TARGET_SSE42 __attribute__ ( ( target ( "sse4.2" ) ) )
+#    else
+#        define TARGET_AVX2
+#        define TARGET_SSE42
+#    endif
+#else
+#    define HAVE_X86_SIMD 0
+#endif
+
+#define WIN_TO_NIX_EPOCH 116'444'736'000'000'000LL
+#define S_10M 10'000'000LL
+#define BLOCK_SIZE decompose_block_size
+
+static_assert ( sizeof ( nixtime_t ) == sizeof ( std::int64_t ) );
+static_assert ( sizeof ( wintime_t ) == sizeof ( std::int64_t ) );
+static_assert ( static_cast<std::uint64_t> ( rejected_nixtime ) == rejected_wintime ); // One sentinel, for both columns.
+
+namespace {
+
+// Returns the period, in the units of the column, containing x_.
+using period_fn = period_t ( * ) ( zone_t const & zone_, std::int64_t const x_ ) noexcept;
+
+[[nodiscard]] period_t period_ticks ( zone_t const & zone_, std::int64_t const x_ ) noexcept { return zone_.period ( x_ ); }
+
+[[nodiscard]] constexpr std::int64_t ceil_div ( std::int64_t const a_, std::int64_t const b_ ) noexcept {
+    return a_ >= 0 ? ( a_ + b_ - 1 ) / b_ : a_ / b_;
+}
+
+[[nodiscard]] period_t period_seconds ( zone_t const & zone_, std::int64_t const x_ ) noexcept {
+    period_t const p = zone_.period ( x_ * S_10M + WIN_TO_NIX_EPOCH );
+    return { ceil_div ( p.begin - WIN_TO_NIX_EPOCH, S_10M ), ceil_div ( p.end - WIN_TO_NIX_EPOCH, S_10M ), p.offset / S_10M };
+}
+
+// Returns the resolution, in the units of the column, of local time x_.
+using resolve_fn = local_resolution_t ( * ) ( zone_t const & zone_, std::int64_t const x_ ) noexcept;
+
+[[nodiscard]] local_resolution_t resolve_ticks ( zone_t const & zone_, std::int64_t const x_ ) noexcept {
+    return zone_.resolve_local ( x_ );
+}
+
+[[nodiscard]] local_resolution_t resolve_seconds ( zone_t const & zone_, std::int64_t const x_ ) noexcept {
+    local_resolution_t const r = zone_.resolve_local ( x_ * S_10M + WIN_TO_NIX_EPOCH );
+    auto const seconds         = [] ( std::int64_t const t_ ) noexcept { return ceil_div ( t_ - WIN_TO_NIX_EPOCH, S_10M ); };
+    return { seconds ( r.earliest ), seconds ( r.latest ), seconds ( r.begin ), seconds ( r.end ), r.offset / S_10M, r.kind };
+}
+
+// As the to_local kernels, tracks the interval of local times of the previous element that map to UTC uniquely.
+std::size_t local_to_utc_kernel ( zone_t const & zone_, resolve_fn resolve_, std::int64_t const * in_, std::int64_t * out_,
+                                  local_kind_t * kinds_, std::size_t const n_, local_policy_t const policy_ ) noexcept {
+    local_resolution_t r{ 0, 0, 0, 0, 0, local_kind_t::unique }; // Empty.
+    std::size_t irregular = 0u;
+    for ( std::size_t i = 0u; i < n_; ++i ) {
+        std::int64_t const x = in_[ i ];
+        if ( x >= r.begin and x < r.end ) {
+            out_[ i ] = x - r.offset;
+            if ( kinds_ )
+                kinds_[ i ] = local_kind_t::unique;
+            continue;
+        }
+        r = resolve_ ( zone_, x );
+        if ( kinds_ )
+            kinds_[ i ] = r.kind;
+        irregular += local_kind_t::unique != r.kind;
+        std::optional<std::int64_t> const utc = policy_.apply ( r );
+        out_[ i ]                             = utc ? *utc : rejected_nixtime;
+    }
+    return irregular;
+}
+
+using kernel_fn = void ( * ) ( zone_t const & zone_, period_fn period_, std::int64_t const * in_, std::int64_t * out_,
+                               std::size_t const n_ ) noexcept;
+
+inline void step ( zone_t const & zone_, period_fn period_, period_t & p_, std::int64_t const * in_, std::int64_t * out_,
+                   std::size_t const i_ ) noexcept {
+    std::int64_t const x = in_[ i_ ];
+    if ( x < p_.begin or x >= p_.end )
+        p_ = period_ ( zone_, x );
+    out_[ i_ ] = x + p_.offset;
+}
+
+void kernel_scalar ( zone_t const & zone_, period_fn period_, std::int64_t const * in_, std::int64_t * out_,
+                     std::size_t const n_ ) noexcept {
+    period_t p{ 0, 0, 0 }; // Empty.
+    for ( std::size_t i = 0u; i < n_; ++i )
+        step ( zone_, period_, p, in_, out_, i );
+}
+
+#if HAVE_X86_SIMD
+
+TARGET_AVX2 void kernel_avx2 ( zone_t const & zone_, period_fn period_, std::int64_t const * in_, std::int64_t * out_,
+                               std::size_t const n_ ) noexcept {
+    period_t p{ 0, 0, 0 };
+    __m256i b = _mm256_setzero_si256 ( ), e = _mm256_setzero_si256 ( ), o = _mm256_setzero_si256 ( );
+    std::size_t i = 0u;
+    for ( ; i + 4u <= n_; i += 4u ) {
+        __m256i const x = _mm256_loadu_si256 ( reinterpret_cast<__m256i const *> ( in_ + i ) );
+        // All 4 in [ begin, end ): not ( begin > x ) and ( end > x ).
+        if ( -1 == _mm256_movemask_epi8 ( _mm256_andnot_si256 ( _mm256_cmpgt_epi64 ( b, x ), _mm256_cmpgt_epi64 ( e, x ) ) ) ) {
+            _mm256_storeu_si256 ( reinterpret_cast<__m256i *> ( out_ + i ), _mm256_add_epi64 ( x, o ) );
+            continue;
+        }
+        for ( std::size_t j = i; j < i + 4u; ++j )
+            step ( zone_, period_, p, in_, out_, j );
+        b = _mm256_set1_epi64x ( p.begin );
+        e = _mm256_set1_epi64x ( p.end );
+        o = _mm256_set1_epi64x ( p.offset );
+    }
+    for ( ; i < n_; ++i )
+        step ( zone_, period_, p, in_, out_, i );
+}
+
+TARGET_SSE42 void kernel_sse42 ( zone_t const & zone_, period_fn period_, std::int64_t const * in_, std::int64_t * out_,
+                                 std::size_t const n_ ) noexcept {
+    period_t p{ 0, 0, 0 };
+    __m128i b = _mm_setzero_si128 ( ), e = _mm_setzero_si128 ( ), o = _mm_setzero_si128 ( );
+    std::size_t i = 0u;
+    for ( ; i + 2u <= n_; i += 2u ) {
+        __m128i const x = _mm_loadu_si128 ( reinterpret_cast<__m128i const *> ( in_ + i ) );
+        if ( 0xFFFF == _mm_movemask_epi8 ( _mm_andnot_si128 ( _mm_cmpgt_epi64 ( b, x ), _mm_cmpgt_epi64 ( e, x ) ) ) ) {
+            _mm_storeu_si128 ( reinterpret_cast<__m128i *> ( out_ + i ), _mm_add_epi64 ( x, o ) );
+            continue;
+        }
+        step ( zone_, period_, p, in_, out_, i );
+        step ( zone_, period_, p, in_, out_, i + 1u );
+        b = _mm_set1_epi64x ( p.begin );
+        e = _mm_set1_epi64x ( p.end );
+        o = _mm_set1_epi64x ( p.offset );
+    }
+    if ( i < n_ )
+        step ( zone_, period_, p, in_, out_, i );
+}
+
+#endif
+
+[[nodiscard]] simd_level_t detect_simd_level ( ) noexcept {
+#if HAVE_X86_SIMD
+#    if defined( _MSC_VER )
+    int r[ 4 ];
+    __cpuid ( r, 0 );
+    int const max_leaf = r[ 0 ];
+    __cpuid ( r, 1 );
+    bool const sse42 = r[ 2 ] & ( 1 << 20 ), os_avx = ( r[ 2 ] & ( 1 << 27 ) ) and ( r[ 2 ] & ( 1 << 28 ) );
+    if ( max_leaf >= 7 and os_avx and 6u == ( _xgetbv ( 0 ) & 6u ) ) {
+        __cpuidex ( r, 7, 0 );
+        if ( r[ 1 ] & ( 1 << 5 ) )
+            return simd_level_t::avx2;
+    }
+    return sse42 ? simd_level_t::sse42 : simd_level_t::scalar;
+#    else
+    __builtin_cpu_init ( );
+    if ( __builtin_cpu_supports ( "avx2" ) )
+        return simd_level_t::avx2;
+    return __builtin_cpu_supports ( "sse4.2" ) ? simd_level_t::sse42 : simd_level_t::scalar;
+#    endif
+#else
+    return simd_level_t::scalar;
+#endif
+}
+
+[[nodiscard]] simd_level_t detected_simd_level ( ) noexcept {
+    static simd_level_t const level = detect_simd_level ( );
+    return level;
+}
+
+// The level of the kernels in use, the detected one unless set lower.
+[[nodiscard]] std::atomic<simd_level_t> & selected_simd_level ( ) noexcept {
+    static std::atomic<simd_level_t> level{ detected_simd_level ( ) };
+    return level;
+}
+
+[[nodiscard]] kernel_fn kernel ( ) noexcept {
+    switch ( simd_level ( ) ) {
+#if HAVE_X86_SIMD
+        case simd_level_t::avx2: return kernel_avx2;
+        case simd_level_t::sse42: return kernel_sse42;
+#endif
+        default: return kernel_scalar;
+    }
+}
+
+[[nodiscard]] std::int64_t const * as_int64 ( nixtime_t const * p_ ) noexcept {
+    return reinterpret_cast<std::int64_t const *> ( p_ );
+}
+[[nodiscard]] std::int64_t const * as_int64 ( wintime_t const * p_ ) noexcept {
+    return reinterpret_cast<std::int64_t const *> ( p_ );
+}
+
+using decompose_fn = void ( * ) ( std::int64_t const * in_, std::size_t const n_, date_parts_t const & out_,
+                                  std::size_t const o_ ) noexcept;
+
+void decompose_baseline ( std::int64_t const * in_, std::size_t const n_, date_parts_t const & out_,
+                          std::size_t const o_ ) noexcept {
+    decompose_block ( in_, n_, out_, o_ );
+}
+
+[[nodiscard]] decompose_fn decomposer ( ) noexcept {
+#if HAVE_X86_SIMD
+    return simd_level_t::avx2 == simd_level ( ) ? decompose_avx2 : decompose_baseline;
+#else
+    return decompose_baseline;
+#endif
+}
+
+} // namespace
+
+simd_level_t simd_level ( ) noexcept { return selected_simd_level ( ).load ( std::memory_order_relaxed ); }
+
+simd_level_t set_simd_level ( simd_level_t const level_ ) noexcept {
+    simd_level_t const level = std::min ( level_, detected_simd_level ( ) );
+    selected_simd_level ( ).store ( level, std::memory_order_relaxed );
+    return level;
+}
+
+void to_local ( zone_t const & zone_, std::span<nixtime_t const> in_, std::span<nixtime_t> out_ ) noexcept {
+    assert ( out_.size ( ) >= in_.size ( ) );
+    kernel ( ) ( zone_, period_seconds, as_int64 ( in_.data ( ) ), reinterpret_cast<std::int64_t *> ( out_.data ( ) ),
+                 in_.size ( ) );
+}
+
+void to_local ( zone_t const & zone_, std::span<wintime_t const> in_, std::span<wintime_t> out_ ) noexcept {
+    assert ( out_.size ( ) >= in_.size ( ) );
+    kernel ( ) ( zone_, period_ticks, as_int64 ( in_.data ( ) ), reinterpret_cast<std::int64_t *> ( out_.data ( ) ),
+                 in_.size ( ) );
+}
+
+std::size_t local_to_utc ( zone_t const & zone_, std::span<nixtime_t const> in_, std::span<nixtime_t> out_,
+                           std::span<local_kind_t> kinds_, local_policy_t const policy_ ) noexcept {
+    assert ( out_.size ( ) >= in_.size ( ) and ( kinds_.empty ( ) or kinds_.size ( ) >= in_.size ( ) ) );
+    return local_to_utc_kernel ( zone_, resolve_seconds, as_int64 ( in_.data ( ) ), reinterpret_cast<std::int64_t *> ( out_.data ( ) ),
+                                 kinds_.size ( ) ? kinds_.data ( ) : nullptr, in_.size ( ), policy_ );
+}
+
+std::size_t local_to_utc ( zone_t const & zone_, std::span<wintime_t const> in_, std::span<wintime_t> out_,
+                           std::span<local_kind_t> kinds_, local_policy_t const policy_ ) noexcept {
+    assert ( out_.size ( ) >= in_.size ( ) and ( kinds_.empty ( ) or kinds_.size ( ) >= in_.size ( ) ) );
+    return local_to_utc_kernel ( zone_, resolve_ticks, as_int64 ( in_.data ( ) ), reinterpret_cast<std::int64_t *> ( out_.data ( ) ),
+                                 kinds_.size ( ) ? kinds_.data ( ) : nullptr, in_.size ( ), policy_ );
+}
+
+void to_zoned ( zone_t const & zone_, std::span<wintime_t const> in_, std::span<zoned_time_t> out_ ) noexcept {
+    assert ( out_.size ( ) >= in_.size ( ) );
+    constexpr std::int64_t half = zoned_time_t::ticks_per_quarter / 2;
+    std::int64_t const * const in = as_int64 ( in_.data ( ) );
+    period_t p{ 0, 0, 0 }; // Empty.
+    int minutes = 0;
+    for ( std::size_t i = 0u; i < in_.size ( ); ++i ) {
+        std::int64_t const x = in[ i ];
+        if ( x < p.begin or x >= p.end ) {
+            p       = zone_.period ( x );
+            minutes = static_cast<int> ( ( p.offset >= 0 ? p.offset + half : p.offset - half ) / zoned_time_t::ticks_per_quarter ) *
+                      15;
+        }
+        out_[ i ] = zoned_time_t{ x, minutes };
+    }
+}
+
+void to_utc ( std::span<zoned_time_t const> in_, std::span<wintime_t> out_ ) noexcept {
+    assert ( out_.size ( ) >= in_.size ( ) );
+    std::uint64_t const * const in = reinterpret_cast<std::uint64_t const *> ( in_.data ( ) );
+    std::int64_t * const out       = reinterpret_cast<std::int64_t *> ( out_.data ( ) );
+    for ( std::size_t i = 0u; i < in_.size ( ); ++i )
+        out[ i ] = static_cast<std::int64_t> ( in[ i ] >> zoned_time_t::offset_bits ) + zoned_time_t::epoch;
+}
+
+void to_local ( std::span<zoned_time_t const> in_, std::span<wintime_t> out_ ) noexcept {
+    assert ( out_.size ( ) >= in_.size ( ) );
+    std::uint64_t const * const in = reinterpret_cast<std::uint64_t const *> ( in_.data ( ) );
+    std::int64_t * const out       = reinterpret_cast<std::int64_t *> ( out_.data ( ) );
+    // The epoch, and the bias of the offset, folded into one constant.
+    constexpr std::int64_t base = zoned_time_t::epoch - zoned_time_t::offset_bias * zoned_time_t::ticks_per_quarter;
+    for ( std::size_t i = 0u; i < in_.size ( ); ++i )
+        out[ i ] = static_cast<std::int64_t> ( in[ i ] >> zoned_time_t::offset_bits ) +
+                   static_cast<std::int64_t> ( in[ i ] & zoned_time_t::offset_mask ) * zoned_time_t::ticks_per_quarter + base;
+}
+
+// The decomposed variants convert in blocks, through a buffer on the stack.
+
+void to_local ( zone_t const & zone_, std::span<nixtime_t const> in_, std::span<systime_t> out_ ) noexcept {
+    assert ( out_.size ( ) >= in_.size ( ) );
+    std::int64_t buf[ BLOCK_SIZE ];
+    for ( std::size_t i = 0u; i < in_.size ( ); i += BLOCK_SIZE ) {
+        std::size_t const n = std::min<std::size_t> ( BLOCK_SIZE, in_.size ( ) - i );
+        kernel ( ) ( zone_, period_seconds, as_int64 ( in_.data ( ) + i ), buf, n );
+        for ( std::size_t j = 0u; j < n; ++j )
+            out_[ i + j ] = nixtime_to_systime ( static_cast<nixtime_t> ( buf[ j ] ) );
+    }
+}
+
+void to_local ( zone_t const & zone_, std::span<wintime_t const> in_, std::span<systime_t> out_ ) noexcept {
+    assert ( out_.size ( ) >= in_.size ( ) );
+    std::int64_t buf[ BLOCK_SIZE ];
+    for ( std::size_t i = 0u; i < in_.size ( ); i += BLOCK_SIZE ) {
+        std::size_t const n = std::min<std::size_t> ( BLOCK_SIZE, in_.size ( ) - i );
+        kernel ( ) ( zone_, period_ticks, as_int64 ( in_.data ( ) + i ), buf, n );
+        for ( std::size_t j = 0u; j < n; ++j ) {
+            wintime_t wt;
+            wt.as_uint64 ( ) = static_cast<std::uint64_t> ( buf[ j ] );
+            out_[ i + j ]    = wintime_to_systime ( wt );
+        }
+    }
+}
+
+void decompose ( std::span<nixtime_t const> in_, date_parts_t const & out_ ) noexcept {
+    decompose_fn const k = decomposer ( );
+    for ( std::size_t i = 0u; i < in_.size ( ); i += BLOCK_SIZE )
+        k ( as_int64 ( in_.data ( ) + i ), std::min<std::size_t> ( BLOCK_SIZE, in_.size ( ) - i ), out_, i );
+}
+
+void decompose ( zone_t const & zone_, std::span<nixtime_t const> in_, date_parts_t const & out_ ) noexcept {
+    decompose_fn const k = decomposer ( );
+    std::int64_t buf[ BLOCK_SIZE ];
+    for ( std::size_t i = 0u; i < in_.size ( ); i += BLOCK_SIZE ) {
+        std::size_t const n = std::min<std::size_t> ( BLOCK_SIZE, in_.size ( ) - i );
+        kernel ( ) ( zone_, period_seconds, as_int64 ( in_.data ( ) + i ), buf, n );
+        k ( buf, n, out_, i );
+    }
+}
+
+#undef BLOCK_SIZE
+#undef WIN_TO_NIX_EPOCH
+#undef S_10M
+#undef HAVE_X86_SIMD
+#undef TARGET_AVX2
+#undef TARGET_SSE42
@@ -0,0 +1,37 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the \"Software\"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "decompose_block.hpp"
+
+// This file is built for AVX2 as a whole (/arch:AVX2 in the vcxproj), on GCC and clang the target attribute does that for
+// the one function, the function is only called once the cpu is known to support AVX2.
+#if defined( __x86_64__ ) or defined( _M_X64 ) or defined( __i386__ ) or defined( _M_IX86 )
+
+#    if defined( __GNUC__ ) or defined( __clang__ )
+__attribute__ ( ( target ( "avx2" ) ) )
+#    endif
+void decompose_avx2 ( std::int64_t const * in_, std::size_t const n_, date_parts_t const & out_, std::size_t const o_ ) noexcept {
+    decompose_block ( in_, n_, out_, o_ );
+}
+
+#endif
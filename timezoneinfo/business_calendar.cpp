@@ -0,0 +1,121 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the \"Software\"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "business_calendar.hpp"
+
+#include <cassert>
+
+#include <algorithm>
+#include <bit>
+
+namespace {
+
+// The position of the r_-th [ 0, popcount ( x_ ) ) set bit of x_, by halving, without branches (the data decides).
+[[nodiscard]] constexpr int select_bit ( std::uint64_t x_, int r_ ) noexcept {
+    int pos = 0;
+    for ( int half = 32; half; half >>= 1 ) {
+        int const low   = std::popcount ( x_ & ( ( 1ULL << half ) - 1u ) );
+        int const shift = half & -static_cast<int> ( r_ >= low );
+        r_ -= low & -static_cast<int> ( r_ >= low );
+        x_ >>= shift;
+        pos += shift;
+    }
+    return pos;
+}
+
+} // namespace
+
+business_calendar_t::business_calendar_t ( int const first_year_, int const last_year_, weekend_t const weekend_,
+                                           std::span<civil_t const> holidays_ ) :
+    m_first_day{ days_from_civil ( first_year_, 1, 1 ) }, m_end_day{ days_from_civil ( last_year_ + 1, 1, 1 ) }, m_total{ 0 } {
+    assert ( first_year_ <= last_year_ );
+    m_years.resize ( static_cast<std::size_t> ( last_year_ - first_year_ + 1 ) );
+    for ( int y = first_year_; y <= last_year_; ++y ) {
+        year_t & year  = m_years[ static_cast<std::size_t> ( y - first_year_ ) ];
+        year           = { };
+        year.first_day = days_from_civil ( y, 1, 1 );
+        int const days = is_leap_year ( y ) ? 366 : 365;
+        // 1970-01-01 was a Thursday, the remainder is negative before it.
+        for ( int i = 0, dow = static_cast<int> ( ( year.first_day % 7 + 11 ) % 7 ); i < days; ++i, dow = dow < 6 ? dow + 1 : 0 )
+            if ( not( weekend_ >> dow & 1u ) )
+                year.bits[ i >> 6 ] |= 1ULL << ( i & 63 );
+    }
+    for ( civil_t const & holiday : holidays_ )
+        if ( first_year_ <= holiday.year and holiday.year <= last_year_ and 1 <= holiday.month and holiday.month <= 12 and
+             1 <= holiday.day and holiday.day <= days_month ( holiday.year, holiday.month ) ) {
+            year_t & year        = m_years[ static_cast<std::size_t> ( holiday.year - first_year_ ) ];
+            std::int64_t const i = days_from_civil ( holiday.year, holiday.month, holiday.day ) - year.first_day;
+            year.bits[ i >> 6 ] &= ~( 1ULL << ( i & 63 ) );
+        }
+    for ( year_t & year : m_years ) {
+        year.before = m_total;
+        int before  = 0;
+        for ( int w = 0; w < 6; ++w ) {
+            year.word_before[ w ] = static_cast<std::uint16_t> ( before );
+            before += std::popcount ( year.bits[ w ] );
+        }
+        m_total += before;
+    }
+}
+
+bool business_calendar_t::is_business_day ( std::int64_t const day_ ) const noexcept {
+    if ( day_ < m_first_day or day_ >= m_end_day )
+        return false;
+    year_t const & y     = year ( day_ );
+    std::int64_t const i = day_ - y.first_day;
+    return y.bits[ i >> 6 ] >> ( i & 63 ) & 1u;
+}
+
+std::int64_t business_calendar_t::count ( std::int64_t const day_ ) const noexcept {
+    if ( day_ <= m_first_day )
+        return 0;
+    if ( day_ >= m_end_day )
+        return m_total;
+    year_t const & y     = year ( day_ );
+    std::int64_t const i = day_ - y.first_day;
+    return y.before + y.word_before[ i >> 6 ] + std::popcount ( y.bits[ i >> 6 ] & ( ( 1ULL << ( i & 63 ) ) - 1u ) );
+}
+
+std::int64_t business_calendar_t::select ( std::int64_t const k_ ) const noexcept {
+    // Guess the year from the average, and step to the one holding k_, rarely more than a step away.
+    std::size_t y = static_cast<std::size_t> ( k_ * static_cast<std::int64_t> ( m_years.size ( ) ) / m_total );
+    while ( y and m_years[ y ].before > k_ )
+        --y;
+    while ( y + 1u < m_years.size ( ) and m_years[ y + 1u ].before <= k_ )
+        ++y;
+    year_t const & year = m_years[ y ];
+    int const r         = static_cast<int> ( k_ - year.before );
+    int w               = 0;
+    for ( int i = 1; i < 6; ++i )
+        w += year.word_before[ i ] <= r;
+    return year.first_day + 64 * w + select_bit ( year.bits[ w ], r - year.word_before[ w ] );
+}
+
+std::int64_t business_calendar_t::add_business_days ( std::int64_t const day_, std::int64_t const n_ ) const noexcept {
+    if ( not n_ or not m_total )
+        return day_;
+    // The index of the target among the business days, those after day_ start at count ( day_ + 1 ), those before end
+    // at count ( day_ ).
+    std::int64_t const k = n_ > 0 ? count ( day_ + 1 ) + n_ - 1 : count ( day_ ) + n_;
+    return select ( std::clamp<std::int64_t> ( k, 0, m_total - 1 ) );
+}
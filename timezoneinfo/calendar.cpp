@@ -27,8 +27,14 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 
+#include <atomic>
+#include <charconv>
+#include <chrono>
 #include <sax/iostream.hpp>
+#include <string_view>
+#include <system_error>
 
 /*
     typedef struct _SYSTEMTIME {
@@ -61,10 +67,14 @@ wintime_t nixtime_to_wintime ( nixtime_t const nixtime_ ) noexcept {
     return wt;
 }
 
+#define TICKS_PER_MS 10'000ULL
+#define U_TPD 864'000'000'000ULL
+
+#if _WIN32
+
 wintime_t wintime ( ) noexcept {
     wintime_t wt;
     GetSystemTimeAsFileTime ( wt.data ( ) );
-    wt.set_utc ( );
     return wt;
 }
 
@@ -80,11 +90,50 @@ systime_t localtime ( ) noexcept {
     return lt;
 }
 
+#else
+
+wintime_t wintime ( ) noexcept {
+    wintime_t wt;
+    wt.as_uint64 ( ) = static_cast<std::uint64_t> (
+        std::chrono::duration_cast<std::chrono::duration<std::int64_t, std::ratio<1, 10'000'000>>> (
+            std::chrono::system_clock::now ( ).time_since_epoch ( ) )
+            .count ( ) ) +
+        WIN_TO_NIX_EPOCH;
+    return wt;
+}
+
+systime_t systime ( ) noexcept { return wintime_to_systime ( wintime ( ) ); }
+
+systime_t localtime ( ) noexcept {
+    wintime_t const wt = wintime ( );
+    std::time_t const nt = wintime_to_nixtime ( wt );
+    std::tm tm{ };
+    localtime_r ( &nt, &tm );
+    systime_t lt      = tm_to_systime ( tm );
+    lt.wMilliseconds = static_cast<std::uint16_t> ( ( wt.as_uint64 ( ) / TICKS_PER_MS ) % 1'000ULL );
+    return lt;
+}
+
+#endif
+
 nixtime_t nixtime ( ) noexcept { return wintime_to_nixtime ( wintime ( ) ); }
 
+// Identical to FileTimeToSystemTime ( ), wintime_ values with the high bit set are not valid.
 systime_t wintime_to_systime ( wintime_t const wintime_ ) noexcept {
     systime_t st{ };
-    FileTimeToSystemTime ( wintime_.data ( ), &st );
+    std::uint64_t const t = wintime_.as_uint64 ( );
+    if ( t >> 63 )
+        return st;
+    std::uint64_t const days = t / U_TPD, ms = ( t % U_TPD ) / TICKS_PER_MS;
+    civil_t const date       = civil_from_days ( static_cast<std::int64_t> ( days ) - days_from_winepoch_to_nix );
+    st.wYear                 = static_cast<std::uint16_t> ( date.year );
+    st.wMonth                = static_cast<std::uint16_t> ( date.month );
+    st.wDayOfWeek            = static_cast<std::uint16_t> ( weekday_from_windays ( static_cast<std::int64_t> ( days ) ) );
+    st.wDay                  = static_cast<std::uint16_t> ( date.day );
+    st.wHour                 = static_cast<std::uint16_t> ( ms / 3'600'000ULL );
+    st.wMinute               = static_cast<std::uint16_t> ( ( ms / 60'000ULL ) % 60ULL );
+    st.wSecond               = static_cast<std::uint16_t> ( ( ms / 1'000ULL ) % 60ULL );
+    st.wMilliseconds         = static_cast<std::uint16_t> ( ms % 1'000ULL );
     return st;
 }
 
@@ -92,10 +141,18 @@ systime_t nixtime_to_systime ( nixtime_t const nixtime_ ) noexcept {
     return wintime_to_systime ( nixtime_to_wintime ( nixtime_ ) );
 }
 
+// Identical to SystemTimeToFileTime ( ), invalid dates return a zero wintime_t, wDayOfWeek is ignored.
 wintime_t systime_to_wintime ( systime_t const & systime_ ) noexcept {
     wintime_t wt;
-    SystemTimeToFileTime ( &systime_, wt.data ( ) );
-    wt.set_utc ( );
+    if ( systime_.wYear < 1'601 or systime_.wYear > 30'827 or systime_.wMonth < 1 or systime_.wMonth > 12 or not systime_.wDay or
+         systime_.wDay > days_month ( systime_.wYear, systime_.wMonth ) or systime_.wHour > 23 or systime_.wMinute > 59 or
+         systime_.wSecond > 59 or systime_.wMilliseconds > 999 )
+        return wt;
+    std::uint64_t const days = static_cast<std::uint64_t> ( days_from_civil ( systime_.wYear, systime_.wMonth, systime_.wDay ) +
+                                                            days_from_winepoch_to_nix );
+    wt.as_uint64 ( ) = days * U_TPD + ( ( ( systime_.wHour * 60ULL + systime_.wMinute ) * 60ULL + systime_.wSecond ) * 1'000ULL +
+                                        systime_.wMilliseconds ) *
+                                          TICKS_PER_MS;
     return wt;
 }
 
@@ -103,6 +160,9 @@ nixtime_t systime_to_nixtime ( systime_t const & systime_ ) noexcept {
     return wintime_to_nixtime ( systime_to_wintime ( systime_ ) );
 }
 
+#undef TICKS_PER_MS
+#undef U_TPD
+
 std::tm systime_to_tm ( systime_t const & systime_ ) noexcept {
     std::tm tmp{ };
     tmp.tm_sec                        = systime_.wSecond;
@@ -151,13 +211,9 @@ typedef struct _TIME_DYNAMIC_ZONE_INFORMATION {
 } DYNAMIC_TIME_ZONE_INFORMATION, *PDYNAMIC_TIME_ZONE_INFORMATION;
 */
 
-#if _WIN32
-#    define timegm _mkgmtime
-#endif
-
-int today_year ( ) noexcept { return systime ( ).wYear; }
-int today_month ( ) noexcept { return systime ( ).wMonth; }
-int today_day ( ) noexcept { return systime ( ).wDay; }
+int today_year ( ) noexcept { return today_utc ( ).year; }
+int today_month ( ) noexcept { return today_utc ( ).month; }
+int today_day ( ) noexcept { return today_utc ( ).day; }
 
 bool is_leap_year ( int const y_ ) noexcept { return ( ( y_ % 4 == 0 ) and ( y_ % 100 != 0 ) ) or ( y_ % 400 == 0 ); }
 
@@ -198,11 +254,7 @@ int last_weekday ( int y_, int m_ ) noexcept {
 }
 
 std::time_t last_weekday_time ( int const y_, int const m_, int const w_ ) noexcept {
-    std::tm date{ };
-    date.tm_year = y_ - 1'900; // two digit y_!
-    date.tm_mon  = m_ - 1;
-    date.tm_mday = last_weekday_day ( y_, m_, w_ );
-    return timegm ( &date );
+    return static_cast<std::time_t> ( days_from_civil ( y_, m_, last_weekday_day ( y_, m_, w_ ) ) * 86'400LL );
 }
 
 bool is_weekend ( int const y_, int const m_, int const d_ ) noexcept {
@@ -212,15 +264,9 @@ bool is_weekend ( int const y_, int const m_, int const d_ ) noexcept {
 
 bool is_weekday ( int const y_, int const m_, int const d_ ) noexcept { return not is_weekend ( y_, m_, d_ ); }
 
-bool is_today_weekend ( ) noexcept {
-    systime_t const st = systime ( );
-    return is_weekend ( st.wYear, st.wMonth, st.wDay );
-}
+bool is_today_weekend ( ) noexcept { return today_utc ( ).is_weekend ( ); }
 
-bool is_today_weekday ( ) noexcept {
-    systime_t const st = systime ( );
-    return is_weekday ( st.wYear, st.wMonth, st.wDay );
-}
+bool is_today_weekday ( ) noexcept { return not today_utc ( ).is_weekend ( ); }
 
 int first_weekday_day ( int const y_, int const m_, int const w_ ) noexcept {
     return ( 1 + ( ( 7 - first_weekday ( y_, m_ ) + w_ ) % 7 ) );
@@ -236,47 +282,94 @@ int weekday_day ( int const n_, int const y_, int const m_, int const w_ ) noexc
 
 int last_weekday_day ( int const y_, int const m_, int const w_ ) noexcept { return weekday_day ( 5, y_, m_, w_ ); }
 
-#if _WIN32
-#    undef timegm
-#endif
+std::string calendar ( int const y_, int const m_ ) noexcept {
+    char buffer[ max_month_text ];
+    return { buffer, render_month ( buffer, cached_month ( y_, m_ ) ) };
+}
 
-#ifndef FMT_USE_GRISU
-#    define FMT_USE_GRISU 1
-#endif
+month_t make_month ( int const y_, int const m_ ) noexcept {
+    // day_week ( ) only holds for the proleptic Gregorian years AD, the calendar repeats every 400 years.
+    int const y = y_ < 1 ? ( y_ % 400 + 400 ) % 400 + 400 : y_;
+    month_t m;
+    m.year      = static_cast<std::int16_t> ( y_ );
+    m.month     = static_cast<std::int8_t> ( m_ );
+    int const f = day_week ( y, m_, 1 ), l = days_month ( y, m_ ), w = year_weeks ( y, m_, 1 );
+    m.weeks     = static_cast<std::int8_t> ( ( f + l + 6 ) / 7 );
+    for ( int r = 0; r < m.weeks; ++r )
+        m.week_num[ r ] = static_cast<std::int8_t> ( w + r );
+    for ( int d = 1; d <= l; ++d )
+        m.days[ ( f + d - 1 ) / 7 ][ ( f + d - 1 ) % 7 ] = static_cast<std::int8_t> ( d );
+    return m;
+}
 
-#include <fmt/chrono.h>
-#include <fmt/compile.h>
-#include <fmt/core.h>
-#include <fmt/format.h>
-
-[[nodiscard]] std::string calendar ( int const y_, int const m_ ) noexcept {
-    std::string s;
-    s.reserve ( 192 );
-    s.append ( ( 20 - std::strlen ( month_of_the_year[ m_ - 1 ] ) ) / 2, ' ' );
-    s.append ( fmt::format ( "{} {}\n  # Su Mo Tu We Th Fr Sa\n", month_of_the_year[ m_ - 1 ], y_ ) );
-    int w = year_weeks ( y_, m_, 1 ), f = day_week ( y_, m_, 1 );
-    // first line.
-    s.append ( fmt::format ( "{:3}", w++ ) );
-    s.append ( 3 * f, ' ' );
-    int c = 1;
-    for ( ; f < 7; ++f )
-        s.append ( fmt::format ( "{:3}", c++ ) );
-    s.push_back ( '\n' );
-    int const l = days_month ( y_, m_ );
-    // middle lines.
-    while ( c <= ( l - 7 ) ) {
-        s.append ( fmt::format ( "{:3}", w++ ) );
-        for ( int i = 0; i < 7; ++i, ++c )
-            s.append ( fmt::format ( "{:3}", c ) );
-        s.push_back ( '\n' );
+namespace {
+
+// The memo, the months of the years y with y % 400 == i in slot i. A slot is claimed (1) by the thread that computes it,
+// which publishes it (2) when done, other threads compute the months they need meanwhile.
+struct year_months_t {
+    month_t months[ 12 ];
+};
+
+year_months_t g_years[ 400 ];
+std::atomic<std::uint8_t> g_years_state[ 400 ]{ };
+
+} // namespace
+
+month_t cached_month ( int const y_, int const m_ ) noexcept {
+    if ( y_ < 1 ) // The slot is computed with the years AD.
+        return make_month ( y_, m_ );
+    std::size_t const i               = static_cast<std::size_t> ( ( y_ % 400 + 400 ) % 400 );
+    std::atomic<std::uint8_t> & state = g_years_state[ i ];
+    if ( 2u != state.load ( std::memory_order_acquire ) ) {
+        std::uint8_t empty = 0u;
+        if ( not state.compare_exchange_strong ( empty, 1u, std::memory_order_acquire ) )
+            return make_month ( y_, m_ );
+        for ( int m = 1; m <= 12; ++m )
+            g_years[ i ].months[ m - 1 ] = make_month ( y_, m );
+        state.store ( 2u, std::memory_order_release );
     }
-    // last line (iff applicable).
-    if ( c <= l ) {
-        s.append ( fmt::format ( "{:3}", w ) );
-        do {
-            s.append ( fmt::format ( "{:3}", c++ ) );
-        } while ( c <= l );
-        s.push_back ( '\n' );
+    month_t m = g_years[ i ].months[ m_ - 1 ];
+    m.year    = static_cast<std::int16_t> ( y_ );
+    return m;
+}
+
+char * render_month ( char * out_, month_t const & m_ ) noexcept {
+    // A number in a cell of 3 chars, right aligned.
+    auto const cell = [] ( char * p_, int const n_ ) noexcept {
+        p_[ 0 ] = ' ';
+        p_[ 1 ] = n_ < 10 ? ' ' : static_cast<char> ( '0' + n_ / 10 );
+        p_[ 2 ] = static_cast<char> ( '0' + n_ % 10 );
+        return p_ + 3;
+    };
+    std::size_t const name_size = std::strlen ( month_of_the_year[ m_.month - 1 ] );
+    std::memset ( out_, ' ', ( 20u - name_size ) / 2u );
+    out_ += ( 20u - name_size ) / 2u;
+    std::memcpy ( out_, month_of_the_year[ m_.month - 1 ], name_size );
+    out_ += name_size;
+    *out_++ = ' ';
+    // Up to 6 chars, -32768.
+    std::to_chars_result const year = std::to_chars ( out_, out_ + 6, m_.year );
+    assert ( std::errc{ } == year.ec );
+    out_ = year.ptr;
+    constexpr std::string_view header = "\n  # Su Mo Tu We Th Fr Sa\n";
+    std::memcpy ( out_, header.data ( ), header.size ( ) );
+    out_ += header.size ( );
+    for ( int r = 0; r < m_.weeks; ++r ) {
+        out_ = cell ( out_, m_.week_num[ r ] );
+        // Leading blanks, up to the last day of the row.
+        int last = 6;
+        while ( not m_.days[ r ][ last ] )
+            --last;
+        for ( int d = 0; d <= last; ++d ) {
+            if ( m_.days[ r ][ d ] ) {
+                out_ = cell ( out_, m_.days[ r ][ d ] );
+            }
+            else {
+                std::memset ( out_, ' ', 3u );
+                out_ += 3;
+            }
+        }
+        *out_++ = '\n';
     }
-    return s;
+    return out_;
 }
@@ -0,0 +1,139 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the \"Software\"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "clock.hpp"
+
+#include <cassert>
+#include <cstdint>
+
+#include <algorithm>
+#include <atomic>
+#include <optional>
+
+#define TICKS_PER_MS 10'000LL
+#define TICKS_PER_S 10'000'000LL
+
+systime_t local_day_t::local_systime ( std::int64_t const utc_ ) const noexcept {
+    assert ( contains ( utc_ ) );
+    std::int64_t const t = utc_ + offset - midnight; // [ 0, ticks_per_day ).
+    std::int64_t const s = t / TICKS_PER_S;
+    systime_t st{ };
+    st.wYear         = static_cast<std::uint16_t> ( year );
+    st.wMonth        = static_cast<std::uint16_t> ( month );
+    st.wDayOfWeek    = static_cast<std::uint16_t> ( day_of_week );
+    st.wDay          = static_cast<std::uint16_t> ( day );
+    st.wHour         = static_cast<std::uint16_t> ( s / 3'600 );
+    st.wMinute       = static_cast<std::uint16_t> ( s / 60 % 60 );
+    st.wSecond       = static_cast<std::uint16_t> ( s % 60 );
+    st.wMilliseconds = static_cast<std::uint16_t> ( t / TICKS_PER_MS % 1'000 );
+    return st;
+}
+
+local_day_t make_local_day ( zone_t const & zone_, std::int64_t const utc_ ) noexcept {
+    period_t const p        = zone_.period ( utc_ );
+    std::int64_t const days = ( utc_ + p.offset ) / ticks_per_day; // Since 1601-01-01, local.
+    civil_t const date      = civil_from_days ( days - days_from_winepoch_to_nix );
+    local_day_t d;
+    d.midnight = days * ticks_per_day;
+    d.offset   = p.offset;
+    d.begin    = d.midnight - p.offset;
+    d.end      = d.begin + ticks_per_day;
+    // The periods are split where the offset does not change as well (at the turn of a UTC year), only a transition
+    // bounds the day.
+    std::int64_t begin = p.begin, end = p.end;
+    for ( period_t q; begin > d.begin and ( q = zone_.period ( begin - 1 ) ).offset == p.offset; )
+        begin = q.begin;
+    for ( period_t q; end < d.end and ( q = zone_.period ( end ) ).offset == p.offset; )
+        end = q.end;
+    d.begin       = std::max ( begin, d.begin );
+    d.end         = std::min ( end, d.end );
+    d.year        = static_cast<std::int16_t> ( date.year );
+    d.month       = static_cast<std::int8_t> ( date.month );
+    d.day         = static_cast<std::int8_t> ( date.day );
+    d.day_of_week = static_cast<std::int8_t> ( weekday_from_windays ( days ) );
+    return d;
+}
+
+std::optional<local_day_t> local_day_slot_t::load ( zone_t const & zone_, std::int64_t const utc_ ) const noexcept {
+    std::uint32_t const sequence = m_sequence.load ( std::memory_order_acquire );
+    if ( sequence & 1u )
+        return { };
+    zone_t const * const zone = m_zone.load ( std::memory_order_relaxed );
+    local_day_t d;
+    d.begin                  = m_begin.load ( std::memory_order_relaxed );
+    d.end                    = m_end.load ( std::memory_order_relaxed );
+    d.offset                 = m_offset.load ( std::memory_order_relaxed );
+    d.midnight               = m_midnight.load ( std::memory_order_relaxed );
+    std::uint64_t const date = m_date.load ( std::memory_order_relaxed );
+    std::atomic_thread_fence ( std::memory_order_acquire );
+    if ( sequence != m_sequence.load ( std::memory_order_relaxed ) or &zone_ != zone or not d.contains ( utc_ ) )
+        return { };
+    d.year        = static_cast<std::int16_t> ( date >> 24 );
+    d.month       = static_cast<std::int8_t> ( date >> 16 );
+    d.day         = static_cast<std::int8_t> ( date >> 8 );
+    d.day_of_week = static_cast<std::int8_t> ( date );
+    return d;
+}
+
+void local_day_slot_t::store ( zone_t const & zone_, local_day_t const & day_ ) noexcept {
+    std::uint32_t sequence = m_sequence.load ( std::memory_order_relaxed );
+    if ( ( sequence & 1u ) or not m_sequence.compare_exchange_strong ( sequence, sequence + 1u, std::memory_order_relaxed ) )
+        return;
+    std::atomic_thread_fence ( std::memory_order_release );
+    m_zone.store ( &zone_, std::memory_order_relaxed );
+    m_begin.store ( day_.begin, std::memory_order_relaxed );
+    m_end.store ( day_.end, std::memory_order_relaxed );
+    m_offset.store ( day_.offset, std::memory_order_relaxed );
+    m_midnight.store ( day_.midnight, std::memory_order_relaxed );
+    m_date.store ( static_cast<std::uint64_t> ( static_cast<std::uint16_t> ( day_.year ) ) << 24 |
+                       static_cast<std::uint64_t> ( static_cast<std::uint8_t> ( day_.month ) ) << 16 |
+                       static_cast<std::uint64_t> ( static_cast<std::uint8_t> ( day_.day ) ) << 8 |
+                       static_cast<std::uint8_t> ( day_.day_of_week ),
+                   std::memory_order_relaxed );
+    m_sequence.store ( sequence + 2u, std::memory_order_release );
+}
+
+namespace {
+
+constinit local_day_slot_t g_days[ zone_cache_t::max_size ];
+constinit local_day_slot_t g_day_utc;
+
+[[nodiscard]] local_day_t today ( local_day_slot_t & slot_, zone_t const & zone_, std::int64_t const now_ ) noexcept {
+    if ( std::optional<local_day_t> const d = slot_.load ( zone_, now_ ); d )
+        return *d;
+    local_day_t const d = make_local_day ( zone_, now_ );
+    slot_.store ( zone_, d );
+    return d;
+}
+
+} // namespace
+
+local_day_t today_in_zone ( zone_id_t const id_, zone_t const & zone_, std::int64_t const now_ ) noexcept {
+    assert ( id_.value < zone_cache_t::max_size );
+    return today ( g_days[ id_.value ], zone_, now_ );
+}
+
+local_day_t today_utc ( std::int64_t const now_ ) noexcept { return today ( g_day_utc, get_zone_utc ( ), now_ ); }
+
+#undef TICKS_PER_S
+#undef TICKS_PER_MS
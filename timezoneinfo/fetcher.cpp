@@ -0,0 +1,273 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the \"Software\"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "fetcher.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include <fstream>
+#include <list>
+#include <memory>
+#include <optional>
+
+#include <curlpp/Easy.hpp>
+#include <curlpp/Infos.hpp>
+#include <curlpp/Options.hpp>
+#include <curlpp/cURLpp.hpp>
+
+#include <curl/curl.h>
+
+namespace {
+
+using steady_clock = std::chrono::steady_clock;
+
+// The longest the fetch loop sleeps, the latency of a stop request.
+constexpr std::chrono::milliseconds poll_interval{ 100 };
+
+// The value of the header line_, if it is named name_ (lower case), trimmed.
+[[nodiscard]] std::optional<std::string_view> header_value ( std::string_view line_, std::string_view const name_ ) noexcept {
+    if ( line_.size ( ) <= name_.size ( ) or ':' != line_[ name_.size ( ) ] or
+         not std::equal ( std::begin ( name_ ), std::end ( name_ ), std::begin ( line_ ),
+                          [] ( char const n_, char const c_ ) { return n_ == ( c_ | ( 'A' <= c_ and c_ <= 'Z' ? 0x20 : 0x00 ) ); } ) )
+        return { };
+    line_.remove_prefix ( name_.size ( ) + 1u );
+    while ( line_.size ( ) and ( ' ' == line_.front ( ) or '\t' == line_.front ( ) ) )
+        line_.remove_prefix ( 1u );
+    while ( line_.size ( ) and std::strchr ( " \t\r\n", line_.back ( ) ) )
+        line_.remove_suffix ( 1u );
+    return line_;
+}
+
+// A request on its way, one attempt at a time, each with an easy handle of its own on the (shared) multi handle.
+class transfer_t {
+
+    public:
+    explicit transfer_t ( fetch_request_t & request_ ) noexcept : m_request{ request_ } {}
+
+    transfer_t ( transfer_t const & ) = delete;
+    transfer_t & operator= ( transfer_t const & ) = delete;
+
+    // Starts the next attempt, false if it cannot (the file cannot be written), the request is then done.
+    [[nodiscard]] bool start ( CURLM * const multi_ );
+    // Ends the attempt with result_, returns whether the request is done, if not, it is retried at retry_at ( ).
+    [[nodiscard]] bool finish ( CURLM * const multi_, CURLcode const result_ );
+    // Ends the ongoing attempt, if any, the request has failed.
+    void abandon ( CURLM * const multi_ );
+
+    [[nodiscard]] fetch_request_t const & request ( ) const noexcept { return m_request; }
+    [[nodiscard]] CURL * handle ( ) const noexcept { return m_easy ? m_easy->getHandle ( ) : nullptr; }
+    [[nodiscard]] bool waiting ( ) const noexcept { return m_waiting; }
+    [[nodiscard]] steady_clock::time_point retry_at ( ) const noexcept { return m_retry_at; }
+
+    private:
+    void close ( CURLM * const multi_ );
+
+    fetch_request_t & m_request;
+    fs::path m_part; // The file written, renamed over the path of the request once complete.
+    std::ofstream m_file;
+    std::unique_ptr<curlpp::Easy> m_easy;
+    download_validators_t m_received;
+    steady_clock::time_point m_retry_at;
+    bool m_waiting = false;
+};
+
+bool transfer_t::start ( CURLM * const multi_ ) {
+    fetch_request_t & r = m_request;
+    m_waiting           = false;
+    if ( r.attempts++ and r.restart )
+        r.restart ( );
+    m_part = fs::path{ r.path } += L".part";
+    m_file.open ( m_part, std::ios::binary | std::ios::trunc );
+    if ( not m_file ) {
+        r.error = "cannot write " + m_part.string ( );
+        return false;
+    }
+    m_received = { };
+    m_easy     = std::make_unique<curlpp::Easy> ( );
+    // Write to the file and the sink, a short count ends the transfer.
+    m_easy->setOpt<curlpp::options::WriteFunction> ( [ this ] ( char * data_, std::size_t size_, std::size_t n_ ) {
+        std::string_view const piece{ data_, size_ * n_ };
+        m_file.write ( piece.data ( ), static_cast<std::streamsize> ( piece.size ( ) ) );
+        if ( m_request.sink )
+            m_request.sink ( piece );
+        return m_file ? piece.size ( ) : std::size_t{ 0u };
+    } );
+    // Keep the entity tag of the last response (redirects come first).
+    m_easy->setOpt<curlpp::options::HeaderFunction> ( [ this ] ( char * data_, std::size_t size_, std::size_t n_ ) {
+        std::string_view const line{ data_, size_ * n_ };
+        if ( line.starts_with ( "HTTP/" ) )
+            m_received.etag.clear ( );
+        else if ( std::optional<std::string_view> const etag = header_value ( line, "etag" ); etag )
+            m_received.etag = *etag;
+        return line.size ( );
+    } );
+    m_easy->setOpt<curlpp::options::FileTime> ( true );
+    // Ask for the file only if it changed, the entity tag takes precedence (on the server) if there is one.
+    if ( r.validators.etag.size ( ) )
+        m_easy->setOpt<curlpp::options::HttpHeader> ( std::list<std::string>{ "If-None-Match: " + r.validators.etag } );
+    if ( r.validators.last_modified ) {
+        m_easy->setOpt<curlpp::options::TimeCondition> ( CURL_TIMECOND_IFMODSINCE );
+        // A curl_off_t, a long is 32 bits on windows, and runs out in 2038.
+        curl_easy_setopt ( handle ( ), CURLOPT_TIMEVALUE_LARGE, static_cast<curl_off_t> ( r.validators.last_modified ) );
+    }
+    // Check if compressed file, if not, set encoding to 'deflate'.
+    if ( not r.url.ends_with ( "gz" ) )
+        m_easy->setOpt<curlpp::options::Encoding> ( "deflate" );
+    if ( r.timeout.count ( ) )
+        m_easy->setOpt<curlpp::options::TimeoutMs> ( static_cast<long> ( r.timeout.count ( ) ) );
+    m_easy->setOpt<curlpp::options::Url> ( r.url );
+    curl_multi_add_handle ( multi_, handle ( ) );
+    return true;
+}
+
+bool transfer_t::finish ( CURLM * const multi_, CURLcode const result_ ) {
+    fetch_request_t & r = m_request;
+    r.status            = download_status_t::failed;
+    r.response_code     = curlpp::infos::ResponseCode::get ( *m_easy );
+    r.error.clear ( );
+    if ( CURLE_OK == result_ ) {
+        long unmet = 0;
+        curl_easy_getinfo ( handle ( ), CURLINFO_CONDITION_UNMET, &unmet );
+        if ( 304 == r.response_code or unmet )
+            r.status = download_status_t::not_modified;
+        else if ( 200 == r.response_code or 0 == r.response_code ) // 0, not http, f.e. file://.
+            r.status = download_status_t::changed;
+        else
+            r.error = "HTTP " + std::to_string ( r.response_code );
+        curl_off_t file_time = -1;
+        if ( CURLE_OK == curl_easy_getinfo ( handle ( ), CURLINFO_FILETIME_T, &file_time ) and file_time > 0 )
+            m_received.last_modified = static_cast<std::uint64_t> ( file_time );
+    }
+    else {
+        r.error = curl_easy_strerror ( result_ );
+    }
+    m_file.flush ( );
+    if ( not m_file and download_status_t::changed == r.status ) {
+        r.status = download_status_t::failed;
+        r.error  = "cannot write " + m_part.string ( );
+    }
+    close ( multi_ );
+    // The file replaces the one there was only if it is complete, and verified.
+    std::error_code ec;
+    if ( download_status_t::changed == r.status and r.verify and not r.verify ( ) ) {
+        r.status = download_status_t::failed;
+        r.error  = "rejected " + r.url;
+        fs::remove ( m_part, ec );
+        return true;
+    }
+    if ( download_status_t::changed == r.status ) {
+        fs::rename ( m_part, r.path, ec );
+        if ( not ec ) {
+            r.validators = std::move ( m_received );
+            return true;
+        }
+        r.status = download_status_t::failed;
+        r.error  = ec.message ( );
+    }
+    fs::remove ( m_part, ec );
+    if ( download_status_t::not_modified == r.status )
+        return true;
+    // Retry what may go better next time, not what the server refused.
+    if ( r.attempts > r.retries or ( CURLE_OK == result_ and r.response_code < 500 and 429 != r.response_code ) )
+        return true;
+    m_retry_at = steady_clock::now ( ) + r.backoff * ( 1 << std::min ( r.attempts - 1, 16 ) );
+    m_waiting  = true;
+    return false;
+}
+
+void transfer_t::abandon ( CURLM * const multi_ ) {
+    m_waiting = false;
+    if ( not m_easy )
+        return;
+    close ( multi_ );
+    std::error_code ec;
+    fs::remove ( m_part, ec );
+    m_request.status = download_status_t::failed;
+    m_request.error  = "abandoned";
+}
+
+void transfer_t::close ( CURLM * const multi_ ) {
+    curl_multi_remove_handle ( multi_, handle ( ) );
+    m_easy.reset ( );
+    m_file.close ( );
+}
+
+} // namespace
+
+void fetch ( std::span<fetch_request_t> requests_, std::stop_token const & stop_ ) {
+    CURLM * const multi = curl_multi_init ( );
+    std::list<transfer_t> transfers; // Stay put, the handles refer to them.
+    std::size_t pending = 0u;        // Ongoing, or waiting to be retried.
+    auto const done     = [ ] ( transfer_t const & t_ ) {
+        if ( t_.request ( ).done )
+            t_.request ( ).done ( t_.request ( ) );
+    };
+    for ( fetch_request_t & r : requests_ ) {
+        r.status        = download_status_t::failed;
+        r.response_code = 0;
+        r.attempts      = 0;
+        r.error.clear ( );
+        if ( transfer_t & t = transfers.emplace_back ( r ); t.start ( multi ) )
+            ++pending;
+        else
+            done ( t );
+    }
+    while ( pending and not stop_.stop_requested ( ) ) {
+        int running = 0, left = 0;
+        curl_multi_perform ( multi, &running );
+        while ( CURLMsg const * const message = curl_multi_info_read ( multi, &left ) ) {
+            if ( CURLMSG_DONE != message->msg )
+                continue;
+            auto const it = std::find_if ( std::begin ( transfers ), std::end ( transfers ),
+                                           [ message ] ( transfer_t const & t_ ) { return message->easy_handle == t_.handle ( ); } );
+            if ( std::end ( transfers ) != it and it->finish ( multi, message->data.result ) ) {
+                --pending;
+                done ( *it );
+            }
+        }
+        // Start the retries that are due, sleep until the next one is, or the network has something (or a stop is due).
+        steady_clock::time_point const now = steady_clock::now ( );
+        steady_clock::time_point next      = now + poll_interval;
+        for ( transfer_t & t : transfers ) {
+            if ( not t.waiting ( ) )
+                continue;
+            if ( t.retry_at ( ) > now ) {
+                next = std::min ( next, t.retry_at ( ) );
+            }
+            else if ( t.start ( multi ) ) {
+                next = now;
+            }
+            else {
+                --pending;
+                done ( t );
+            }
+        }
+        if ( pending and next > now )
+            curl_multi_wait ( multi, nullptr, 0u,
+                              static_cast<int> ( std::chrono::ceil<std::chrono::milliseconds> ( next - now ).count ( ) ), nullptr );
+    }
+    for ( transfer_t & t : transfers )
+        t.abandon ( multi );
+    curl_multi_cleanup ( multi );
+}
@@ -0,0 +1,96 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the \"Software\"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "gzip_reader.hpp"
+
+#include <climits>
+
+#include <zlib.h>
+
+gzip_reader_t::gzip_reader_t ( fs::path const & path_ ) :
+    m_file{ path_ }, m_stream{ std::make_unique<z_stream_s> ( ) }, m_block{ std::make_unique<char[]> ( block_size ) } {
+    if ( not m_file.is_open ( ) or m_file.size ( ) > UINT_MAX )
+        return;
+    m_stream->next_in  = reinterpret_cast<Bytef *> ( const_cast<char *> ( m_file.data ( ) ) );
+    m_stream->avail_in = static_cast<uInt> ( m_file.size ( ) );
+    m_ok               = Z_OK == inflateInit2 ( m_stream.get ( ), 15 + 16 ); // Max window, gzip header.
+    m_end              = not m_ok;
+}
+
+gzip_reader_t::~gzip_reader_t ( ) noexcept { inflateEnd ( m_stream.get ( ) ); } // A no-op if never initialized.
+
+std::string_view gzip_reader_t::read ( ) {
+    if ( m_end )
+        return { };
+    m_stream->next_out  = reinterpret_cast<Bytef *> ( m_block.get ( ) );
+    m_stream->avail_out = static_cast<uInt> ( block_size );
+    while ( m_stream->avail_out ) {
+        int const status = inflate ( m_stream.get ( ), Z_NO_FLUSH );
+        if ( Z_STREAM_END == status ) {
+            if ( not m_stream->avail_in or Z_OK != inflateReset ( m_stream.get ( ) ) ) { // Next member, if any.
+                m_end = true;
+                break;
+            }
+        }
+        else if ( Z_OK != status ) {
+            m_ok = false, m_end = true;
+            break;
+        }
+    }
+    return { m_block.get ( ), block_size - m_stream->avail_out };
+}
+
+gzip_inflater_t::gzip_inflater_t ( ) :
+    m_stream{ std::make_unique<z_stream_s> ( ) }, m_block{ std::make_unique<char[]> ( block_size ) } {
+    m_ok = Z_OK == inflateInit2 ( m_stream.get ( ), 15 + 16 ); // Max window, gzip header.
+}
+
+gzip_inflater_t::~gzip_inflater_t ( ) noexcept { inflateEnd ( m_stream.get ( ) ); }
+
+void gzip_inflater_t::input ( std::string_view const piece_ ) noexcept {
+    m_stream->next_in  = reinterpret_cast<Bytef *> ( const_cast<char *> ( piece_.data ( ) ) );
+    m_stream->avail_in = static_cast<uInt> ( piece_.size ( ) );
+}
+
+std::string_view gzip_inflater_t::inflate_block ( ) noexcept {
+    m_stream->next_out  = reinterpret_cast<Bytef *> ( m_block.get ( ) );
+    m_stream->avail_out = static_cast<uInt> ( block_size );
+    while ( m_ok and m_stream->avail_out and ( m_stream->avail_in or m_more ) ) {
+        int const status = inflate ( m_stream.get ( ), Z_NO_FLUSH );
+        m_more           = not m_stream->avail_out; // Output may be pending, with or without input.
+        if ( Z_STREAM_END == status ) {
+            m_complete = true;
+            m_ok       = Z_OK == inflateReset ( m_stream.get ( ) ); // Next member, if any.
+        }
+        else if ( Z_OK == status ) {
+            m_complete = false;
+        }
+        else if ( Z_BUF_ERROR != status ) { // Z_BUF_ERROR: no progress possible, wait for more input.
+            m_ok = false;
+        }
+        else {
+            break;
+        }
+    }
+    return { m_block.get ( ), block_size - m_stream->avail_out };
+}
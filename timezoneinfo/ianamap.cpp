@@ -22,10 +22,10 @@
 // SOFTWARE.
 
 #include "timezoneinfo.hpp"
-#include "zfstream.hpp"
+#include "gzip_reader.hpp"
+#include "mapped_file.hpp"
+#include "windowszones.hpp"
 
-#include <fstream>
-#include <map>
 #include <sax/iostream.hpp>
 #include <sax/stl.hpp>
 #include <sax/string_split.hpp>
@@ -34,14 +34,10 @@
 
 #include <tinyxml2.h>
 
-void download_windowszones ( ) {
-    download ( "https://raw.githubusercontent.com/unicode-org/cldr/master/common/supplemental/windowsZones.xml",
-               g_windowszones_path );
-}
+void download_windowszones ( ) { download ( source_url ( snapshot_source_t::windowszones ).c_str ( ), windowszones_path ( ) ); }
 
 void download_windowszones_alt ( ) {
-    download ( "https://raw.githubusercontent.com/mj1856/TimeZoneConverter/master/src/TimeZoneConverter/Data/Mapping.csv.gz",
-               g_windowszones_alt_path );
+    download ( source_url ( snapshot_source_t::windowszones_alt ).c_str ( ), windowszones_alt_path ( ) );
 }
 
 char const * element_to_cstr ( tinyxml2::XMLElement const * const element_, char const name_[] ) noexcept {
@@ -50,72 +46,96 @@ char const * element_to_cstr ( tinyxml2::XMLElement const * const element_, char
     return out;
 }
 
-[[nodiscard]] IanaMap build_iana_to_windowszones_map ( ) {
-    WinTzSet db = fill_timezones_db ( );
-    IanaMap map;
+namespace {
+
+void insert_map_zone ( IanaMapBuilder & map_, WinTzSet const & db_, map_zone_t const & zone_ ) {
+    if ( std::end ( db_ ) != db_.find ( zone_.other ) )
+        for_each_iana_name ( zone_.type, [ &map_, &zone_ ] ( std::string_view const iana_ ) {
+            map_.insert ( iana_, zone_.other, zone_.territory );
+        } );
+}
+
+void insert_mapping_line ( IanaMapBuilder & map_, WinTzSet const & db_, std::string_view const line_ ) {
+    std::string_view fields[ 3 ]; // Windows name, territory code, space separated IANA names.
+    if ( 3u == split_fields ( line_, ',', fields ) and std::end ( db_ ) != db_.find ( fields[ 0 ] ) )
+        for_each_iana_name ( fields[ 2 ], [ &map_, &fields ] ( std::string_view const iana_ ) {
+            map_.insert ( iana_, fields[ 0 ], fields[ 1 ], duplicate_code_t::keep_territory );
+        } );
+}
+
+} // namespace
+
+[[nodiscard]] IanaMap parse_windowszones ( fs::path const & path_, WinTzSet const & db_ ) {
+    IanaMapBuilder map;
+    mapped_file_t const file ( path_ );
+    scan_map_zones ( file.view ( ), [ &map, &db_ ] ( map_zone_t const & zone_ ) { insert_map_zone ( map, db_, zone_ ); } );
+    return map.build ( );
+}
+
+[[nodiscard]] IanaMap parse_windowszones_tinyxml2 ( fs::path const & path_, WinTzSet const & db_ ) {
+    IanaMapBuilder map;
     tinyxml2::XMLDocument doc;
-    if ( not fs::exists ( g_windowszones_path ) ) {
-        download_windowszones ( );
-        g_timestamps.insert_or_assign ( "last_windowszones_download", wintime ( ).as_uint64 ( ) );
-        save_timestamps ( );
-    }
-    doc.LoadFile ( g_windowszones_path.string ( ).c_str ( ) );
+    doc.LoadFile ( path_.string ( ).c_str ( ) );
     tinyxml2::XMLElement const * element = doc.FirstChildElement ( "supplementalData" )
                                                ->FirstChildElement ( "windowsZones" )
                                                ->FirstChildElement ( "mapTimezones" )
                                                ->FirstChildElement ( "mapZone" );
     tinyxml2::XMLElement const * const last_element = element->Parent ( )->LastChildElement ( "mapZone" );
     while ( true ) {
-        auto const other = element_to_cstr ( element, "other" );
-        if ( std::end ( db ) != db.find ( std::string{ other } ) ) {
-            auto const territory = element_to_cstr ( element, "territory" );
-            for ( auto & ia : sax::string_split ( std::string_view{ element_to_cstr ( element, "type" ) }, " " ) ) {
-                // if ( "Etc" == ia.substr ( 0u, 3u ) )
-                //     ia = ia.substr ( 4u, ia.size ( ) - 4 );
-                IanaMapKey ais{ ia };
-                auto it = map.find ( ais );
-                if ( std::end ( map ) == it )
-                    map.emplace ( std::move ( ais ), IanaMapValue{ std::string{ other }, std::string{ territory } } );
-                else if ( std::strncmp ( "001", it->second.code.c_str ( ), 3 ) )
-                    it->second.code = std::string{ "001" };
-            }
+        std::string_view const other = element_to_cstr ( element, "other" );
+        if ( std::end ( db_ ) != db_.find ( other ) ) {
+            std::string_view const territory = element_to_cstr ( element, "territory" );
+            for ( auto & ia : sax::string_split ( std::string_view{ element_to_cstr ( element, "type" ) }, " " ) )
+                map.insert ( ia, other, territory );
         }
         if ( element != last_element )
             element = element->NextSiblingElement ( );
         else
             break;
     }
-    return map;
+    return map.build ( );
+}
+
+[[nodiscard]] IanaMap build_iana_to_windowszones_map ( ) {
+    if ( not fs::exists ( windowszones_path ( ) ) ) {
+        download_windowszones ( );
+        set_timestamp ( "last_windowszones_download", wintime ( ).as_uint64 ( ) );
+        save_timestamps ( );
+    }
+    return parse_windowszones ( windowszones_path ( ), fill_timezones_db ( ) );
+}
+
+[[nodiscard]] IanaMap parse_windowszones_alt ( fs::path const & path_, WinTzSet const & db_ ) {
+    IanaMapBuilder map;
+    for_each_gzip_line ( path_, [ &map, &db_ ] ( std::string_view const line_ ) { insert_mapping_line ( map, db_, line_ ); } );
+    return map.build ( );
+}
+
+void windowszones_parser_t::feed ( std::string_view const piece_ ) {
+    m_buffer.append ( piece_ );
+    m_buffer.erase ( 0u, scan_map_zones ( m_buffer, [ this ] ( map_zone_t const & zone_ ) { insert_map_zone ( m_map, m_db, zone_ ); } ) );
+}
+
+IanaMap windowszones_parser_t::finish ( ) {
+    m_buffer.clear ( );
+    return m_map.build ( );
+}
+
+void windowszones_alt_parser_t::feed ( std::string_view const piece_ ) {
+    auto const insert = [ this ] ( std::string_view const line_ ) { insert_mapping_line ( m_map, m_db, line_ ); };
+    m_inflater.feed ( piece_, [ this, &insert ] ( std::string_view const block_ ) { m_lines.feed ( block_, insert ); } );
+}
+
+IanaMap windowszones_alt_parser_t::finish ( ) {
+    m_lines.finish ( [ this ] ( std::string_view const line_ ) { insert_mapping_line ( m_map, m_db, line_ ); } );
+    return m_inflater.ok ( ) ? m_map.build ( ) : IanaMap{ };
 }
 
 [[nodiscard]] IanaMap build_iana_to_windowszones_alt_map ( ) {
-    WinTzSet db = fill_timezones_db ( );
-    IanaMap map;
-    gzifstream inf;
-    char buf[ 512 ];
-    if ( not fs::exists ( g_windowszones_alt_path ) ) {
+    if ( not fs::exists ( windowszones_alt_path ( ) ) ) {
         download_windowszones_alt ( );
-        g_timestamps.insert_or_assign ( "last_windowszones_alt_download", wintime ( ).as_uint64 ( ) );
+        set_timestamp ( "last_windowszones_alt_download", wintime ( ).as_uint64 ( ) );
         save_timestamps ( );
     }
-    inf.rdbuf ( )->pubsetbuf ( 0, 0 ); // Unbuffered.
-    inf.open ( g_windowszones_alt_path.string ( ).c_str ( ), std::ios::binary | std::ifstream::in );
-    while ( inf.getline ( buf, 512 ) ) {
-        std::string_view buf_view = buf;
-        if ( '\r' == buf_view.back ( ) ) // If \r\n.
-            buf_view.remove_suffix ( 1u );
-        auto const line = sax::string_split ( buf_view, ',' );
-        if ( std::end ( db ) != db.find ( std::string{ line[ 0 ] } ) ) {
-            for ( auto const & ia : sax::string_split ( line[ 2 ], ' ' ) ) {
-                IanaMapKey ais{ ia };
-                auto const it = map.find ( ais );
-                if ( std::end ( map ) == it )
-                    map.emplace ( std::move ( ais ), IanaMapValue{ std::string{ line[ 0 ] }, std::string{ line[ 1 ] } } );
-                else if ( std::strncmp ( "001", line[ 1 ].data ( ), 3 ) )
-                    it->second.code = std::string{ "001" };
-            }
-        }
-    }
-    inf.close ( );
-    return map;
+    return parse_windowszones_alt ( windowszones_alt_path ( ), fill_timezones_db ( ) );
 }
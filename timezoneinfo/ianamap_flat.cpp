@@ -0,0 +1,141 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the \"Software\"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "ianamap.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// The IanaMap container, without dependencies on the rest of the library, the generator links it as well.
+
+IanaMap::IanaMap ( IanaMap const & other_ ) { assign ( other_ ); }
+IanaMap::IanaMap ( IanaMap && other_ ) noexcept { assign ( std::move ( other_ ) ); }
+
+IanaMap & IanaMap::operator= ( IanaMap const & other_ ) {
+    if ( this != &other_ )
+        assign ( other_ );
+    return *this;
+}
+
+IanaMap & IanaMap::operator= ( IanaMap && other_ ) noexcept {
+    if ( this != &other_ )
+        assign ( std::move ( other_ ) );
+    return *this;
+}
+
+// A copy of a view is a view, a copy of an owning map owns a copy.
+void IanaMap::assign ( IanaMap const & other_ ) {
+    m_arena_storage         = other_.m_arena_storage;
+    m_entries_storage       = other_.m_entries_storage;
+    m_displacements_storage = other_.m_displacements_storage;
+    m_slots_storage         = other_.m_slots_storage;
+    bind ( other_ );
+}
+
+void IanaMap::assign ( IanaMap && other_ ) noexcept {
+    m_arena_storage         = std::move ( other_.m_arena_storage );
+    m_entries_storage       = std::move ( other_.m_entries_storage );
+    m_displacements_storage = std::move ( other_.m_displacements_storage );
+    m_slots_storage         = std::move ( other_.m_slots_storage );
+    bind ( other_ );
+    other_.bind ( IanaMap{ } );
+}
+
+// Point the views at the own storage if owning, at the storage other_ views otherwise.
+void IanaMap::bind ( IanaMap const & other_ ) noexcept {
+    bool const owner = m_entries_storage.size ( );
+    m_arena          = owner ? std::string_view{ m_arena_storage } : other_.m_arena;
+    m_entries        = owner ? std::span<IanaMapEntry const>{ m_entries_storage } : other_.m_entries;
+    m_displacements  = owner ? std::span<std::uint32_t const>{ m_displacements_storage } : other_.m_displacements;
+    m_slots          = owner ? std::span<std::uint16_t const>{ m_slots_storage } : other_.m_slots;
+}
+
+IanaMapValue IanaMap::at ( std::string_view const key_ ) const {
+    std::size_t const i = index ( key_ );
+    if ( m_entries.size ( ) == i )
+        throw std::out_of_range{ "IanaMap::at ( ): unknown IANA time zone name" };
+    return value ( i ).second;
+}
+
+std::uint32_t IanaMapBuilder::append ( std::string_view const s_ ) {
+    std::uint32_t const offset = static_cast<std::uint32_t> ( m_arena.size ( ) );
+    m_arena.append ( s_ );
+    return offset;
+}
+
+void IanaMapBuilder::insert ( std::string_view const key_, std::string_view const name_, std::string_view const code_,
+                              duplicate_code_t const duplicate_ ) {
+    if ( key_.size ( ) > max_field_size or name_.size ( ) > max_field_size or code_.size ( ) > max_field_size )
+        return; // The sizes are stored in a byte.
+    m_entries.push_back ( { { append ( key_ ), append ( name_ ), append ( code_ ), static_cast<std::uint8_t> ( key_.size ( ) ),
+                              static_cast<std::uint8_t> ( name_.size ( ) ), static_cast<std::uint8_t> ( code_.size ( ) ) },
+                            duplicate_ } );
+}
+
+IanaMap IanaMapBuilder::build ( ) {
+    auto const string = [ this ] ( std::uint32_t const offset_, std::uint8_t const size_ ) noexcept {
+        return std::string_view{ m_arena.data ( ) + offset_, size_ };
+    };
+    auto const key  = [ &string ] ( entry_t const & e_ ) noexcept { return string ( e_.entry.key, e_.entry.key_size ); };
+    auto const code = [ &string ] ( entry_t const & e_ ) noexcept { return string ( e_.entry.code, e_.entry.code_size ); };
+    // Order by key, the first inserted first, and merge the duplicates.
+    std::stable_sort ( std::begin ( m_entries ), std::end ( m_entries ),
+                       [ &key ] ( entry_t const & a_, entry_t const & b_ ) noexcept { return key ( a_ ) < key ( b_ ); } );
+    IanaMap map;
+    map.m_entries_storage.reserve ( m_entries.size ( ) );
+    map.m_arena_storage.reserve ( m_arena.size ( ) );
+    auto const copy = [ &map ] ( std::string_view const s_ ) {
+        std::uint32_t const offset = static_cast<std::uint32_t> ( map.m_arena_storage.size ( ) );
+        map.m_arena_storage.append ( s_ );
+        return offset;
+    };
+    for ( auto first = std::begin ( m_entries ), last = first; first != std::end ( m_entries ); first = last ) {
+        last = std::find_if ( first, std::end ( m_entries ), [ &key, first ] ( auto const & e_ ) noexcept { return key ( e_ ) != key ( *first ); } );
+        std::string_view merged = code ( *first );
+        for ( auto e = std::next ( first ); e != last; ++e )
+            if ( duplicate_code_t::world == e->duplicate or "001" != code ( *e ) )
+                merged = "001";
+        IanaMapEntry const & f = first->entry;
+        // Key, name and code adjacent in the arena.
+        std::uint32_t const k = copy ( key ( *first ) ), n = copy ( string ( f.name, f.name_size ) ), c = copy ( merged );
+        map.m_entries_storage.push_back ( { k, n, c, f.key_size, f.name_size, static_cast<std::uint8_t> ( merged.size ( ) ) } );
+    }
+    m_arena.clear ( );
+    m_entries.clear ( );
+    // The perfect hash, slot -> entry index.
+    std::vector<std::string_view> keys;
+    keys.reserve ( map.m_entries_storage.size ( ) );
+    for ( IanaMapEntry const & e : map.m_entries_storage )
+        keys.emplace_back ( map.m_arena_storage.data ( ) + e.key, e.key_size );
+    map.m_displacements_storage = build_perfect_hash ( keys );
+    map.m_slots_storage.resize ( keys.size ( ) );
+    for ( std::size_t i = 0u; i < keys.size ( ); ++i )
+        map.m_slots_storage[ perfect_hash_slot ( keys[ i ], map.m_displacements_storage, keys.size ( ) ) ] =
+            static_cast<std::uint16_t> ( i );
+    map.bind ( map );
+    return map;
+}
@@ -0,0 +1,251 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the \"Software\"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "iso8601.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+
+#include <bit>
+
+#define WIN_TO_NIX_EPOCH 116'444'736'000'000'000LL
+#define S_10M 10'000'000LL
+
+namespace {
+
+struct fields_t {
+    int year, month, day, hour, minute, second;
+    std::int64_t fraction; // Ticks.
+    int offset;            // Seconds, local time = UTC + offset.
+};
+
+// Returns the ticks since 1601 of the (validated) fields, nothing if they are out of range.
+[[nodiscard]] std::optional<std::int64_t> to_ticks ( fields_t const & f_ ) noexcept {
+    constexpr int days_in_month[ 12 ] = { 31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    if ( f_.month < 1 or f_.month > 12 or f_.day < 1 or f_.day > days_in_month[ f_.month - 1 ] or f_.hour > 23 or
+         f_.minute > 59 or f_.second > 60 )
+        return std::nullopt;
+    if ( 2 == f_.month and 29 == f_.day and not( 0 == f_.year % 4 and ( 0 != f_.year % 100 or 0 == f_.year % 400 ) ) )
+        return std::nullopt;
+    std::int64_t const days = days_from_civil ( f_.year, f_.month, f_.day ) + days_from_winepoch_to_nix;
+    std::int64_t const secs = f_.hour * 3'600 + f_.minute * 60 + f_.second - f_.offset;
+    return days * ticks_per_day + secs * S_10M + f_.fraction;
+}
+
+// SWAR, 8 chars in a little endian std::uint64_t, char i in byte i.
+
+[[nodiscard]] std::uint64_t load ( char const * const p_ ) noexcept {
+    std::uint64_t v;
+    std::memcpy ( &v, p_, sizeof ( v ) );
+    return v;
+}
+
+// Returns the digits [ 0, 9 ] in the bytes of digit_mask_, or all ones if any of them is not a digit.
+[[nodiscard]] constexpr std::uint64_t digits ( std::uint64_t const v_, std::uint64_t const digit_mask_ ) noexcept {
+    std::uint64_t const x = ( v_ ^ 0x3030'3030'3030'3030ULL ) & digit_mask_;
+    // A byte is > 9 iff adding 0x76 sets its high bit, or it was set already.
+    return ( ( x + 0x7676'7676'7676'7676ULL ) | x ) & 0x8080'8080'8080'8080ULL & digit_mask_ ? ~0ULL : x;
+}
+
+// Byte i of the result is the 2 digit number in bytes i and i + 1 of digits_.
+[[nodiscard]] constexpr std::uint64_t pairs ( std::uint64_t const digits_ ) noexcept { return digits_ * 10u + ( digits_ >> 8 ); }
+
+[[nodiscard]] constexpr int byte ( std::uint64_t const v_, int const i_ ) noexcept { return static_cast<int> ( ( v_ >> ( 8 * i_ ) ) & 0xFFu ); }
+
+[[nodiscard]] constexpr bool is_digit ( char const c_ ) noexcept { return c_ >= '0' and c_ <= '9'; }
+
+// The fixed layouts, YYYY-MM-DDTHH:MM:SS [ .fff ] ( Z | +HH:MM ), of lengths 20, 24, 25 and 29.
+[[nodiscard]] std::optional<std::int64_t> parse_fast ( std::string_view const s_ ) noexcept {
+    if constexpr ( std::endian::little != std::endian::native )
+        return std::nullopt;
+    std::size_t const n = s_.size ( );
+    if ( 20u != n and 24u != n and 25u != n and 29u != n )
+        return std::nullopt;
+    char const * const p = s_.data ( );
+    // "YYYY-MM-", "DDTHH:MM".
+    std::uint64_t const a = load ( p ), b = load ( p + 8 );
+    constexpr std::uint64_t a_digits = 0x00FF'FF00'FFFF'FFFFULL, b_digits = 0xFFFF'00FF'FF00'FFFFULL;
+    if ( ( a & ~a_digits ) != 0x2D00'002D'0000'0000ULL or ( b & ~b_digits ) != 0x0000'3A00'0054'0000ULL or ':' != p[ 16 ] or
+         not is_digit ( p[ 17 ] ) or not is_digit ( p[ 18 ] ) )
+        return std::nullopt;
+    std::uint64_t const da = digits ( a, a_digits ), db = digits ( b, b_digits );
+    if ( ~0ULL == da or ~0ULL == db )
+        return std::nullopt;
+    std::uint64_t const pa = pairs ( da ), pb = pairs ( db );
+    fields_t f{ byte ( pa, 0 ) * 100 + byte ( pa, 2 ), byte ( pa, 5 ), byte ( pb, 0 ), byte ( pb, 3 ), byte ( pb, 6 ),
+                ( p[ 17 ] - '0' ) * 10 + ( p[ 18 ] - '0' ), 0, 0 };
+    std::size_t i = 19u;
+    if ( 24u == n or 29u == n ) { // .fff
+        if ( '.' != p[ 19 ] or not is_digit ( p[ 20 ] ) or not is_digit ( p[ 21 ] ) or not is_digit ( p[ 22 ] ) )
+            return std::nullopt;
+        f.fraction = ( ( p[ 20 ] - '0' ) * 100 + ( p[ 21 ] - '0' ) * 10 + ( p[ 22 ] - '0' ) ) * 10'000LL;
+        i          = 23u;
+    }
+    if ( i + 1u == n ) {
+        if ( 'Z' != p[ i ] )
+            return std::nullopt;
+    }
+    else { // +HH:MM
+        if ( ( '+' != p[ i ] and '-' != p[ i ] ) or ':' != p[ i + 3u ] or not is_digit ( p[ i + 1u ] ) or not is_digit ( p[ i + 2u ] ) or
+             not is_digit ( p[ i + 4u ] ) or not is_digit ( p[ i + 5u ] ) )
+            return std::nullopt;
+        int const h = ( p[ i + 1u ] - '0' ) * 10 + ( p[ i + 2u ] - '0' ), m = ( p[ i + 4u ] - '0' ) * 10 + ( p[ i + 5u ] - '0' );
+        if ( h > 23 or m > 59 )
+            return std::nullopt;
+        f.offset = ( '-' == p[ i ] ? -60 : 60 ) * ( h * 60 + m );
+    }
+    return to_ticks ( f );
+}
+
+// A cursor over the string, for the variants.
+class scanner_t {
+
+    public:
+    explicit constexpr scanner_t ( std::string_view const s_ ) noexcept : m_s{ s_ } {}
+
+    [[nodiscard]] constexpr bool done ( ) const noexcept { return m_s.empty ( ); }
+    [[nodiscard]] constexpr char peek ( ) const noexcept { return m_s.size ( ) ? m_s.front ( ) : '\0'; }
+    [[nodiscard]] constexpr bool skip ( char const c_ ) noexcept {
+        if ( c_ != peek ( ) )
+            return false;
+        m_s.remove_prefix ( 1u );
+        return true;
+    }
+    // Exactly n_ digits.
+    [[nodiscard]] constexpr bool number ( int const n_, int & value_ ) noexcept {
+        if ( m_s.size ( ) < static_cast<std::size_t> ( n_ ) )
+            return false;
+        value_ = 0;
+        for ( int i = 0; i < n_; ++i ) {
+            if ( not is_digit ( m_s[ i ] ) )
+                return false;
+            value_ = 10 * value_ + ( m_s[ i ] - '0' );
+        }
+        m_s.remove_prefix ( static_cast<std::size_t> ( n_ ) );
+        return true;
+    }
+    // One or more digits, the first 7 of which as ticks.
+    [[nodiscard]] constexpr bool fraction ( std::int64_t & ticks_ ) noexcept {
+        std::int64_t scale = S_10M;
+        ticks_             = 0;
+        std::size_t i      = 0u;
+        for ( ; i < m_s.size ( ) and is_digit ( m_s[ i ] ); ++i )
+            if ( scale /= 10 )
+                ticks_ += ( m_s[ i ] - '0' ) * scale;
+        m_s.remove_prefix ( i );
+        return i;
+    }
+
+    private:
+    std::string_view m_s;
+};
+
+[[nodiscard]] std::optional<std::int64_t> parse_slow ( std::string_view const s_ ) noexcept {
+    scanner_t s{ s_ };
+    fields_t f{ };
+    if ( not s.number ( 4, f.year ) or not s.skip ( '-' ) or not s.number ( 2, f.month ) or not s.skip ( '-' ) or
+         not s.number ( 2, f.day ) )
+        return std::nullopt;
+    if ( s.done ( ) )
+        return to_ticks ( f );
+    if ( not s.skip ( 'T' ) and not s.skip ( 't' ) and not s.skip ( ' ' ) )
+        return std::nullopt;
+    if ( not s.number ( 2, f.hour ) or not s.skip ( ':' ) or not s.number ( 2, f.minute ) or not s.skip ( ':' ) or
+         not s.number ( 2, f.second ) )
+        return std::nullopt;
+    if ( ( s.skip ( '.' ) or s.skip ( ',' ) ) and not s.fraction ( f.fraction ) )
+        return std::nullopt;
+    if ( s.skip ( 'Z' ) or s.skip ( 'z' ) or s.done ( ) )
+        return s.done ( ) ? to_ticks ( f ) : std::nullopt;
+    int const sign = s.skip ( '-' ) ? -1 : s.skip ( '+' ) ? 1 : 0;
+    int h = 0, m = 0;
+    if ( not sign or not s.number ( 2, h ) or h > 23 )
+        return std::nullopt;
+    if ( not s.done ( ) ) {
+        (void) s.skip ( ':' );
+        if ( not s.number ( 2, m ) or m > 59 or not s.done ( ) )
+            return std::nullopt;
+    }
+    f.offset = sign * ( h * 3'600 + m * 60 );
+    return to_ticks ( f );
+}
+
+[[nodiscard]] std::optional<std::int64_t> parse_ticks ( std::string_view const s_ ) noexcept {
+    if ( std::optional<std::int64_t> const t = parse_fast ( s_ ); t )
+        return t;
+    return parse_slow ( s_ );
+}
+
+[[nodiscard]] std::optional<wintime_t> ticks_to_wintime ( std::optional<std::int64_t> const ticks_ ) noexcept {
+    if ( not ticks_ or *ticks_ < 0 )
+        return std::nullopt;
+    wintime_t wt;
+    wt.as_uint64 ( ) = static_cast<std::uint64_t> ( *ticks_ );
+    return wt;
+}
+
+[[nodiscard]] std::optional<nixtime_t> ticks_to_nixtime ( std::optional<std::int64_t> const ticks_ ) noexcept {
+    if ( not ticks_ )
+        return std::nullopt;
+    std::int64_t const t = *ticks_ - WIN_TO_NIX_EPOCH;
+    return static_cast<nixtime_t> ( t >= 0 ? t / S_10M : ( t - S_10M + 1 ) / S_10M );
+}
+
+template<typename T, typename Convert>
+std::size_t parse_all ( std::span<std::string_view const> const in_, std::span<T> const out_, std::span<bool> const ok_,
+                        Convert convert_ ) noexcept {
+    assert ( out_.size ( ) >= in_.size ( ) and ( ok_.empty ( ) or ok_.size ( ) >= in_.size ( ) ) );
+    std::size_t invalid = 0u;
+    for ( std::size_t i = 0u; i < in_.size ( ); ++i ) {
+        std::optional<T> const t = convert_ ( parse_ticks ( in_[ i ] ) );
+        if ( t )
+            out_[ i ] = *t;
+        else
+            ++invalid;
+        if ( ok_.size ( ) )
+            ok_[ i ] = t.has_value ( );
+    }
+    return invalid;
+}
+
+} // namespace
+
+std::optional<wintime_t> parse_wintime ( std::string_view const s_ ) noexcept { return ticks_to_wintime ( parse_ticks ( s_ ) ); }
+
+std::optional<nixtime_t> parse_nixtime ( std::string_view const s_ ) noexcept { return ticks_to_nixtime ( parse_ticks ( s_ ) ); }
+
+std::optional<wintime_t> parse_wintime_fast ( std::string_view const s_ ) noexcept { return ticks_to_wintime ( parse_fast ( s_ ) ); }
+
+std::optional<wintime_t> parse_wintime_slow ( std::string_view const s_ ) noexcept { return ticks_to_wintime ( parse_slow ( s_ ) ); }
+
+std::size_t parse_wintime ( std::span<std::string_view const> in_, std::span<wintime_t> out_, std::span<bool> ok_ ) noexcept {
+    return parse_all ( in_, out_, ok_, ticks_to_wintime );
+}
+
+std::size_t parse_nixtime ( std::span<std::string_view const> in_, std::span<nixtime_t> out_, std::span<bool> ok_ ) noexcept {
+    return parse_all ( in_, out_, ok_, ticks_to_nixtime );
+}
+
+#undef WIN_TO_NIX_EPOCH
+#undef S_10M
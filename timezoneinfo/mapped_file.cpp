@@ -0,0 +1,85 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the \"Software\"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "mapped_file.hpp"
+
+#if _WIN32
+#    include <Windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+#if _WIN32
+
+mapped_file_t::mapped_file_t ( fs::path const & path_ ) noexcept {
+    HANDLE const file = CreateFileW ( path_.c_str ( ), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                      FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr );
+    if ( INVALID_HANDLE_VALUE == file )
+        return;
+    LARGE_INTEGER size;
+    if ( GetFileSizeEx ( file, &size ) and size.QuadPart ) { // An empty file cannot be mapped.
+        if ( HANDLE const mapping = CreateFileMappingW ( file, nullptr, PAGE_READONLY, 0u, 0u, nullptr ); mapping ) {
+            m_data = static_cast<char const *> ( MapViewOfFile ( mapping, FILE_MAP_READ, 0u, 0u, 0u ) );
+            m_size = m_data ? static_cast<std::size_t> ( size.QuadPart ) : 0u;
+            CloseHandle ( mapping ); // The view keeps the mapping alive.
+        }
+    }
+    CloseHandle ( file );
+}
+
+void mapped_file_t::close ( ) noexcept {
+    if ( m_data )
+        UnmapViewOfFile ( m_data );
+    m_data = nullptr;
+    m_size = 0u;
+}
+
+#else
+
+mapped_file_t::mapped_file_t ( fs::path const & path_ ) noexcept {
+    int const fd = ::open ( path_.c_str ( ), O_RDONLY | O_CLOEXEC );
+    if ( -1 == fd )
+        return;
+    struct stat st;
+    if ( not ::fstat ( fd, &st ) and st.st_size > 0 ) { // An empty file cannot be mapped.
+        if ( void * const data = ::mmap ( nullptr, static_cast<std::size_t> ( st.st_size ), PROT_READ, MAP_PRIVATE, fd, 0 );
+             MAP_FAILED != data ) {
+            ::madvise ( data, static_cast<std::size_t> ( st.st_size ), MADV_SEQUENTIAL );
+            m_data = static_cast<char const *> ( data );
+            m_size = static_cast<std::size_t> ( st.st_size );
+        }
+    }
+    ::close ( fd ); // The mapping keeps the file alive.
+}
+
+void mapped_file_t::close ( ) noexcept {
+    if ( m_data )
+        ::munmap ( const_cast<char *> ( m_data ), m_size );
+    m_data = nullptr;
+    m_size = 0u;
+}
+
+#endif
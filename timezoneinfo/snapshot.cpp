@@ -0,0 +1,205 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the \"Software\"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "snapshot.hpp"
+
+#include <climits>
+#include <cstring>
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <string_view>
+#include <vector>
+
+#include <zlib.h>
+
+namespace {
+
+constexpr char snapshot_magic[ 8 ] = { 'T', 'Z', 'I', 'Z', 'O', 'N', 'E', 'S' };
+
+[[nodiscard]] constexpr std::uint64_t align8 ( std::uint64_t const n_ ) noexcept { return ( n_ + 7u ) & ~std::uint64_t{ 7u }; }
+
+// The offsets of the sections, and the size of the file, follow from the counts in the header. In 64 bits, the counts
+// of a corrupt header do not wrap around (also not where size_t is 32 bits).
+struct layout_t {
+    std::uint64_t entries, displacements, slots, zones, tzis, rules, arena, size;
+};
+
+[[nodiscard]] constexpr layout_t layout ( snapshot_header_t const & h_ ) noexcept {
+    layout_t l;
+    l.entries       = align8 ( sizeof ( snapshot_header_t ) );
+    l.displacements = align8 ( l.entries + std::uint64_t{ h_.entry_count } * sizeof ( IanaMapEntry ) );
+    l.slots         = align8 ( l.displacements + std::uint64_t{ h_.displacement_count } * sizeof ( std::uint32_t ) );
+    l.zones         = align8 ( l.slots + std::uint64_t{ h_.entry_count } * sizeof ( std::uint16_t ) );
+    l.tzis          = align8 ( l.zones + std::uint64_t{ h_.entry_count } * sizeof ( std::uint16_t ) );
+    l.rules         = align8 ( l.tzis + std::uint64_t{ h_.zone_count } * sizeof ( tzi_t ) );
+    l.arena         = align8 ( l.rules + std::uint64_t{ h_.zone_count } * sizeof ( zone_rule_t ) );
+    l.size          = l.arena + h_.arena_size;
+    return l;
+}
+
+[[nodiscard]] std::uint32_t checksum ( char const * data_, std::size_t size_ ) noexcept {
+    uLong crc = crc32 ( 0uL, Z_NULL, 0u );
+    for ( std::size_t n; size_; data_ += n, size_ -= n ) {
+        n   = std::min<std::size_t> ( size_, UINT_MAX );
+        crc = crc32 ( crc, reinterpret_cast<Bytef const *> ( data_ ), static_cast<uInt> ( n ) );
+    }
+    return static_cast<std::uint32_t> ( crc );
+}
+
+template<typename T>
+[[nodiscard]] std::span<T const> section ( char const * const data_, std::uint64_t const offset_,
+                                           std::size_t const size_ ) noexcept {
+    return { reinterpret_cast<T const *> ( data_ + offset_ ), size_ };
+}
+
+// Whether the strings of e_ lie in the arena of arena_size_ bytes.
+[[nodiscard]] bool is_valid ( IanaMapEntry const & e_, std::uint32_t const arena_size_ ) noexcept {
+    auto const fits = [ arena_size_ ] ( std::uint32_t const offset_, std::uint8_t const size_ ) {
+        return std::uint64_t{ offset_ } + size_ <= arena_size_;
+    };
+    return fits ( e_.key, e_.key_size ) and fits ( e_.name, e_.name_size ) and fits ( e_.code, e_.code_size );
+}
+
+// Whether the fields of d_ are in range, the rest is arithmetic on whatever values.
+[[nodiscard]] bool is_valid ( zone_rule_t::date_t const & d_ ) noexcept {
+    if ( not d_.month )
+        return true;
+    return d_.month <= 12 and 1 <= d_.week and d_.week <= 5 and 0 <= d_.day_of_week and d_.day_of_week <= 6;
+}
+
+[[nodiscard]] bool is_valid ( zone_rule_t const & r_ ) noexcept {
+    return 0 <= r_.dst_start.month and 0 <= r_.dst_end.month and not r_.dst_start.month == not r_.dst_end.month and
+           is_valid ( r_.dst_start ) and is_valid ( r_.dst_end );
+}
+
+template<typename T>
+void copy_section ( std::vector<char> & buffer_, std::size_t const offset_, std::span<T const> const section_ ) noexcept {
+    std::memcpy ( buffer_.data ( ) + offset_, section_.data ( ), section_.size_bytes ( ) );
+}
+
+} // namespace
+
+snapshot_t::snapshot_t ( fs::path const & path_ ) noexcept : m_file{ path_ } {
+    if ( m_file.size ( ) < sizeof ( snapshot_header_t ) )
+        return;
+    char const * const data     = m_file.data ( );
+    snapshot_header_t const & h = *reinterpret_cast<snapshot_header_t const *> ( data );
+    if ( std::memcmp ( h.magic, snapshot_magic, sizeof ( snapshot_magic ) ) or version != h.version or
+         sizeof ( IanaMapEntry ) != h.entry_size or sizeof ( tzi_t ) != h.tzi_size or sizeof ( zone_rule_t ) != h.rule_size )
+        return;
+    // The sections fit the file, and the slots, zones and perfect hash are of entry_count entries.
+    layout_t const l = layout ( h );
+    if ( l.size != m_file.size ( ) or perfect_hash_buckets ( h.entry_count ) != h.displacement_count or
+         h.checksum != checksum ( data + sizeof ( snapshot_header_t ), m_file.size ( ) - sizeof ( snapshot_header_t ) ) )
+        return;
+    // What the offsets and indices in the sections point at lies within the file, the checksum only catches accidents.
+    auto const entries = section<IanaMapEntry> ( data, l.entries, h.entry_count );
+    auto const slots   = section<std::uint16_t> ( data, l.slots, h.entry_count );
+    auto const zones   = section<std::uint16_t> ( data, l.zones, h.entry_count );
+    auto const tzis    = section<tzi_t> ( data, l.tzis, h.zone_count );
+    auto const rules   = section<zone_rule_t> ( data, l.rules, h.zone_count );
+    if ( std::any_of ( std::begin ( entries ), std::end ( entries ),
+                       [ &h ] ( auto const & e_ ) { return not is_valid ( e_, h.arena_size ); } ) or
+         std::any_of ( std::begin ( slots ), std::end ( slots ), [ &h ] ( auto const s_ ) { return s_ >= h.entry_count; } ) or
+         std::any_of ( std::begin ( zones ), std::end ( zones ), [ &h ] ( auto const z_ ) { return z_ >= h.zone_count; } ) or
+         std::any_of ( std::begin ( rules ), std::end ( rules ), [ ] ( auto const & r_ ) { return not is_valid ( r_ ); } ) or
+         not std::equal ( std::begin ( tzis ), std::end ( tzis ), std::begin ( rules ),
+                          [ ] ( auto const & t_, auto const & r_ ) { return make_zone_rule ( t_ ) == r_; } ) )
+        return;
+    m_map    = IanaMap{ std::string_view{ data + l.arena, h.arena_size }, entries,
+                     section<std::uint32_t> ( data, l.displacements, h.displacement_count ), slots };
+    m_zones  = zones;
+    m_tzis   = tzis;
+    m_rules  = rules;
+    m_header = &h;
+}
+
+snapshot_t & snapshot_t::operator= ( snapshot_t && other_ ) noexcept {
+    if ( this != &other_ ) {
+        // The views stay valid, the mapping does not move.
+        m_file   = std::move ( other_.m_file );
+        m_header = std::exchange ( other_.m_header, nullptr );
+        m_map    = std::exchange ( other_.m_map, IanaMap{ } );
+        m_zones  = std::exchange ( other_.m_zones, { } );
+        m_tzis   = std::exchange ( other_.m_tzis, { } );
+        m_rules  = std::exchange ( other_.m_rules, { } );
+    }
+    return *this;
+}
+
+bool write_snapshot ( fs::path const & path_, IanaMap const & map_, std::function<tzi_t ( std::string_view )> const & tzi_,
+                      snapshot_source_t const source_, std::uint64_t const source_time_, std::uint32_t const tzi_version_ ) {
+    // The distinct windows time zones, in order of appearance, and per entry the index of its zone.
+    std::map<std::string_view, std::uint16_t> index;
+    std::vector<std::uint16_t> zones;
+    std::vector<tzi_t> tzis;
+    std::vector<zone_rule_t> rules;
+    zones.reserve ( map_.size ( ) );
+    for ( auto const & [ key, value ] : map_ ) {
+        auto const [ it, inserted ] = index.try_emplace ( value.name, static_cast<std::uint16_t> ( tzis.size ( ) ) );
+        if ( inserted ) {
+            tzis.push_back ( tzi_ ( value.name ) );
+            rules.push_back ( make_zone_rule ( tzis.back ( ) ) );
+        }
+        zones.push_back ( it->second );
+    }
+    snapshot_header_t h{ };
+    std::memcpy ( h.magic, snapshot_magic, sizeof ( snapshot_magic ) );
+    h.version            = snapshot_t::version;
+    h.source_time        = source_time_;
+    h.tzi_version        = tzi_version_;
+    h.source             = static_cast<std::uint32_t> ( source_ );
+    h.entry_count        = static_cast<std::uint32_t> ( map_.size ( ) );
+    h.displacement_count = static_cast<std::uint32_t> ( map_.displacements ( ).size ( ) );
+    h.zone_count         = static_cast<std::uint32_t> ( tzis.size ( ) );
+    h.arena_size         = static_cast<std::uint32_t> ( map_.arena ( ).size ( ) );
+    h.entry_size         = sizeof ( IanaMapEntry );
+    h.tzi_size           = sizeof ( tzi_t );
+    h.rule_size          = sizeof ( zone_rule_t );
+    layout_t const l     = layout ( h );
+    std::vector<char> buffer ( static_cast<std::size_t> ( l.size ), 0 );
+    copy_section ( buffer, l.entries, map_.entries ( ) );
+    copy_section ( buffer, l.displacements, map_.displacements ( ) );
+    copy_section ( buffer, l.slots, map_.slots ( ) );
+    copy_section ( buffer, l.zones, std::span<std::uint16_t const>{ zones } );
+    copy_section ( buffer, l.tzis, std::span<tzi_t const>{ tzis } );
+    copy_section ( buffer, l.rules, std::span<zone_rule_t const>{ rules } );
+    copy_section ( buffer, l.arena, std::span<char const>{ map_.arena ( ) } );
+    h.checksum = checksum ( buffer.data ( ) + sizeof ( snapshot_header_t ), buffer.size ( ) - sizeof ( snapshot_header_t ) );
+    std::memcpy ( buffer.data ( ), &h, sizeof ( snapshot_header_t ) );
+    fs::path temp = path_;
+    temp += L".tmp";
+    {
+        std::ofstream out ( temp, std::ios::binary | std::ios::trunc );
+        if ( not out.write ( buffer.data ( ), static_cast<std::streamsize> ( buffer.size ( ) ) ) )
+            return false;
+    }
+    std::error_code ec;
+    fs::rename ( temp, path_, ec );
+    if ( not ec )
+        return true;
+    fs::remove ( temp, ec );
+    return false;
+}
@@ -0,0 +1,251 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the \"Software\"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "time_format.hpp"
+
+#include <cstring>
+
+#include <stdexcept>
+
+namespace {
+
+// "00" to "99", a number [ 0, 100 ) is 2 chars at 2 * n.
+constexpr char const digit_pairs[ 201 ] = "00010203040506070809"
+                                          "10111213141516171819"
+                                          "20212223242526272829"
+                                          "30313233343536373839"
+                                          "40414243444546474849"
+                                          "50515253545556575859"
+                                          "60616263646566676869"
+                                          "70717273747576777879"
+                                          "80818283848586878889"
+                                          "90919293949596979899";
+
+constexpr std::string_view weekday_abbrs[ 7 ] = { "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat" };
+constexpr std::string_view weekday_names[ 7 ] = { "Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday" };
+constexpr std::string_view month_abbrs[ 12 ]  = { "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+constexpr std::string_view month_names[ 12 ]  = { "January", "February", "March",     "April",   "May",      "June",
+                                                 "July",    "August",   "September", "October", "November", "December" };
+
+inline char * pair ( char * out_, unsigned const n_ ) noexcept {
+    std::memcpy ( out_, digit_pairs + 2u * n_, 2u );
+    return out_ + 2;
+}
+
+inline char * text ( char * out_, std::string_view const s_ ) noexcept {
+    std::memcpy ( out_, s_.data ( ), s_.size ( ) );
+    return out_ + s_.size ( );
+}
+
+// The most chars an op writes.
+[[nodiscard]] constexpr std::size_t width ( char const spec_ ) noexcept {
+    switch ( spec_ ) {
+        case 'Y': return 5u; // Up to 30827.
+        case 'j':
+        case 'f': return 3u;
+        case 'a':
+        case 'b': return 3u;
+        case 'A':
+        case 'B': return 9u;
+        case 'w':
+        case 'u': return 1u;
+        default: return 2u;
+    }
+}
+
+} // namespace
+
+time_format_t::time_format_t ( std::string_view const pattern_ ) {
+    std::size_t begin = 0u; // Of the pending literal text.
+    for ( std::size_t i = 0u; i < pattern_.size ( ); ++i ) {
+        if ( '%' != pattern_[ i ] or i + 1u == pattern_.size ( ) )
+            continue;
+        op_t op;
+        char const spec = pattern_[ i + 1u ];
+        switch ( spec ) {
+            case 'Y': op = op_t::year; break;
+            case 'y': op = op_t::year2; break;
+            case 'm': op = op_t::month; break;
+            case 'd': op = op_t::day; break;
+            case 'e': op = op_t::day_space; break;
+            case 'j': op = op_t::day_of_year; break;
+            case 'H': op = op_t::hour; break;
+            case 'I': op = op_t::hour12; break;
+            case 'p': op = op_t::am_pm; break;
+            case 'M': op = op_t::minute; break;
+            case 'S': op = op_t::second; break;
+            case 'f': op = op_t::millis; break;
+            case 'a': op = op_t::weekday_abbr; break;
+            case 'A': op = op_t::weekday_name; break;
+            case 'b': op = op_t::month_abbr; break;
+            case 'B': op = op_t::month_name; break;
+            case 'w': op = op_t::weekday; break;
+            case 'u': op = op_t::weekday_iso; break;
+            case 'F':
+            case 'T':
+            case 'R':
+            case 'n':
+            case 't':
+            case '%': op = op_t::literal; break;
+            default: continue; // Copied as is.
+        }
+        append ( pattern_.substr ( begin, i - begin ) );
+        begin = i + 2u;
+        switch ( spec ) { // The composites.
+            case 'F':
+                append ( op_t::year ), append ( "-" ), append ( op_t::month ), append ( "-" ), append ( op_t::day );
+                m_max_size += 9u;
+                break;
+            case 'T':
+                append ( op_t::hour ), append ( ":" ), append ( op_t::minute ), append ( ":" ), append ( op_t::second );
+                m_max_size += 6u;
+                break;
+            case 'R':
+                append ( op_t::hour ), append ( ":" ), append ( op_t::minute );
+                m_max_size += 4u;
+                break;
+            case 'n': append ( "\n" ); break;
+            case 't': append ( "\t" ); break;
+            case '%': append ( "%" ); break;
+            default: append ( op ), m_max_size += static_cast<std::uint16_t> ( width ( spec ) );
+        }
+        ++i;
+    }
+    append ( pattern_.substr ( begin ) );
+}
+
+void time_format_t::append ( op_t const op_ ) {
+    if ( m_ops == max_ops )
+        throw std::invalid_argument{ "time_format_t: too many fields" };
+    m_program[ m_ops++ ] = { op_, 0u, 0u };
+}
+
+void time_format_t::append ( std::string_view const text_ ) {
+    if ( text_.empty ( ) )
+        return;
+    if ( m_text_size + text_.size ( ) > max_text )
+        throw std::invalid_argument{ "time_format_t: too much literal text" };
+    // Adjacent literals are merged.
+    if ( m_ops and op_t::literal == m_program[ m_ops - 1u ].op and
+         m_program[ m_ops - 1u ].offset + m_program[ m_ops - 1u ].size == m_text_size )
+        m_program[ m_ops - 1u ].size += static_cast<std::uint8_t> ( text_.size ( ) );
+    else if ( m_ops == max_ops )
+        throw std::invalid_argument{ "time_format_t: too many fields" };
+    else
+        m_program[ m_ops++ ] = { op_t::literal, m_text_size, static_cast<std::uint8_t> ( text_.size ( ) ) };
+    std::memcpy ( m_text + m_text_size, text_.data ( ), text_.size ( ) );
+    m_text_size += static_cast<std::uint8_t> ( text_.size ( ) );
+    m_max_size += static_cast<std::uint16_t> ( text_.size ( ) );
+}
+
+char * time_format_t::format_to ( char * out_, systime_t const & systime_ ) const noexcept {
+    positions_t positions;
+    return run<false> ( out_, systime_, positions );
+}
+
+char * time_format_t::format_to ( char * out_, systime_t const & systime_, positions_t & positions_ ) const noexcept {
+    positions_.second_count = positions_.millis_count = 0u;
+    return run<true> ( out_, systime_, positions_ );
+}
+
+template<bool Track>
+char * time_format_t::run ( char * out_, systime_t const & systime_, positions_t & positions_ ) const noexcept {
+    char const * const begin = out_;
+    for ( std::size_t i = 0u; i < m_ops; ++i ) {
+        instr_t const & instr = m_program[ i ];
+        switch ( instr.op ) {
+            case op_t::literal: out_ = text ( out_, { m_text + instr.offset, instr.size } ); break;
+            case op_t::year: {
+                unsigned const y = systime_.wYear;
+                if ( y >= 10'000u )
+                    *out_++ = static_cast<char> ( '0' + y / 10'000u );
+                out_ = pair ( pair ( out_, y / 100u % 100u ), y % 100u );
+                break;
+            }
+            case op_t::year2: out_ = pair ( out_, systime_.wYear % 100u ); break;
+            case op_t::month: out_ = pair ( out_, systime_.wMonth ); break;
+            case op_t::day: out_ = pair ( out_, systime_.wDay ); break;
+            case op_t::day_space:
+                out_ = pair ( out_, systime_.wDay );
+                if ( systime_.wDay < 10u )
+                    out_[ -2 ] = ' ';
+                break;
+            case op_t::day_of_year: {
+                unsigned const d = static_cast<unsigned> ( days_from_civil ( systime_.wYear, systime_.wMonth, systime_.wDay ) -
+                                                           days_from_civil ( systime_.wYear, 1, 1 ) ) +
+                                   1u;
+                *out_++ = static_cast<char> ( '0' + d / 100u );
+                out_    = pair ( out_, d % 100u );
+                break;
+            }
+            case op_t::hour: out_ = pair ( out_, systime_.wHour ); break;
+            case op_t::hour12: out_ = pair ( out_, ( systime_.wHour + 11u ) % 12u + 1u ); break;
+            case op_t::am_pm: out_ = text ( out_, systime_.wHour < 12u ? "AM" : "PM" ); break;
+            case op_t::minute: out_ = pair ( out_, systime_.wMinute ); break;
+            case op_t::second:
+                if constexpr ( Track )
+                    positions_.second[ positions_.second_count++ ] = static_cast<std::uint16_t> ( out_ - begin );
+                out_ = pair ( out_, systime_.wSecond );
+                break;
+            case op_t::millis:
+                if constexpr ( Track )
+                    positions_.millis[ positions_.millis_count++ ] = static_cast<std::uint16_t> ( out_ - begin );
+                *out_++ = static_cast<char> ( '0' + systime_.wMilliseconds / 100u );
+                out_    = pair ( out_, systime_.wMilliseconds % 100u );
+                break;
+            case op_t::weekday_abbr: out_ = text ( out_, weekday_abbrs[ systime_.wDayOfWeek ] ); break;
+            case op_t::weekday_name: out_ = text ( out_, weekday_names[ systime_.wDayOfWeek ] ); break;
+            case op_t::month_abbr: out_ = text ( out_, month_abbrs[ systime_.wMonth - 1u ] ); break;
+            case op_t::month_name: out_ = text ( out_, month_names[ systime_.wMonth - 1u ] ); break;
+            case op_t::weekday: *out_++ = static_cast<char> ( '0' + systime_.wDayOfWeek ); break;
+            case op_t::weekday_iso: *out_++ = static_cast<char> ( '0' + ( systime_.wDayOfWeek + 6u ) % 7u + 1u ); break;
+        }
+    }
+    return out_;
+}
+
+void time_format_t::format_to ( fmt::memory_buffer & buffer_, systime_t const & systime_ ) const {
+    std::size_t const size = buffer_.size ( );
+    buffer_.resize ( size + m_max_size );
+    buffer_.resize ( static_cast<std::size_t> ( format_to ( buffer_.data ( ) + size, systime_ ) - buffer_.data ( ) ) );
+}
+
+std::string_view cached_time_format_t::format ( wintime_t const wintime_ ) noexcept {
+    constexpr std::uint64_t ticks_per_minute = 600'000'000ULL, ticks_per_ms = 10'000ULL;
+    std::uint64_t const t      = wintime_.as_uint64 ( );
+    std::int64_t const minute = static_cast<std::int64_t> ( t / ticks_per_minute );
+    if ( minute != m_minute ) {
+        m_size   = static_cast<std::size_t> ( m_format.format_to ( m_text, wintime_to_systime ( wintime_ ), m_positions ) - m_text );
+        m_minute = minute;
+        return { m_text, m_size };
+    }
+    unsigned const ms = static_cast<unsigned> ( t % ticks_per_minute / ticks_per_ms ); // Of the minute.
+    for ( std::size_t i = 0u; i < m_positions.second_count; ++i )
+        pair ( m_text + m_positions.second[ i ], ms / 1'000u );
+    for ( std::size_t i = 0u; i < m_positions.millis_count; ++i ) {
+        m_text[ m_positions.millis[ i ] ] = static_cast<char> ( '0' + ms % 1'000u / 100u );
+        pair ( m_text + m_positions.millis[ i ] + 1, ms % 100u );
+    }
+    return { m_text, m_size };
+}
+
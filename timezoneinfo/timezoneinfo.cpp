@@ -22,50 +22,421 @@
 // SOFTWARE.
 
 #include "timezoneinfo.hpp"
+#include "ianamap_generated.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 
+#include <chrono>
+#include <condition_variable>
 #include <fstream>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
 #include <sax/iostream.hpp>
 #include <sax/utf8conv.hpp>
 #include <set>
 #include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+struct app_data_t {
+    fs::path path, windowszones_path, windowszones_alt_path, timestamps_path, snapshot_path;
+};
+
+std::once_flag g_app_data_once;
+app_data_t g_app_data;
+
+std::once_flag g_timestamps_once;
+std::mutex g_timestamps_mutex; // Guards the two below, the worker changes them as callers read them.
+Timestamps g_timestamps;
+ETags g_etags;
+
+zone_data_t const g_generated{ snapshot_t{ }, IanaMap{ std::string_view{ g_iana_arena, sizeof ( g_iana_arena ) - 1u },
+                                                       g_iana_entries, g_iana_displacements, g_iana_slots } };
+constinit published_t<zone_data_t> g_data{ &g_generated };
+
+[[nodiscard]] app_data_t const & app_data ( ) {
+    std::call_once ( g_app_data_once, [ ] {
+        fs::path const path = get_app_data_path ( L"timezoneinfo" );
+        g_app_data = { path, path / L"windowszones.xml", path / L"windowszones_alt.csv.gz", path / L"timestamps.json",
+                       path / L"zones.bin" };
+    } );
+    return g_app_data;
+}
 
-#include <curlpp/Easy.hpp>
-#include <curlpp/Infos.hpp>
-#include <curlpp/Options.hpp>
-#include <curlpp/cURLpp.hpp>
+void read_timestamps ( fs::path const & path_, Timestamps & timestamps_, ETags & etags_ ) {
+    json j;
+    std::ifstream i ( path_ );
+    i >> j;
+    i.close ( );
+    timestamps_.clear ( );
+    etags_.clear ( );
+    for ( auto const & [ key, value ] : j.items ( ) )
+        if ( value.is_string ( ) )
+            etags_.insert_or_assign ( key, value.get<std::string> ( ) );
+        else
+            timestamps_.insert_or_assign ( key, value.get<std::uint64_t> ( ) );
+}
 
-int init ( ) {
-    if ( fs::exists ( g_timestamps_path ) )
-        load_timestamps ( );
-    if ( not fs::exists ( g_windowszones_path ) or
-         ( wintime ( ).as_uint64 ( ) - g_timestamps.at ( "last_windowszones_download" ) ) >
-             ( 30ULL * 24ULL * 60ULL * 60ULL * 10'000'000ULL ) ) {
-        download_windowszones ( );
-        g_timestamps.insert_or_assign ( "last_windowszones_download", wintime ( ).as_uint64 ( ) );
-        save_timestamps ( );
+// Returns the lock on the timestamps and the entity tags, read from timestamps.json on first use.
+[[nodiscard]] std::unique_lock<std::mutex> lock_timestamps ( ) {
+    std::call_once ( g_timestamps_once, [ ] {
+        if ( fs::exists ( timestamps_path ( ) ) )
+            read_timestamps ( timestamps_path ( ), g_timestamps, g_etags );
+    } );
+    return std::unique_lock ( g_timestamps_mutex );
+}
+
+// Writes the timestamps and the entity tags to timestamps.json, under the lock.
+void write_timestamps ( ) {
+    json j = g_timestamps;
+    for ( auto const & [ key, etag ] : g_etags )
+        j[ key ] = etag;
+    std::ofstream o ( timestamps_path ( ) );
+    o << j.dump ( 4 ) << std::endl;
+    o.flush ( );
+    o.close ( );
+}
+
+} // namespace
+
+fs::path const & app_data_path ( ) { return app_data ( ).path; }
+fs::path const & windowszones_path ( ) { return app_data ( ).windowszones_path; }
+fs::path const & windowszones_alt_path ( ) { return app_data ( ).windowszones_alt_path; }
+fs::path const & timestamps_path ( ) { return app_data ( ).timestamps_path; }
+fs::path const & snapshot_path ( ) { return app_data ( ).snapshot_path; }
+
+Timestamps timestamps ( ) {
+    std::unique_lock const lock = lock_timestamps ( );
+    return g_timestamps;
+}
+
+ETags etags ( ) {
+    std::unique_lock const lock = lock_timestamps ( );
+    return g_etags;
+}
+
+void set_timestamp ( std::string const & key_, std::uint64_t const value_ ) {
+    std::unique_lock const lock = lock_timestamps ( );
+    g_timestamps.insert_or_assign ( key_, value_ );
+}
+
+zone_data_pin_t zone_data ( ) noexcept { return g_data.pin ( ); }
+
+void preload ( ) {
+    [[maybe_unused]] std::unique_lock const lock = lock_timestamps ( );
+    [[maybe_unused]] zone_t const & z            = get_zone_utc ( );
+}
+
+namespace {
+
+constexpr std::uint64_t refresh_interval = 30ULL * 24ULL * 60ULL * 60ULL * 10'000'000ULL;
+
+// Gets the outcome of a request, and the map (empty unless changed).
+using parsed_t = std::function<void ( fetch_request_t const &, IanaMap )>;
+
+// A request, its body parsed with Parser as it arrives. The body replaces the file there is only if it parses to a map, a
+// page of garbage (f.e. an error page served with a 200) does not.
+template<typename Parser>
+[[nodiscard]] fetch_request_t map_request ( parsed_t parsed_ ) {
+    auto const parser = std::make_shared<std::optional<Parser>> ( std::in_place, fill_timezones_db ( ) );
+    auto const map    = std::make_shared<IanaMap> ( );
+    fetch_request_t request;
+    request.sink    = [ parser ] ( std::string_view const piece_ ) { ( *parser )->feed ( piece_ ); };
+    request.restart = [ parser ] { parser->emplace ( fill_timezones_db ( ) ); };
+    request.verify  = [ parser, map ] {
+        *map = ( *parser )->finish ( );
+        return not map->empty ( );
+    };
+    request.done = [ map, parsed = std::move ( parsed_ ) ] ( fetch_request_t const & request_ ) {
+        parsed ( request_, download_status_t::changed == request_.status ? std::move ( *map ) : IanaMap{ } );
+    };
+    return request;
+}
+
+struct source_t {
+    char const * timestamp;     // The key of the download time in timestamps.json.
+    char const * check;         // The key of the time the server was last asked.
+    char const * last_modified; // The keys of the validators of the download.
+    char const * etag;
+    fs::path const & ( *path ) ( );
+    IanaMap ( *build ) ( );
+    fetch_request_t ( *request ) ( parsed_t );
+};
+
+[[nodiscard]] source_t const & source ( snapshot_source_t const source_ ) noexcept {
+    static source_t const sources[ 2 ] = {
+        { "last_windowszones_download", "last_windowszones_check", "windowszones_last_modified", "windowszones_etag",
+          windowszones_path, build_iana_to_windowszones_map, map_request<windowszones_parser_t> },
+        { "last_windowszones_alt_download", "last_windowszones_alt_check", "windowszones_alt_last_modified",
+          "windowszones_alt_etag", windowszones_alt_path, build_iana_to_windowszones_alt_map,
+          map_request<windowszones_alt_parser_t> } };
+    return sources[ static_cast<std::uint32_t> ( source_ ) - 1u ];
+}
+
+[[nodiscard]] snapshot_source_t other_source ( snapshot_source_t const source_ ) noexcept {
+    return snapshot_source_t::windowszones == source_ ? snapshot_source_t::windowszones_alt : snapshot_source_t::windowszones;
+}
+
+std::mutex g_urls_mutex;
+std::string g_urls[ 2 ] = { "https://raw.githubusercontent.com/unicode-org/cldr/master/common/supplemental/windowsZones.xml",
+                            "https://raw.githubusercontent.com/mj1856/TimeZoneConverter/master/src/TimeZoneConverter/Data/Mapping.csv.gz" };
+
+// Returns the zone data of the snapshot if that was built from source_, downloaded at source_time_, of the tzis of
+// tzi_version_, nothing if not.
+[[nodiscard]] std::unique_ptr<zone_data_t> load_zone_data ( snapshot_source_t const source_, std::uint64_t const source_time_,
+                                                            std::uint32_t const tzi_version_ ) {
+    snapshot_t snapshot ( snapshot_path ( ) );
+    if ( not snapshot.is_open ( ) or source_ != snapshot.source ( ) or source_time_ > snapshot.source_time ( ) or
+         tzi_version_ != snapshot.tzi_version ( ) )
+        return { };
+    // The map views the mapping, which stays put when the snapshot moves.
+    IanaMap map = snapshot.map ( );
+    return std::make_unique<zone_data_t> ( zone_data_t{ std::move ( snapshot ), std::move ( map ) } );
+}
+
+// Returns the zone data of map_, or if empty, rebuilt with the build function of source_, and rewrites the snapshot. If the
+// snapshot cannot be written (on windows the mapping of the published snapshot pins the file), the data is the map as built.
+[[nodiscard]] std::unique_ptr<zone_data_t> build_zone_data ( snapshot_source_t const source_, std::uint64_t const source_time_,
+                                                             std::uint32_t const tzi_version_, IanaMap map_ = { } ) {
+    IanaMap map = map_.empty ( ) ? source ( source_ ).build ( ) : std::move ( map_ );
+    if ( map.empty ( ) )
+        return { };
+    if ( write_snapshot ( snapshot_path ( ), map, get_windows_tzi, source_, source_time_, tzi_version_ ) )
+        if ( std::unique_ptr<zone_data_t> data = load_zone_data ( source_, source_time_, tzi_version_ ); data )
+            return data;
+    return std::make_unique<zone_data_t> ( zone_data_t{ snapshot_t{ }, std::move ( map ) } );
+}
+
+[[nodiscard]] std::optional<zone_t> make_zone ( std::string_view const iana_ ) {
+#if _WIN32
+    zone_data_pin_t const data = zone_data ( );
+    if ( not data->map.contains ( iana_ ) )
+        return std::nullopt;
+    if ( dynamic_rules_t rules = get_windows_dynamic_rules ( data->map.at ( iana_ ).name ); rules.rules.size ( ) )
+        return zone_t{ std::move ( rules ) };
+    return zone_t{ get_tzi ( iana_ ) };
+#else
+    std::optional<tzif_t> tzif = load_tzif ( iana_ );
+    if ( not tzif )
+        return std::nullopt;
+    return std::move ( tzif->zone );
+#endif
+}
+
+constinit zone_cache_t g_zones; // Compiled from the zone data on windows, recompiled as it is published.
+
+// Publishes data_, the cached zones are recompiled from it (which keeps their ids).
+void publish_zone_data ( std::unique_ptr<zone_data_t> data_ ) {
+    g_data.publish ( std::move ( data_ ) );
+    g_zones.refresh ( make_zone );
+}
+
+// The background worker, refreshes the zone data of the source last asked for: when asked, and daily, as its download
+// comes due. One at a time, off the threads that read the data, which never wait for it. Stopped (and joined) at exit,
+// an ongoing download is abandoned.
+class refresher_t {
+
+    public:
+    refresher_t ( ) noexcept = default;
+
+    // Publishes the snapshot of source_ right away if it is of the last download, and has the worker take it from there.
+    void request ( snapshot_source_t const source_ ) {
+        {
+            std::scoped_lock const lock ( m_mutex );
+            version_t const version = { source_, download_time ( source_ ), get_tzi_version ( ) };
+            if ( std::unique_ptr<zone_data_t> data = load_zone_data ( source_, version.time, version.tzi ); data ) {
+                publish_zone_data ( std::move ( data ) );
+                m_published = version;
+            }
+            m_source  = source_;
+            m_pending = true;
+            if ( not m_thread.joinable ( ) )
+                m_thread = std::jthread{ [ this ] ( std::stop_token stop_ ) { run ( stop_ ); } };
+        }
+        m_wake.notify_one ( );
     }
+
+    void await ( ) {
+        std::unique_lock lock ( m_mutex );
+        m_idle.wait ( lock, [ this ] { return not m_pending and not m_busy; } );
+    }
+
+    private:
+    void run ( std::stop_token const stop_ ) {
+        std::unique_lock lock ( m_mutex );
+        while ( not stop_.stop_requested ( ) ) {
+            if ( not m_wake.wait_for ( lock, stop_, std::chrono::hours ( 24 ), [ this ] { return m_pending; } ) and
+                 stop_.stop_requested ( ) )
+                break;
+            snapshot_source_t const source = m_source;
+            m_pending = false;
+            m_busy    = true;
+            lock.unlock ( );
+            refresh ( source, stop_ );
+            g_data.collect ( );
+            lock.lock ( );
+            m_busy = false;
+            m_idle.notify_all ( );
+        }
+        m_pending = m_busy = false;
+        m_idle.notify_all ( );
+    }
+
+    // Asks the server whether the file of source_ changed, when due (or if there is no file), which answers a cheap 304 if
+    // not. A changed file is parsed as it arrives. A failed (or invalid) download changes nothing, the data there was stays.
+    // On a cold start, neither file there, both are fetched at once, source_ is published, the other if source_ failed. The
+    // maps are published once the fetch is done, building a snapshot would stall the transfer still going.
+    void refresh ( snapshot_source_t const source_, std::stop_token const & stop_ ) {
+        snapshot_source_t const sources[ 2 ] = { source_, other_source ( source_ ) };
+        bool const cold = not fs::exists ( source ( sources[ 0 ] ).path ( ) ) and not fs::exists ( source ( sources[ 1 ] ).path ( ) );
+        std::optional<IanaMap> fetched[ 2 ]; // Of the requests that did not fail, empty if not changed.
+        std::vector<fetch_request_t> requests;
+        for ( std::size_t i = 0u; i < ( cold ? 2u : 1u ); ++i ) {
+            std::optional<download_validators_t> validators = due ( sources[ i ] );
+            if ( not validators )
+                break;
+            fetch_request_t & r = requests.emplace_back (
+                source ( sources[ i ] ).request ( [ this, i, &sources, &fetched ] ( fetch_request_t const & r_, IanaMap map_ ) {
+                    if ( record ( sources[ i ], r_ ) )
+                        fetched[ i ] = std::move ( map_ );
+                } ) );
+            r.url        = source_url ( sources[ i ] );
+            r.path       = source ( sources[ i ] ).path ( );
+            r.validators = std::move ( *validators );
+        }
+        fetch ( requests, stop_ );
+        bool const served = fetched[ 0 ] and publish ( sources[ 0 ], std::move ( *fetched[ 0 ] ) );
+        if ( not served and fetched[ 1 ] )
+            publish ( sources[ 1 ], std::move ( *fetched[ 1 ] ) );
+        // Not due, or failed, (re)build from the file there is, unless published already.
+        if ( not served and not stop_.stop_requested ( ) and fs::exists ( source ( source_ ).path ( ) ) )
+            publish ( source_, { } );
+    }
+
+    // The validators of the file of source_ if a check is due, nothing if not.
+    [[nodiscard]] std::optional<download_validators_t> due ( snapshot_source_t const source_ ) {
+        source_t const & s = source ( source_ );
+        if ( not fs::exists ( s.path ( ) ) )
+            return download_validators_t{ }; // Nothing to compare with.
+        std::scoped_lock const lock ( m_mutex );
+        if ( ( wintime ( ).as_uint64 ( ) - std::max ( download_time ( source_ ), stamp ( s.check ) ) ) <= refresh_interval )
+            return { };
+        return download_validators_t{ etag ( s.etag ), stamp ( s.last_modified ) };
+    }
+
+    // Records the outcome of request_ of source_, returns false if it failed (as it does if the body is not what it
+    // should be, the file there was stays).
+    bool record ( snapshot_source_t const source_, fetch_request_t const & request_ ) {
+        source_t const & s = source ( source_ );
+        if ( download_status_t::failed == request_.status )
+            return false;
+        std::uint64_t const now     = wintime ( ).as_uint64 ( );
+        std::unique_lock const lock = lock_timestamps ( );
+        g_timestamps.insert_or_assign ( s.check, now );
+        if ( download_status_t::changed == request_.status ) {
+            g_timestamps.insert_or_assign ( s.timestamp, now );
+            g_timestamps.insert_or_assign ( s.last_modified, request_.validators.last_modified );
+            g_etags.insert_or_assign ( s.etag, request_.validators.etag );
+        }
+        write_timestamps ( );
+        return true;
+    }
+
+    // Publishes the zone data of source_, of map_, or if empty, of its file, unless published already. Returns whether
+    // the data of source_ is the published data.
+    bool publish ( snapshot_source_t const source_, IanaMap map_ ) {
+        version_t version;
+        {
+            std::scoped_lock const lock ( m_mutex );
+            version = { source_, download_time ( source_ ), get_tzi_version ( ) };
+            if ( version == m_published )
+                return true;
+        }
+        if ( std::unique_ptr<zone_data_t> data = build_zone_data ( source_, version.time, version.tzi, std::move ( map_ ) );
+             data ) {
+            std::scoped_lock const lock ( m_mutex );
+            publish_zone_data ( std::move ( data ) );
+            m_published = version;
+            return true;
+        }
+        return false;
+    }
+
+    // The timestamp key_, 0 if none.
+    [[nodiscard]] static std::uint64_t stamp ( char const key_[] ) {
+        std::unique_lock const lock = lock_timestamps ( );
+        auto const it               = g_timestamps.find ( key_ );
+        return std::end ( g_timestamps ) != it ? it->second : 0u;
+    }
+
+    // The entity tag key_, empty if none.
+    [[nodiscard]] static std::string etag ( char const key_[] ) {
+        std::unique_lock const lock = lock_timestamps ( );
+        auto const it               = g_etags.find ( key_ );
+        return std::end ( g_etags ) != it ? it->second : std::string{ };
+    }
+
+    // The time source_ was downloaded, 0 if never.
+    [[nodiscard]] static std::uint64_t download_time ( snapshot_source_t const source_ ) {
+        return stamp ( source ( source_ ).timestamp );
+    }
+
+    // The source and download time of the published data, and the version of its tzis (which changes with a windows update,
+    // or a tzdata upgrade, the daily wake republishes then).
+    struct version_t {
+        snapshot_source_t source{ };
+        std::uint64_t time = 0u;
+        std::uint32_t tzi  = 0u;
+
+        [[nodiscard]] friend bool operator== ( version_t const &, version_t const & ) noexcept = default;
+    };
+
+    std::mutex m_mutex;
+    std::condition_variable_any m_wake, m_idle;
+    snapshot_source_t m_source{ };
+    bool m_pending = false, m_busy = false;
+    version_t m_published;
+    std::jthread m_thread; // Last, stopped and joined first.
+};
+
+refresher_t g_refresher; // After g_data and g_zones, destroyed (and its worker joined) before them.
+
+} // namespace
+
+std::string source_url ( snapshot_source_t const source_ ) {
+    std::scoped_lock const lock ( g_urls_mutex );
+    return g_urls[ static_cast<std::uint32_t> ( source_ ) - 1u ];
+}
+
+void set_source_url ( snapshot_source_t const source_, std::string url_ ) {
+    std::scoped_lock const lock ( g_urls_mutex );
+    g_urls[ static_cast<std::uint32_t> ( source_ ) - 1u ] = std::move ( url_ );
+}
+
+int init ( ) {
+    g_refresher.request ( snapshot_source_t::windowszones );
     return 0;
 }
 
 int init_alt ( ) {
-    if ( fs::exists ( g_timestamps_path ) )
-        load_timestamps ( );
-    if ( not fs::exists ( g_windowszones_alt_path ) or
-         ( wintime ( ).as_uint64 ( ) - g_timestamps.at ( "last_windowszones_alt_download" ) ) >
-             ( 30ULL * 24ULL * 60ULL * 60ULL * 10'000'000ULL ) ) {
-        download_windowszones_alt ( );
-        g_timestamps.insert_or_assign ( "last_windowszones_alt_download", wintime ( ).as_uint64 ( ) );
-        save_timestamps ( );
-    }
+    g_refresher.request ( snapshot_source_t::windowszones_alt );
     return 1;
 }
 
+void await_refresh ( ) { g_refresher.await ( ); }
+
+#if _WIN32
+
 fs::path get_app_data_path ( std::wstring && place_ ) noexcept {
     wchar_t * value;
     std::size_t len;
@@ -75,12 +446,28 @@ fs::path get_app_data_path ( std::wstring && place_ ) noexcept {
     return return_value;
 }
 
+#else
+
+// $XDG_DATA_HOME, or its default, $HOME/.local/share.
+fs::path get_app_data_path ( std::wstring && place_ ) noexcept {
+    char const * const xdg  = std::getenv ( "XDG_DATA_HOME" );
+    char const * const home = std::getenv ( "HOME" );
+    fs::path return_value   = ( xdg and *xdg ? fs::path{ xdg } : fs::path{ home ? home : "." } / ".local" / "share" ) / place_;
+    std::error_code ec;
+    fs::create_directories ( return_value, ec ); // No error if directory exists.
+    return return_value;
+}
+
+#endif
+
+#if _WIN32
+
 #define MAX_KEY_LENGTH 255
 #define MAX_VALUE_NAME 16383
 
 WinTzSet fill_timezones_db ( ) noexcept {
 
-    std::set<std::string> db;
+    WinTzSet db;
 
     HKEY hKey;
 
@@ -136,147 +523,297 @@ WinTzSet fill_timezones_db ( ) noexcept {
     return db;
 }
 
-tzi_t get_tzi ( std::string const & iana_ ) noexcept {
-    // The registry entry for TZI.
-    struct REG_TZI_FORMAT {
-        LONG Bias;
-        LONG StandardBias;
-        LONG DaylightBias;
-        systime_t StandardDate;
-        systime_t DaylightDate;
-    };
+tzi_t get_tzi ( std::string_view const iana_ ) noexcept {
+    zone_data_pin_t const data = zone_data ( );
+    if ( tzi_t const * const tzi = data->snapshot.find_tzi ( iana_ ); tzi )
+        return *tzi;
+    return get_windows_tzi ( data->map.at ( iana_ ).name );
+}
+
+namespace {
+
+// The registry entry for TZI.
+struct REG_TZI_FORMAT {
+    LONG Bias;
+    LONG StandardBias;
+    LONG DaylightBias;
+    systime_t StandardDate;
+    systime_t DaylightDate;
+};
+
+[[nodiscard]] std::wstring registry_uri ( std::string_view const name_ ) {
+    return std::wstring ( L"SOFTWARE\\Microsoft\\Windows NT\\CurrentVersion\\Time Zones\\" ) + sax::utf8_to_utf16 ( name_ );
+}
+
+[[nodiscard]] tzi_t make_tzi ( REG_TZI_FORMAT const & reg_tzi_ ) noexcept {
+    tzi_t tzi{};
+    tzi.Bias = reg_tzi_.Bias; // UTC = local time + bias.
+    if ( reg_tzi_.StandardDate.wMonth ) {
+        tzi.StandardDate = reg_tzi_.StandardDate;
+        tzi.StandardBias = reg_tzi_.StandardBias;
+    }
+    if ( reg_tzi_.DaylightDate.wMonth ) {
+        tzi.DaylightDate = reg_tzi_.DaylightDate;
+        tzi.DaylightBias = reg_tzi_.DaylightBias;
+    }
+    return tzi;
+}
+
+} // namespace
+
+tzi_t get_windows_tzi ( std::string_view const name_ ) noexcept {
     // Variables.
     HKEY key = nullptr;
     DWORD data_length;
     REG_TZI_FORMAT reg_tzi{};
-    tzi_t tzi{};
     // Create URI.
-    std::wstring const desc = sax::utf8_to_utf16 ( g_iana.at ( iana_ ).name );
-    std::wstring const uri  = std::wstring ( L"SOFTWARE\\Microsoft\\Windows NT\\CurrentVersion\\Time Zones\\" ) + desc;
-    auto result             = RegOpenKeyEx ( HKEY_LOCAL_MACHINE, uri.c_str ( ), 0, KEY_READ, &key );
+    std::wstring const uri = registry_uri ( name_ );
+    auto result            = RegOpenKeyEx ( HKEY_LOCAL_MACHINE, uri.c_str ( ), 0, KEY_READ, &key );
     assert ( ERROR_SUCCESS == result );
     data_length = sizeof ( REG_TZI_FORMAT );
     RegQueryValueEx ( key, TEXT ( "TZI" ), NULL, NULL, ( LPBYTE ) &reg_tzi, &data_length );
-    tzi.Bias    = reg_tzi.Bias; // UTC = local time + bias.
+    tzi_t tzi   = make_tzi ( reg_tzi );
     data_length = 64;
     RegQueryValueEx ( key, TEXT ( "Std" ), NULL, NULL, ( LPBYTE ) &tzi.StandardName, &data_length );
-    if ( reg_tzi.StandardDate.wMonth ) {
-        tzi.StandardDate = reg_tzi.StandardDate;
-        tzi.StandardBias = reg_tzi.StandardBias;
-    }
     if ( reg_tzi.DaylightDate.wMonth ) {
         data_length = 64;
         RegQueryValueEx ( key, TEXT ( "Dlt" ), NULL, NULL, ( LPBYTE ) &tzi.DaylightName, &data_length );
-        tzi.DaylightDate = reg_tzi.DaylightDate;
-        tzi.DaylightBias = reg_tzi.DaylightBias;
     }
     assert ( not reg_tzi.StandardDate.wMonth == not reg_tzi.DaylightDate.wMonth );
     RegCloseKey ( key );
+    return tzi;
+}
+
+std::uint32_t get_tzi_version ( ) noexcept {
+    HKEY key             = nullptr;
+    DWORD version        = 0u, data_length = sizeof ( DWORD );
+    wchar_t const uri[ ] = L"SOFTWARE\\Microsoft\\Windows NT\\CurrentVersion\\Time Zones";
+    if ( ERROR_SUCCESS != RegOpenKeyEx ( HKEY_LOCAL_MACHINE, uri, 0, KEY_READ, &key ) )
+        return 0u;
+    if ( ERROR_SUCCESS != RegQueryValueEx ( key, TEXT ( "TzVersion" ), NULL, NULL, ( LPBYTE ) &version, &data_length ) )
+        version = 0u;
+    RegCloseKey ( key );
+    return version;
+}
+
+dynamic_rules_t get_windows_dynamic_rules ( std::string_view const name_ ) noexcept {
+    dynamic_rules_t rules;
+    HKEY key               = nullptr;
+    std::wstring const uri = registry_uri ( name_ ) + std::wstring ( L"\\Dynamic DST" );
+    if ( ERROR_SUCCESS != RegOpenKeyEx ( HKEY_LOCAL_MACHINE, uri.c_str ( ), 0, KEY_READ, &key ) )
+        return rules;
+    DWORD first_year = 0u, last_year = 0u, data_length = sizeof ( DWORD );
+    RegQueryValueEx ( key, TEXT ( "FirstEntry" ), NULL, NULL, ( LPBYTE ) &first_year, &data_length );
+    data_length = sizeof ( DWORD );
+    RegQueryValueEx ( key, TEXT ( "LastEntry" ), NULL, NULL, ( LPBYTE ) &last_year, &data_length );
+    if ( first_year and first_year <= last_year ) {
+        rules.first_year = static_cast<int> ( first_year );
+        rules.rules.reserve ( last_year - first_year + 1u );
+        for ( DWORD y = first_year; y <= last_year; ++y ) {
+            REG_TZI_FORMAT reg_tzi{};
+            data_length = sizeof ( REG_TZI_FORMAT );
+            if ( ERROR_SUCCESS !=
+                 RegQueryValueEx ( key, std::to_wstring ( y ).c_str ( ), NULL, NULL, ( LPBYTE ) &reg_tzi, &data_length ) ) {
+                rules.rules.clear ( ); // Incomplete, the static rule applies.
+                break;
+            }
+            rules.rules.push_back ( make_zone_rule ( make_tzi ( reg_tzi ) ) );
+        }
+    }
+    RegCloseKey ( key );
+    return rules;
+}
 
-#if 0
+#else
 
-    std::wstring const uri_dynamic_dst = uri + std::wstring ( L"\\Dynamic DST" );
+namespace {
 
-    auto const exists = RegOpenKeyEx ( HKEY_LOCAL_MACHINE, uri_dynamic_dst.c_str ( ), 0, KEY_READ, &key );
+// The tzi of the TZif file of iana_, the rule beyond its table, UTC if there is no such file.
+[[nodiscard]] tzi_t load_tzi ( std::string_view const iana_ ) noexcept {
+    std::optional<tzif_t> const tzif = load_tzif ( iana_ );
+    if ( not tzif )
+        return get_tzi_utc ( );
+    tzi_t tzi = make_tzi ( tzif->zone.rule ( ) );
+    // The abbreviations are ASCII.
+    std::copy_n ( std::cbegin ( tzif->std_name ), std::min<std::size_t> ( tzif->std_name.size ( ), 31u ), tzi.StandardName );
+    std::copy_n ( std::cbegin ( tzif->dst_name ), std::min<std::size_t> ( tzif->dst_name.size ( ), 31u ), tzi.DaylightName );
+    return tzi;
+}
 
-    if ( ERROR_SUCCESS == exists ) {
-        DWORD const current_year = static_cast<DWORD> ( today_year ( ) );
-        DWORD first_year = 0u, last_year = 0u;
+} // namespace
 
-        data_length = sizeof ( DWORD );
-        RegQueryValueEx ( key, TEXT ( "LastEntry" ), NULL, NULL, ( LPBYTE ) &last_year, &data_length );
+// The windows names the IanaMap maps to, there is no registry.
+WinTzSet fill_timezones_db ( ) noexcept {
+    WinTzSet db;
+    zone_data_pin_t const data = zone_data ( );
+    for ( auto const & [ iana, value ] : data->map )
+        db.emplace ( value.name );
+    return db;
+}
 
-        if ( last_year >= current_year ) {
-            RegQueryValueEx ( key, TEXT ( "FirstEntry" ), NULL, NULL, ( LPBYTE ) &first_year, &data_length );
+tzi_t get_tzi ( std::string_view const iana_ ) noexcept {
+    if ( zone_data_pin_t const data = zone_data ( ); tzi_t const * const tzi = data->snapshot.find_tzi ( iana_ ) )
+        return *tzi;
+    return load_tzi ( iana_ );
+}
 
-            data_length = sizeof ( REG_TZI_FORMAT );
-            RegQueryValueEx ( key, fmt::to_wstring ( current_year ).c_str ( ), NULL, NULL, ( LPBYTE ) &reg_tzi,
-                              &data_length );
+tzi_t get_windows_tzi ( std::string_view const name_ ) noexcept {
+    zone_data_pin_t const data = zone_data ( );
+    for ( auto const & [ iana, value ] : data->map )
+        if ( name_ == value.name and "001" == value.code )
+            return load_tzi ( iana );
+    return get_tzi_utc ( );
+}
 
-            tzi.Bias         = reg_tzi.Bias; // UTC = local time + bias
-            if ( reg_tzi.StandardDate.wMonth ) {
-                tzi.StandardDate = reg_tzi.StandardDate;
-                tzi.StandardBias = reg_tzi.StandardBias;
-            }
-            if ( reg_tzi.DaylightDate.wMonth ) {
-                tzi.DaylightDate = reg_tzi.DaylightDate;
-                tzi.DaylightBias = reg_tzi.DaylightBias;
-            }
-        }
+// The first line of tzdata.zi is its version, f.e. "# version 2025b".
+std::uint32_t get_tzi_version ( ) noexcept {
+    try {
+        std::ifstream in ( zoneinfo_root ( ) / "tzdata.zi" );
+        std::string line;
+        return std::getline ( in, line ) ? perfect_hash ( line, 0u ) : 0u;
+    }
+    catch ( ... ) {
+        return 0u;
     }
+}
 
-    RegCloseKey ( key );
+// The TZif files hold the history.
+dynamic_rules_t get_windows_dynamic_rules ( std::string_view const ) noexcept { return { }; }
 
 #endif
 
-    return tzi;
-}
-
 tzi_t const & get_tzi_utc ( ) noexcept {
-    static tzi_t const utc = { 0, TEXT ( "Coordinated Universal Time" ), systime_t{},
-                               0, TEXT ( "Coordinated Universal Time" ), systime_t{},
+    static tzi_t const utc = { 0, L"Coordinated Universal Time", systime_t{},
+                               0, L"Coordinated Universal Time", systime_t{},
                                0 };
     return utc;
 }
 
 bool has_dst ( tzi_t const & tzi ) noexcept { return tzi.StandardDate.wMonth; }
 
+zone_t const * get_zone ( std::string_view const iana_ ) { return g_zones.get ( iana_, make_zone ); }
+
+zone_id_t lookup ( std::string_view const iana_ ) { return g_zones.intern ( iana_, make_zone ); }
+
+zone_t const & get_zone ( zone_id_t const id_ ) noexcept { return g_zones[ id_ ]; }
+
+std::string_view get_name ( zone_id_t const id_ ) noexcept { return g_zones.key ( id_ ); }
+
+namespace {
+
+// The zones compiled from tzi_t's, keyed by the bytes of their rules (not of the names, nor of what follows their NULs), such
+// that alternating between zones costs a lookup per call, and equal rules share a zone.
+constinit zone_cache_t g_tzi_zones;
+// The zone of the rule alone, on this thread, if the cache is full or out of memory.
+thread_local zone_t g_tzi_fallback;
+
+// The current local day in the zone last used by today_in_tz on this thread.
+thread_local zone_t const * g_tzi_today_zone = nullptr;
+thread_local local_day_t g_tzi_today;
+
+static_assert ( std::has_unique_object_representations_v<zone_rule_t>, "equal rules must have equal bytes" );
+
+[[nodiscard]] zone_t const & get_zone ( tzi_t const & tzi_ ) noexcept {
+    zone_rule_t const rule = make_zone_rule ( tzi_ );
+    std::string_view const key{ reinterpret_cast<char const *> ( &rule ), sizeof ( zone_rule_t ) };
+    try {
+        if ( zone_t const * const zone =
+                 g_tzi_zones.get ( key, [ &rule ] ( std::string_view ) { return std::optional<zone_t>{ zone_t{ rule } }; } );
+             zone )
+            return *zone;
+    }
+    catch ( std::bad_alloc const & ) {
+    }
+    g_tzi_fallback = zone_t::from_rule ( rule );
+    return g_tzi_fallback;
+}
+
+[[nodiscard]] local_day_t const & today_in_tz ( tzi_t const & tzi_, std::int64_t const now_ ) noexcept {
+    zone_t const & zone = get_zone ( tzi_ );
+    // The fallback zone changes with the tzi_t, its day is not kept.
+    if ( &zone == &g_tzi_fallback or &zone != g_tzi_today_zone or not g_tzi_today.contains ( now_ ) ) {
+        g_tzi_today      = make_local_day ( zone, now_ );
+        g_tzi_today_zone = &zone;
+    }
+    return g_tzi_today;
+}
+
+} // namespace
+
 systime_t get_systime_in_tz ( tzi_t const & tzi_, systime_t const & system_time_ ) noexcept {
-    systime_t local_time;
-    SystemTimeToTzSpecificLocalTime ( &tzi_, &system_time_, &local_time );
-    return local_time;
+    return get_zone ( tzi_ ).to_local ( system_time_ );
 }
 
 wintime_t get_wintime_in_tz ( tzi_t const & tzi_, wintime_t const & wintime_ ) noexcept {
-    return systime_to_wintime ( get_systime_in_tz ( tzi_, wintime_to_systime ( wintime_ ) ) );
+    return get_zone ( tzi_ ).to_local ( wintime_ );
 }
 
 nixtime_t get_nixtime_in_tz ( tzi_t const & tzi_, nixtime_t const & nixtime_ ) noexcept {
-    return systime_to_nixtime ( get_systime_in_tz ( tzi_, nixtime_to_systime ( nixtime_ ) ) );
+    return get_zone ( tzi_ ).to_local ( nixtime_ );
+}
+
+systime_t get_systime_in_tz ( tzi_t const & tzi_ ) noexcept {
+    std::int64_t const now = now_ticks ( );
+    return today_in_tz ( tzi_, now ).local_systime ( now );
 }
 
-systime_t get_systime_in_tz ( tzi_t const & tzi_ ) noexcept { return get_systime_in_tz ( tzi_, systime ( ) ); }
+wintime_t get_wintime_in_tz ( tzi_t const & tzi_ ) noexcept { return get_zone ( tzi_ ).to_local ( wintime ( ) ); }
+
+nixtime_t get_nixtime_in_tz ( tzi_t const & tzi_ ) noexcept { return get_zone ( tzi_ ).to_local ( nixtime ( ) ); }
+
+systime_t get_systime_in_tz ( zone_id_t const id_, systime_t const & system_time_ ) noexcept {
+    return get_zone ( id_ ).to_local ( system_time_ );
+}
 
-wintime_t get_wintime_in_tz ( tzi_t const & tzi_ ) noexcept { return systime_to_wintime ( get_systime_in_tz ( tzi_ ) ); }
+wintime_t get_wintime_in_tz ( zone_id_t const id_, wintime_t const & wintime_ ) noexcept {
+    return get_zone ( id_ ).to_local ( wintime_ );
+}
 
-nixtime_t get_nixtime_in_tz ( tzi_t const & tzi_ ) noexcept { return systime_to_nixtime ( get_systime_in_tz ( tzi_ ) ); }
+nixtime_t get_nixtime_in_tz ( zone_id_t const id_, nixtime_t const & nixtime_ ) noexcept {
+    return get_zone ( id_ ).to_local ( nixtime_ );
+}
 
-systime_t get_systime_in_tz ( systime_t const & system_time_ ) noexcept {
-    return get_systime_in_tz ( get_tzi_utc ( ), system_time_ );
+systime_t get_systime_in_tz ( zone_id_t const id_ ) noexcept {
+    std::int64_t const now = now_ticks ( );
+    return today_in_zone ( id_, get_zone ( id_ ), now ).local_systime ( now );
 }
 
-wintime_t get_wintime_in_tz ( wintime_t const & wintime_ ) noexcept { return get_wintime_in_tz ( get_tzi_utc ( ), wintime_ ); }
+wintime_t get_wintime_in_tz ( zone_id_t const id_ ) noexcept { return get_zone ( id_ ).to_local ( wintime ( ) ); }
+
+nixtime_t get_nixtime_in_tz ( zone_id_t const id_ ) noexcept { return get_zone ( id_ ).to_local ( nixtime ( ) ); }
+
+systime_t get_systime_in_tz ( systime_t const & system_time_ ) noexcept { return get_zone_utc ( ).to_local ( system_time_ ); }
+
+wintime_t get_wintime_in_tz ( wintime_t const & wintime_ ) noexcept { return get_zone_utc ( ).to_local ( wintime_ ); }
 
-nixtime_t get_nixtime_in_tz ( nixtime_t const & nixtime_ ) noexcept { return get_nixtime_in_tz ( get_tzi_utc ( ), nixtime_ ); }
+nixtime_t get_nixtime_in_tz ( nixtime_t const & nixtime_ ) noexcept { return get_zone_utc ( ).to_local ( nixtime_ ); }
 
-int today_year_in_tz ( tzi_t const & tzi_ ) noexcept { return get_systime_in_tz ( tzi_ ).wYear; }
-int today_month_in_tz ( tzi_t const & tzi_ ) noexcept { return get_systime_in_tz ( tzi_ ).wMonth; }
+local_day_t today_in_tz ( zone_id_t const id_ ) noexcept { return today_in_zone ( id_, get_zone ( id_ ) ); }
+
+local_day_t today_in_tz ( tzi_t const & tzi_ ) noexcept { return today_in_tz ( tzi_, now_ticks ( ) ); }
+
+int today_year_in_tz ( tzi_t const & tzi_ ) noexcept { return today_in_tz ( tzi_ ).year; }
+int today_month_in_tz ( tzi_t const & tzi_ ) noexcept { return today_in_tz ( tzi_ ).month; }
 
 void save_timestamps ( ) {
-    json const j = g_timestamps;
-    std::ofstream o ( g_timestamps_path );
-    o << j.dump ( 4 ) << std::endl;
-    o.flush ( );
-    o.close ( );
+    std::unique_lock const lock = lock_timestamps ( );
+    write_timestamps ( );
 }
 
 void load_timestamps ( ) {
-    json j;
-    std::ifstream i ( g_timestamps_path );
-    i >> j;
-    i.close ( );
-    g_timestamps = j.get<Timestamps> ( );
+    std::unique_lock const lock = lock_timestamps ( );
+    read_timestamps ( timestamps_path ( ), g_timestamps, g_etags );
 }
 
 void save_to_file ( json const & j_, std::wstring const & name_ ) {
-    std::ofstream o ( g_app_data_path / ( name_ + L".json" ) );
+    std::ofstream o ( app_data_path ( ) / ( name_ + L".json" ) );
     o << std::setw ( 4 ) << j_ << std::endl;
     o.flush ( );
     o.close ( );
 }
 
 void load_from_file ( json & j_, std::wstring const & name_ ) {
-    std::ifstream i ( g_app_data_path / ( name_ + L".json" ) );
+    std::ifstream i ( app_data_path ( ) / ( name_ + L".json" ) );
     i >> j_;
     i.close ( );
 }
@@ -313,16 +850,27 @@ int days_since_winepoch ( ) noexcept {
 }
 
 std::int64_t local_utc_offset_minutes ( ) noexcept {
+#if _WIN32
     wintime_t ft = wintime ( ), lt;
     FileTimeToLocalFileTime ( ft.data ( ), lt.data ( ) );
     if ( ft.as_uint64 ( ) > lt.as_uint64 ( ) )
         return +static_cast<std::int64_t> ( ( ft.as_uint64 ( ) - lt.as_uint64 ( ) ) / ( 60ULL * 10'000'000ULL ) );
     else
         return -static_cast<std::int64_t> ( ( lt.as_uint64 ( ) - ft.as_uint64 ( ) ) / ( 60ULL * 10'000'000ULL ) );
+#else
+    std::time_t const t = std::time ( nullptr );
+    std::tm tm{ };
+    localtime_r ( &t, &tm );
+    return -static_cast<std::int64_t> ( tm.tm_gmtoff ) / 60;
+#endif
 }
 
 void print_nixtime ( nixtime_t const rawtime_ ) noexcept {
-    std::cout << fmt::format ( "{:%a %b %e %T %Y}", *std::gmtime ( &rawtime_ ) ) << nl;
+    // Thu Aug 22 13:41:12 2019
+    static time_format_t const format{ "%a %b %e %T %Y" };
+    char buffer[ 32 ];
+    std::cout << std::string_view{ buffer, static_cast<std::size_t> ( format.format_to ( buffer, nixtime_to_systime ( rawtime_ ) ) - buffer ) }
+              << nl;
 }
 
 void print_systime ( systime_t const & system_time_ ) noexcept {
@@ -336,31 +884,26 @@ void print_wintime ( wintime_t const & rawtime_ ) noexcept {
 }
 
 void download ( char const url_[], fs::path const & path_ ) {
-    std::ofstream o ( path_, std::ios::binary );
-    // Set up curlpp.
-    curlpp::Easy request;
-    // Write to stream.
-    request.setOpt<curlpp::options::WriteStream> ( &o );
-    // Check if compressed file, if not, set encoding to 'deflate'.
-    std::string_view ext{ url_ };
-    ext.remove_prefix ( ext.length ( ) - 2 );
-    if ( std::strncmp ( "gz", ext.data ( ), 2 ) )
-        request.setOpt<curlpp::options::Encoding> ( "deflate" );
-    // Set url.
-    request.setOpt<curlpp::options::Url> ( url_ );
-    // Do the download.
-    try {
-        request.perform ( );
-    }
-    catch ( curlpp::RuntimeError & e ) {
-        std::cout << e.what ( ) << std::endl;
-    }
-    catch ( curlpp::LogicError & e ) {
-        std::cout << e.what ( ) << std::endl;
-    }
-    // Clean up.
-    o.flush ( );
-    o.close ( );
+    download_validators_t validators;
+    [[maybe_unused]] download_status_t const status = download ( url_, path_, validators, { } );
+}
+
+download_status_t download ( char const url_[], fs::path const & path_, download_validators_t & validators_,
+                             std::function<void ( std::string_view )> const & sink_, std::function<bool ( )> const & verify_,
+                             std::stop_token const & stop_ ) {
+    fetch_request_t request;
+    request.url        = url_;
+    request.path       = path_;
+    request.validators = validators_;
+    request.sink       = sink_;
+    request.verify     = verify_;
+    request.timeout    = std::chrono::milliseconds{ 0 };
+    request.retries    = 0;
+    fetch ( { &request, 1u }, stop_ );
+    if ( request.error.size ( ) )
+        std::cout << request.error << std::endl;
+    validators_ = std::move ( request.validators );
+    return request.status;
 }
 
 /*
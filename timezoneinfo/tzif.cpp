@@ -0,0 +1,281 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the \"Software\"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "tzif.hpp"
+#include "mapped_file.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+
+#include <algorithm>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#define WIN_TO_NIX_EPOCH_S 11'644'473'600LL
+#define S_10M 10'000'000LL
+
+namespace {
+
+// A cursor over a POSIX TZ string.
+class posix_parser_t {
+
+    public:
+    explicit constexpr posix_parser_t ( std::string_view const s_ ) noexcept : m_s{ s_ } {}
+
+    [[nodiscard]] constexpr bool done ( ) const noexcept { return m_s.empty ( ); }
+    [[nodiscard]] constexpr bool next_is ( char const c_ ) const noexcept { return m_s.size ( ) and c_ == m_s.front ( ); }
+    [[nodiscard]] constexpr bool skip ( char const c_ ) noexcept {
+        if ( not next_is ( c_ ) )
+            return false;
+        m_s.remove_prefix ( 1u );
+        return true;
+    }
+
+    // An abbreviation, 3 or more letters, or any of the characters between < and >.
+    [[nodiscard]] constexpr bool name ( std::string_view & name_ ) noexcept {
+        if ( skip ( '<' ) ) {
+            std::size_t const e = m_s.find ( '>' );
+            if ( std::string_view::npos == e or e < 3u )
+                return false;
+            name_ = m_s.substr ( 0u, e );
+            m_s.remove_prefix ( e + 1u );
+            return true;
+        }
+        std::size_t n = 0u;
+        while ( n < m_s.size ( ) and ( ( m_s[ n ] >= 'A' and m_s[ n ] <= 'Z' ) or ( m_s[ n ] >= 'a' and m_s[ n ] <= 'z' ) ) )
+            ++n;
+        if ( n < 3u )
+            return false;
+        name_ = m_s.substr ( 0u, n );
+        m_s.remove_prefix ( n );
+        return true;
+    }
+
+    // [ + | - ] hh [ : mm [ : ss ] ], in seconds.
+    [[nodiscard]] constexpr bool time ( std::int32_t & seconds_ ) noexcept {
+        bool const negative = skip ( '-' );
+        if ( not negative )
+            (void) skip ( '+' );
+        int h = 0, m = 0, s = 0;
+        if ( not number ( h, 0, 167 ) )
+            return false;
+        if ( skip ( ':' ) and ( not number ( m, 0, 59 ) or ( skip ( ':' ) and not number ( s, 0, 59 ) ) ) )
+            return false;
+        seconds_ = ( negative ? -1 : 1 ) * ( h * 3'600 + m * 60 + s );
+        return true;
+    }
+
+    // Mm.w.d, Jn [ 1, 365 ] or n [ 0, 365 ], [ / time ].
+    [[nodiscard]] constexpr bool date ( zone_rule_t::date_t & date_ ) noexcept {
+        if ( skip ( 'M' ) ) {
+            if ( not number ( date_.month, 1, 12 ) or not skip ( '.' ) or not number ( date_.week, 1, 5 ) or not skip ( '.' ) or
+                 not number ( date_.day_of_week, 0, 6 ) )
+                return false;
+        }
+        else {
+            bool const julian = skip ( 'J' );
+            int n             = 0;
+            if ( not number ( n, julian, 365 ) )
+                return false;
+            date_.day = julian ? -n : n + 1;
+            // The weekday rule of the date in 2001, a common year starting on a Monday (1970-01-01 is a Thursday).
+            std::int64_t const d = days_from_civil ( 2001, 1, 1 ) + std::min ( n - julian, 364 );
+            civil_t const c      = civil_from_days ( d );
+            date_.month          = c.month;
+            date_.week           = ( c.day - 1 ) / 7 + 1;
+            date_.day_of_week    = static_cast<int> ( ( d + 4 ) % 7 );
+        }
+        date_.time = 7'200; // 02:00:00.
+        return not skip ( '/' ) or time ( date_.time );
+    }
+
+    private:
+    [[nodiscard]] constexpr bool number ( int & n_, int const min_, int const max_ ) noexcept {
+        std::size_t i = 0u;
+        n_            = 0;
+        while ( i < m_s.size ( ) and i < 3u and m_s[ i ] >= '0' and m_s[ i ] <= '9' )
+            n_ = 10 * n_ + ( m_s[ i++ ] - '0' );
+        m_s.remove_prefix ( i );
+        return i and n_ >= min_ and n_ <= max_;
+    }
+
+    std::string_view m_s;
+};
+
+struct tzif_header_t {
+    char version;
+    std::uint32_t isutcnt, isstdcnt, leapcnt, timecnt, typecnt, charcnt;
+};
+
+constexpr std::size_t tzif_header_size = 44u;
+
+[[nodiscard]] std::uint32_t be32 ( std::byte const * const p_ ) noexcept {
+    return static_cast<std::uint32_t> ( p_[ 0 ] ) << 24 | static_cast<std::uint32_t> ( p_[ 1 ] ) << 16 |
+           static_cast<std::uint32_t> ( p_[ 2 ] ) << 8 | static_cast<std::uint32_t> ( p_[ 3 ] );
+}
+
+[[nodiscard]] std::int64_t be64 ( std::byte const * const p_ ) noexcept {
+    return static_cast<std::int64_t> ( static_cast<std::uint64_t> ( be32 ( p_ ) ) << 32 | be32 ( p_ + 4 ) );
+}
+
+[[nodiscard]] std::optional<tzif_header_t> read_header ( std::span<std::byte const> const data_, std::size_t const offset_ ) noexcept {
+    if ( data_.size ( ) < offset_ + tzif_header_size )
+        return std::nullopt;
+    std::byte const * const p = data_.data ( ) + offset_;
+    if ( std::byte{ 'T' } != p[ 0 ] or std::byte{ 'Z' } != p[ 1 ] or std::byte{ 'i' } != p[ 2 ] or std::byte{ 'f' } != p[ 3 ] )
+        return std::nullopt;
+    return tzif_header_t{ static_cast<char> ( p[ 4 ] ), be32 ( p + 20 ), be32 ( p + 24 ), be32 ( p + 28 ),
+                          be32 ( p + 32 ),              be32 ( p + 36 ), be32 ( p + 40 ) };
+}
+
+// The size of the data block following a header, time_size_ is 4 (v1) or 8 (v2+).
+[[nodiscard]] constexpr std::size_t block_size ( tzif_header_t const & h_, std::size_t const time_size_ ) noexcept {
+    return std::size_t{ h_.timecnt } * time_size_ + h_.timecnt + std::size_t{ h_.typecnt } * 6u + h_.charcnt +
+           std::size_t{ h_.leapcnt } * ( time_size_ + 4u ) + h_.isstdcnt + h_.isutcnt;
+}
+
+std::once_flag g_zoneinfo_root_once;
+fs::path g_zoneinfo_root;
+
+} // namespace
+
+std::optional<posix_tz_t> parse_posix_tz ( std::string_view const tz_ ) noexcept {
+    posix_parser_t p{ tz_ };
+    posix_tz_t tz;
+    std::int32_t offset = 0; // POSIX offsets are west of Greenwich, the opposite of ours.
+    if ( not p.name ( tz.std_name ) or not p.time ( offset ) )
+        return std::nullopt;
+    tz.rule.std_offset = tz.rule.dst_offset = -offset;
+    if ( p.done ( ) )
+        return tz;
+    if ( not p.name ( tz.dst_name ) )
+        return std::nullopt;
+    tz.rule.dst_offset = tz.rule.std_offset + 3'600;
+    if ( not p.done ( ) and not p.next_is ( ',' ) ) {
+        if ( not p.time ( offset ) )
+            return std::nullopt;
+        tz.rule.dst_offset = -offset;
+    }
+    if ( p.done ( ) ) { // The default, the US rules.
+        tz.rule.dst_start = { 3, 2, 0, 7'200 };
+        tz.rule.dst_end   = { 11, 1, 0, 7'200 };
+        return tz;
+    }
+    if ( not p.skip ( ',' ) or not p.date ( tz.rule.dst_start ) or not p.skip ( ',' ) or not p.date ( tz.rule.dst_end ) or
+         not p.done ( ) )
+        return std::nullopt;
+    return tz;
+}
+
+std::optional<tzif_t> parse_tzif ( std::span<std::byte const> const data_ ) {
+    std::optional<tzif_header_t> h = read_header ( data_, 0u );
+    if ( not h )
+        return std::nullopt;
+    std::size_t offset = tzif_header_size, time_size = 4u;
+    if ( h->version >= '2' ) { // Skip the v1 data, use the 64-bit data.
+        offset += block_size ( *h, 4u );
+        h = read_header ( data_, offset );
+        if ( not h )
+            return std::nullopt;
+        offset += tzif_header_size;
+        time_size = 8u;
+    }
+    if ( not h->typecnt or data_.size ( ) < offset + block_size ( *h, time_size ) )
+        return std::nullopt;
+    std::byte const * const times = data_.data ( ) + offset;
+    std::byte const * const types = times + std::size_t{ h->timecnt } * time_size;
+    std::byte const * const infos = types + h->timecnt;
+    auto const utoff              = [ infos ] ( std::size_t const type_ ) noexcept {
+        return static_cast<std::int64_t> ( static_cast<std::int32_t> ( be32 ( infos + 6u * type_ ) ) );
+    };
+    // The offset of time type 0 applies before the first transition. Transitions that do not change the offset are
+    // dropped, zone_t keeps offsets only.
+    std::vector<std::int64_t> transitions, offsets{ utoff ( 0u ) * S_10M };
+    transitions.reserve ( h->timecnt );
+    offsets.reserve ( h->timecnt + 1u );
+    for ( std::size_t i = 0u; i < h->timecnt; ++i ) {
+        std::size_t const type = static_cast<std::size_t> ( types[ i ] );
+        if ( type >= h->typecnt )
+            return std::nullopt;
+        std::int64_t const t = 8u == time_size ? be64 ( times + 8u * i ) : static_cast<std::int32_t> ( be32 ( times + 4u * i ) );
+        std::int64_t const o = utoff ( type ) * S_10M;
+        if ( t < -WIN_TO_NIX_EPOCH_S ) { // Before 1601.
+            offsets.front ( ) = o;
+            continue;
+        }
+        if ( t >= 253'402'300'800LL ) // 10000-01-01.
+            break;
+        if ( o == offsets.back ( ) )
+            continue;
+        transitions.push_back ( ( t + WIN_TO_NIX_EPOCH_S ) * S_10M );
+        offsets.push_back ( o );
+    }
+    // The footer, a POSIX TZ string between new lines, for the instants beyond the table.
+    std::optional<posix_tz_t> footer;
+    if ( 8u == time_size ) {
+        std::string_view const rest{ reinterpret_cast<char const *> ( data_.data ( ) ) + offset + block_size ( *h, 8u ),
+                                     data_.size ( ) - offset - block_size ( *h, 8u ) };
+        if ( std::size_t const e = rest.find ( '\n', 1u ); rest.size ( ) and '\n' == rest.front ( ) and std::string_view::npos != e )
+            footer = parse_posix_tz ( rest.substr ( 1u, e - 1u ) );
+    }
+    zone_rule_t rule;
+    if ( footer )
+        rule = footer->rule;
+    else
+        rule.std_offset = rule.dst_offset = static_cast<std::int32_t> ( offsets.back ( ) / S_10M );
+    return tzif_t{ zone_t{ std::move ( transitions ), std::move ( offsets ), rule },
+                   footer ? std::string{ footer->std_name } : std::string{ },
+                   footer ? std::string{ footer->dst_name } : std::string{ } };
+}
+
+fs::path const & zoneinfo_root ( ) {
+    std::call_once ( g_zoneinfo_root_once, [ ] {
+        char const * const dir = std::getenv ( "TZDIR" );
+        g_zoneinfo_root        = dir and *dir ? fs::path{ dir } : fs::path{ "/usr/share/zoneinfo" };
+    } );
+    return g_zoneinfo_root;
+}
+
+bool set_zoneinfo_root ( fs::path root_ ) {
+    bool set = false;
+    std::call_once ( g_zoneinfo_root_once, [ &root_, &set ] {
+        g_zoneinfo_root = std::move ( root_ );
+        set             = true;
+    } );
+    return set;
+}
+
+std::optional<tzif_t> load_tzif ( std::string_view const iana_ ) {
+    fs::path const name{ iana_ };
+    if ( iana_.empty ( ) or name.is_absolute ( ) or name.has_root_name ( ) )
+        return std::nullopt;
+    for ( fs::path const & part : name )
+        if ( ".." == part )
+            return std::nullopt;
+    mapped_file_t const file ( zoneinfo_root ( ) / name );
+    return parse_tzif ( file.bytes ( ) );
+}
+
+#undef WIN_TO_NIX_EPOCH_S
+#undef S_10M
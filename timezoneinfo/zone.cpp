@@ -0,0 +1,315 @@
+
+// MIT License
+//
+// Copyright (c) 2019 degski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the \"Software\"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "timezoneinfo.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#define WIN_TO_NIX_EPOCH 116'444'736'000'000'000LL
+#define S_10M 10'000'000LL
+
+namespace {
+
+// Returns the ticks since 1601 at midnight (UTC) of the date.
+[[nodiscard]] constexpr std::int64_t date_ticks ( int const y_, int const m_, int const d_ ) noexcept {
+    return ( days_from_civil ( y_, m_, d_ ) + days_from_winepoch_to_nix ) * ticks_per_day;
+}
+
+[[nodiscard]] std::int64_t local_date_ticks ( zone_rule_t::date_t const & date_, int const y_ ) noexcept {
+    if ( date_.day ) { // The ( date_.day - 1 )-th day of the year, or the -date_.day-th not counting February 29.
+        int const n = date_.day > 0 ? date_.day - 1 : -date_.day - 1 + ( -date_.day >= 60 and is_leap_year ( y_ ) );
+        return date_ticks ( y_, 1, 1 ) + n * ticks_per_day + date_.time * S_10M;
+    }
+    return date_ticks ( y_, date_.month, weekday_day ( date_.week, y_, date_.month, date_.day_of_week ) ) +
+           date_.time * S_10M;
+}
+
+[[nodiscard]] constexpr int utc_year ( std::int64_t const utc_ ) noexcept {
+    return civil_from_days ( utc_ / ticks_per_day - days_from_winepoch_to_nix ).year;
+}
+
+} // namespace
+
+std::int64_t zone_rule_t::dst_start_utc ( int const y_ ) const noexcept {
+    return local_date_ticks ( dst_start, y_ ) - std_offset * S_10M;
+}
+
+std::int64_t zone_rule_t::dst_end_utc ( int const y_ ) const noexcept {
+    return local_date_ticks ( dst_end, y_ ) - dst_offset * S_10M;
+}
+
+std::int64_t zone_rule_t::offset ( std::int64_t const utc_ ) const noexcept {
+    if ( not has_dst ( ) )
+        return std_offset * S_10M;
+    int const y = utc_year ( utc_ );
+    std::int64_t const s = dst_start_utc ( y ), e = dst_end_utc ( y );
+    // Northern hemisphere: s < e, southern hemisphere: e < s, daylight time spans the new year.
+    bool const dst = s < e ? ( utc_ >= s and utc_ < e ) : ( utc_ >= s or utc_ < e );
+    return ( dst ? dst_offset : std_offset ) * S_10M;
+}
+
+period_t zone_rule_t::period ( std::int64_t const utc_ ) const noexcept {
+    int const y              = utc_year ( utc_ );
+    std::int64_t const first = date_ticks ( y, 1, 1 ), last = date_ticks ( y + 1, 1, 1 );
+    if ( not has_dst ( ) )
+        return { first, last, std_offset * S_10M };
+    std::int64_t const s = dst_start_utc ( y ), e = dst_end_utc ( y );
+    // The offset of the outer periods, respectively the one in between the transitions.
+    std::int64_t const outer = ( s < e ? std_offset : dst_offset ) * S_10M, inner = ( s < e ? dst_offset : std_offset ) * S_10M;
+    std::int64_t const a = std::min ( s, e ), b = std::max ( s, e );
+    if ( utc_ < a )
+        return { first, a, outer };
+    if ( utc_ < b )
+        return { a, b, inner };
+    return { b, last, outer };
+}
+
+zone_rule_t make_zone_rule ( tzi_t const & tzi_ ) noexcept {
+    // UTC = local time + bias, the time of day is rounded to whole seconds (23:59:59.999 is used for midnight).
+    auto const time = [] ( systime_t const & st_ ) noexcept {
+        return st_.wHour * 3'600 + st_.wMinute * 60 + st_.wSecond + ( st_.wMilliseconds + 500 ) / 1'000;
+    };
+    zone_rule_t rule;
+    rule.std_offset = -( tzi_.Bias + tzi_.StandardBias ) * 60;
+    rule.dst_offset = -( tzi_.Bias + tzi_.DaylightBias ) * 60;
+    if ( tzi_.DaylightDate.wMonth and tzi_.StandardDate.wMonth ) {
+        rule.dst_start = { tzi_.DaylightDate.wMonth, tzi_.DaylightDate.wDay, tzi_.DaylightDate.wDayOfWeek,
+                           time ( tzi_.DaylightDate ) };
+        rule.dst_end   = { tzi_.StandardDate.wMonth, tzi_.StandardDate.wDay, tzi_.StandardDate.wDayOfWeek,
+                         time ( tzi_.StandardDate ) };
+    }
+    else {
+        rule.dst_offset = rule.std_offset;
+    }
+    return rule;
+}
+
+tzi_t make_tzi ( zone_rule_t const & rule_ ) noexcept {
+    auto const date = [] ( zone_rule_t::date_t const & date_ ) noexcept {
+        int const time = std::clamp ( date_.time, 0, 86'399 );
+        systime_t st{ };
+        st.wMonth     = static_cast<std::uint16_t> ( date_.month );
+        st.wDayOfWeek = static_cast<std::uint16_t> ( date_.day_of_week );
+        st.wDay       = static_cast<std::uint16_t> ( date_.week );
+        st.wHour      = static_cast<std::uint16_t> ( time / 3'600 );
+        st.wMinute    = static_cast<std::uint16_t> ( time / 60 % 60 );
+        st.wSecond    = static_cast<std::uint16_t> ( time % 60 );
+        return st;
+    };
+    tzi_t tzi{ };
+    tzi.Bias = -rule_.std_offset / 60;
+    if ( rule_.has_dst ( ) ) {
+        tzi.DaylightBias = -( rule_.dst_offset - rule_.std_offset ) / 60;
+        tzi.DaylightDate = date ( rule_.dst_start );
+        tzi.StandardDate = date ( rule_.dst_end );
+    }
+    return tzi;
+}
+
+zone_t::zone_t ( tzi_t const & tzi_, int const first_year_, int const last_year_ ) :
+    zone_t{ make_zone_rule ( tzi_ ), first_year_, last_year_ } {}
+
+zone_t::zone_t ( zone_rule_t const & rule_, int const first_year_, int const last_year_ ) : m_rule{ rule_ } {
+    compile ( first_year_, last_year_ );
+}
+
+zone_t::zone_t ( dynamic_rules_t rules_, int const first_year_, int const last_year_ ) :
+    m_first_rule_year{ rules_.first_year }, m_rules{ std::move ( rules_.rules ) } {
+    assert ( m_rules.size ( ) );
+    m_rule = m_rules.back ( );
+    compile ( first_year_, last_year_ );
+}
+
+zone_t::zone_t ( std::vector<std::int64_t> transitions_, std::vector<std::int64_t> offsets_, zone_rule_t const & rule_,
+                 int const last_year_ ) :
+    m_rule{ rule_ },
+    m_begin{ date_ticks ( 1601, 1, 1 ) }, m_end{ date_ticks ( last_year_ + 1, 1, 1 ) }, m_transitions{ std::move ( transitions_ ) },
+    m_offsets{ std::move ( offsets_ ) } {
+    assert ( m_offsets.size ( ) == m_transitions.size ( ) + 1u );
+    assert ( std::is_sorted ( std::begin ( m_transitions ), std::end ( m_transitions ) ) );
+    if ( not m_rule.has_dst ( ) )
+        return;
+    std::int64_t const std_offset = m_rule.std_offset * S_10M, dst_offset = m_rule.dst_offset * S_10M;
+    std::int64_t last             = m_transitions.size ( ) ? m_transitions.back ( ) : m_begin;
+    auto const append             = [ this, &last ] ( std::int64_t const utc_, std::int64_t const offset_ ) {
+        if ( utc_ <= last )
+            return;
+        m_transitions.push_back ( last = utc_ );
+        m_offsets.push_back ( offset_ );
+    };
+    for ( int y = utc_year ( last ); y <= last_year_; ++y ) {
+        std::int64_t const s = m_rule.dst_start_utc ( y ), e = m_rule.dst_end_utc ( y );
+        if ( s < e ) {
+            append ( s, dst_offset );
+            append ( e, std_offset );
+        }
+        else {
+            append ( e, std_offset );
+            append ( s, dst_offset );
+        }
+    }
+}
+
+void zone_t::compile ( int const first_year_, int const last_year_ ) {
+    assert ( first_year_ <= last_year_ );
+    m_begin = date_ticks ( first_year_, 1, 1 );
+    m_end   = date_ticks ( last_year_ + 1, 1, 1 );
+    m_transitions.clear ( );
+    m_offsets.clear ( );
+    // The offset in effect at the start of year y_, daylight time spans the new year on the southern hemisphere.
+    auto const new_year_offset = [] ( zone_rule_t const & rule_, int const y_ ) noexcept {
+        bool const southern = rule_.has_dst ( ) and rule_.dst_start_utc ( y_ ) > rule_.dst_end_utc ( y_ );
+        return ( southern ? rule_.dst_offset : rule_.std_offset ) * S_10M;
+    };
+    m_offsets.push_back ( new_year_offset ( rule ( first_year_ ), first_year_ ) );
+    if ( m_rules.empty ( ) and not m_rule.has_dst ( ) )
+        return;
+    std::size_t const n = 2u * static_cast<std::size_t> ( last_year_ - first_year_ + 1 );
+    m_transitions.reserve ( n );
+    m_offsets.reserve ( n + 1u );
+    for ( int y = first_year_; y <= last_year_; ++y ) {
+        zone_rule_t const & r = rule ( y );
+        // A change of rule takes effect at local midnight of the new year.
+        if ( std::int64_t const o = new_year_offset ( r, y ); o != m_offsets.back ( ) ) {
+            m_transitions.push_back ( date_ticks ( y, 1, 1 ) - m_offsets.back ( ) );
+            m_offsets.push_back ( o );
+        }
+        if ( not r.has_dst ( ) )
+            continue;
+        std::int64_t const std_offset = r.std_offset * S_10M, dst_offset = r.dst_offset * S_10M;
+        std::int64_t const s = r.dst_start_utc ( y ), e = r.dst_end_utc ( y );
+        if ( s < e ) {
+            m_transitions.push_back ( s );
+            m_offsets.push_back ( dst_offset );
+            m_transitions.push_back ( e );
+            m_offsets.push_back ( std_offset );
+        }
+        else {
+            m_transitions.push_back ( e );
+            m_offsets.push_back ( std_offset );
+            m_transitions.push_back ( s );
+            m_offsets.push_back ( dst_offset );
+        }
+    }
+    assert ( std::is_sorted ( std::begin ( m_transitions ), std::end ( m_transitions ) ) );
+}
+
+std::int64_t zone_t::rule_offset ( std::int64_t const utc_ ) const noexcept { return rule ( utc_year ( utc_ ) ).offset ( utc_ ); }
+
+period_t zone_t::rule_period ( std::int64_t const utc_ ) const noexcept { return rule ( utc_year ( utc_ ) ).period ( utc_ ); }
+
+period_t zone_t::period ( std::int64_t const utc_ ) const noexcept {
+    if ( utc_ < m_begin or utc_ >= m_end )
+        return rule_period ( utc_ );
+    std::size_t const i = index ( utc_ );
+    return { i ? m_transitions[ i - 1u ] : m_begin, i < m_transitions.size ( ) ? m_transitions[ i ] : m_end, m_offsets[ i ] };
+}
+
+local_resolution_t zone_t::resolve_local ( std::int64_t const local_ ) const noexcept {
+    // Offsets are less than a day, a local time maps into a period within a day of the same UTC instant. The periods are
+    // scanned in order, however short they are, from the one before the period a day before local_ up to the one after
+    // the period a day after it. Those local_ does not map into lie, in local time, before or after it, and bound the
+    // local times that map uniquely. Of those not scanned, the ones before end a day after the first scanned begins at
+    // the latest, the ones after begin a day before the last scanned ends at the earliest.
+    auto const contains = [ local_ ] ( period_t const & p_ ) noexcept {
+        return p_.begin <= local_ - p_.offset and local_ - p_.offset < p_.end;
+    };
+    period_t p = period ( period ( local_ - ticks_per_day ).begin - 1 ), first{ }, last{ }, before{ };
+    std::int64_t begin = p.begin + ticks_per_day, end = std::numeric_limits<std::int64_t>::max ( );
+    int n              = 0;
+    for ( ;; p = period ( p.end ) ) {
+        if ( contains ( p ) ) {
+            if ( not n++ )
+                first = p;
+            last = p;
+        }
+        else if ( local_ - p.offset >= p.end ) {
+            begin  = std::max ( begin, p.end + p.offset );
+            before = p;
+        }
+        else {
+            end = std::min ( end, p.begin + p.offset );
+        }
+        if ( p.begin > local_ + ticks_per_day )
+            break;
+    }
+    end = std::min ( end, p.end - ticks_per_day );
+    if ( 1 == n ) {
+        std::int64_t const o = first.offset, utc = local_ - o;
+        return { utc, utc, std::max ( begin, first.begin + o ), std::min ( end, first.end + o ), o, local_kind_t::unique };
+    }
+    if ( n ) // In the overlap of two periods, the clock was set back.
+        return { local_ - first.offset, local_ - last.offset, 0, 0, 0, local_kind_t::ambiguous };
+    // In the gap between two periods, the clock was set forward. Beyond the end of the one before the gap with its
+    // offset, which puts it as far into the one after the gap as it is into the gap.
+    std::int64_t const utc = local_ - before.offset;
+    return { utc, utc, 0, 0, 0, local_kind_t::nonexistent };
+}
+
+nixtime_t zone_t::to_local ( nixtime_t const nixtime_ ) const noexcept {
+    return nixtime_ + static_cast<nixtime_t> ( offset ( static_cast<std::int64_t> ( nixtime_ ) * S_10M + WIN_TO_NIX_EPOCH ) / S_10M );
+}
+
+systime_t zone_t::to_local ( systime_t const & systime_ ) const noexcept {
+    return wintime_to_systime ( to_local ( systime_to_wintime ( systime_ ) ) );
+}
+
+zone_t const & get_zone_utc ( ) noexcept {
+    static zone_t const utc;
+    return utc;
+}
+
+std::optional<wintime_t> local_to_utc ( zone_t const & zone_, wintime_t const local_, local_policy_t const policy_ ) noexcept {
+    std::optional<std::int64_t> const utc =
+        policy_.apply ( zone_.resolve_local ( static_cast<std::int64_t> ( local_.as_uint64 ( ) ) ) );
+    if ( not utc )
+        return std::nullopt;
+    wintime_t wt;
+    wt.as_uint64 ( ) = static_cast<std::uint64_t> ( *utc );
+    return wt;
+}
+
+std::optional<nixtime_t> local_to_utc ( zone_t const & zone_, nixtime_t const local_, local_policy_t const policy_ ) noexcept {
+    std::optional<std::int64_t> const utc =
+        policy_.apply ( zone_.resolve_local ( static_cast<std::int64_t> ( local_ ) * S_10M + WIN_TO_NIX_EPOCH ) );
+    if ( not utc )
+        return std::nullopt;
+    return static_cast<nixtime_t> ( ( *utc - WIN_TO_NIX_EPOCH ) / S_10M );
+}
+
+std::optional<systime_t> local_to_utc ( zone_t const & zone_, systime_t const & local_, local_policy_t const policy_ ) noexcept {
+    std::optional<wintime_t> const utc = local_to_utc ( zone_, systime_to_wintime ( local_ ), policy_ );
+    if ( not utc )
+        return std::nullopt;
+    return wintime_to_systime ( *utc );
+}
+
+#undef WIN_TO_NIX_EPOCH
+#undef S_10M